@@ -29,6 +29,8 @@
 #include "app.h"
 #include "debug.h"
 #include "bsp/bsp.h"
+#include "bsp/periph/adc.h"
+#include "bsp/periph/timers.h"
 #include "sin_detect.h"
 
 /**********************************************************************************************************************
@@ -137,13 +139,55 @@ int main(void)
 static void app_thread(void *argument)
 {
     bool ret = false;
+#if TIMERS_32_0_PROFILE
+    timers_profile_t profile = {0};
+#endif // TIMERS_32_0_PROFILE
+#if ADC_JITTER
+    adc_jitter_t jitter = {0};
+#endif // ADC_JITTER
+#if ADC_ERRORS
+    adc_errors_t errors = {0};
+#endif // ADC_ERRORS
+#if ADC_HOUSEKEEPING
+    adc_hk_t hk = {0};
+#endif // ADC_HOUSEKEEPING
 
     debug_init();
 
     DEBUG_INIT(" * Initializing.");
 
-    ret = sin_detect_init();
+    ret = sin_detect_init(&sin_detect_main, &sin_detect_config_main);
     DEBUG_BOOT("%-15.15s %s.",      "Sin detect:", ret ? "ok" : "err");
+#if ADC_DMA
+    if(ret)
+    {
+        ret = adc_dma_start();
+        DEBUG_BOOT("%-15.15s %s.",  "ADC DMA:", ret ? "ok" : "err");
+    }
+#endif // ADC_DMA
+#if ADC_HOUSEKEEPING
+    if(ret)
+    {
+        ret = adc_hk_start();
+        DEBUG_BOOT("%-15.15s %s.",  "ADC HK:", ret ? "ok" : "err");
+    }
+#endif // ADC_HOUSEKEEPING
+#if ADC_CAPTURE
+    if(ret)
+    {
+        ret = adc_capture_start();
+        DEBUG_BOOT("%-15.15s %s.",  "ADC capture:", ret ? "ok" : "err");
+    }
+#endif // ADC_CAPTURE
+    if(ret)
+    {
+        // Zero crossings or sampling triggers are timestamped by free-running timer.
+        timers_32_1_start(SIN_DETECT_CLOCK);
+#if !ADC_THRESHOLD && !TIMERS_32_1_CAPTURE
+        // ADC converts several times per detection sample, DMA moves conversions, so interrupts stay per block.
+        timers_32_0_start(SIN_DETECT_RATE * ADC_OVERSAMPLE);
+#endif // !ADC_THRESHOLD && !TIMERS_32_1_CAPTURE
+    }
 
     DEBUG_INIT(" * Running.");
 
@@ -151,7 +195,33 @@ static void app_thread(void *argument)
     {
         osDelay(100);
         app_wdt_feed();
-        sin_detect_debug();
+        sin_detect_debug(&sin_detect_main);
+#if TIMERS_32_0_PROFILE
+        timers_32_0_get_profile(&profile);
+        DEBUG("Sampling ISR: %ld, max %ld cycles;", profile.cycles, profile.cycles_max);
+#endif // TIMERS_32_0_PROFILE
+#if ADC_JITTER
+        adc_get_jitter(&jitter);
+        DEBUG("Sampling jitter: %ld, min %ld, max %ld cycles;", jitter.count, jitter.count_min, jitter.count_max);
+#endif // ADC_JITTER
+#if ADC_DMA
+        DEBUG("ADC DMA: %ld blocks;", adc_dma_get_irq_count());
+#endif // ADC_DMA
+#if ADC_ADAPTIVE
+        DEBUG("ADC rate: %.0f Hz;", SIN_DETECT_RATE / adc_get_divider());
+#endif // ADC_ADAPTIVE
+#if ADC_ERRORS
+        adc_get_errors(&errors);
+        DEBUG("ADC errors: overrun %ld, invalid %ld, late %ld;", errors.overrun, errors.invalid, errors.late);
+#endif // ADC_ERRORS
+#if ADC_HOUSEKEEPING
+        adc_hk_get(&hk);
+        DEBUG("ADC HK: supply %.0f mV, %ld done, %ld lost, end max %ld of %ld cycles;",
+              ADC_CONVERT_MV(hk.value[ADC_HK_ID_SUPPLY]), hk.count, hk.lost, hk.phase_max, hk.period);
+#endif // ADC_HOUSEKEEPING
+#if ADC_CAPTURE
+        DEBUG("ADC capture: %ld blocks lost;", adc_capture_get_lost());
+#endif // ADC_CAPTURE
     }
 }
 
@@ -76,6 +76,7 @@ void bsp_init(void)
     gpio_init();
     uart_0_init();
     timers_32_0_init();
+    timers_32_1_init();
 
     bsp_read_rst_status();
 
@@ -92,6 +93,22 @@ uint32_t bsp_get_core_clock(void)
     return SystemCoreClock;
 }
 
+void bsp_get_board_id(uint32_t id[4])
+{
+    // ROM writes status and 4 words of ID, Chip_FLASH_ReadUID returns first word only.
+    uint32_t command[5] = {IAP_READ_UID_CMD, 0, 0, 0, 0};
+    uint32_t result[5] = {0};
+    uint32_t i = 0;
+
+    iap_entry(command, result);
+    for(i = 0; i < 4; i++)
+    {
+        id[i] = (result[0] == IAP_CMD_SUCCESS) ? result[i + 1] : 0;
+    }
+
+    return;
+}
+
 /**********************************************************************************************************************
  * Private functions
  *********************************************************************************************************************/
@@ -71,6 +71,13 @@ uint32_t bsp_get_reset_cause(void);
  */
 uint32_t bsp_get_core_clock(void);
 
+/**
+ * @brief   Get board ID, MCU unique ID read by IAP.
+ *
+ * @param   id  Pointer to 4 words of ID, all 0 if IAP fails.
+ */
+void bsp_get_board_id(uint32_t id[4]);
+
 #ifdef __cplusplus
 }
 #endif
@@ -21,40 +21,187 @@
  * Includes
  *********************************************************************************************************************/
 #include <stdint.h>
+#include <string.h>
 
 #include "bsp/periph/adc.h"
+#include "bsp/periph/adc_timing.h"
 
+#include "bsp/bsp.h"
+#include "bsp/periph/timers.h"
+#include "bsp/periph/uart.h"
+
+#include "app.h"
+#include "capture.h"
+#include "debug.h"
 #include "sin_detect.h"
 #include "chip.h"
+#include "cmsis_os2.h"
 
 /**********************************************************************************************************************
  * Private definitions and macros
  *********************************************************************************************************************/
-#define ADC_AVG_COUNT   8   //!< ADC average count.
+#define ADC_DMA_CH      DMA_CH14    //!< DMA channel, it has no peripheral request and is triggered by sequencer A.
+#define ADC_FLAG_BLOCK  0x0001      //!< Thread flag: DMA buffer is complete.
+#define ADC_FLAG_HK     0x0002      //!< Thread flag: housekeeping sequence is complete.
+/** Capture records of one block: samples of all channels and output of each. */
+#define ADC_CAPTURE_SIZE    (CAPTURE_SAMPLES_SIZE(ADC_DMA_BLOCK * ADC_ID_LAST) + (ADC_ID_LAST * CAPTURE_OUTPUT_SIZE))
+
+#if ADC_CAPTURE && (UART_0_BAUDRATE < 230400)
+#error "ADC_CAPTURE: one channel at full rate streams ~110 kbit/s, raise UART_0_BAUDRATE to 230400 or more!"
+#endif
 
 /**********************************************************************************************************************
  * Private typedef
  *********************************************************************************************************************/
+/**
+ * @brief   ADC channel configuration.
+ */
+typedef struct
+{
+    uint8_t ch;                 //!< ADC channel.
+    uint8_t port;               //!< Pin port.
+    uint8_t pin;                //!< Pin number.
+    uint32_t func;              //!< Pin ADC function, see IOCON_FUNCx.
+    sin_detect_t *detect;       //!< Detector of channel signal, NULL for housekeeping channels.
+} adc_ch_config_t;
+
+/**
+ * @brief   Sequencer A data, structure of arrays, so one pass over channels updates them from adjacent words.
+ */
 typedef struct
 {
-    uint8_t ch;
-    uint32_t value;
-    uint32_t acumulator;
-    uint8_t counter;
-} adc_ch_data_t;
+    uint32_t value[ADC_ID_LAST];        //!< Last decimated value.
+    uint32_t acumulator[ADC_ID_LAST];   //!< Valid conversions sum.
+    uint32_t valid[ADC_ID_LAST];        //!< Valid conversions count.
+    uint32_t counter;                   //!< Conversions count, all channels are converted together.
+} adc_seqa_data_t;
+
+#if ADC_CAPTURE
+/**
+ * @brief   Captured block, copied by DMA thread to capture thread queue.
+ */
+typedef struct
+{
+    capture_block_t block;                          //!< Block of samples. See @ref capture_block_t.
+    uint16_t samples[ADC_ID_LAST][ADC_DMA_BLOCK];   //!< Samples of channels.
+    capture_output_t output[ADC_ID_LAST];           //!< Detector outputs after block. See @ref capture_output_t.
+} adc_capture_t;
+#endif // ADC_CAPTURE
 
 /**********************************************************************************************************************
  * Private constants
  *********************************************************************************************************************/
+#if ADC_DMA
+/** ADC DMA thread attributes. */
+const osThreadAttr_t adc_dma_thread_attr =
+{
+    .name = "ADC",
+    .stack_size = 512,
+    .priority = osPriorityHigh,
+};
+#endif // ADC_DMA
+
+#if ADC_HOUSEKEEPING
+/** ADC housekeeping thread attributes. */
+const osThreadAttr_t adc_hk_thread_attr =
+{
+    .name = "ADC HK",
+    .stack_size = 512,
+    .priority = osPriorityBelowNormal,
+};
+#endif // ADC_HOUSEKEEPING
+
+#if ADC_CAPTURE
+/** ADC capture thread attributes. */
+const osThreadAttr_t adc_capture_thread_attr =
+{
+    .name = "ADC CAP",
+    .stack_size = 512,
+    .priority = osPriorityBelowNormal,
+};
+#endif // ADC_CAPTURE
 
 /**********************************************************************************************************************
  * Private variables
  *********************************************************************************************************************/
-volatile adc_ch_data_t adc_seqa_ch_data[ADC_ID_LAST] =
+/** Sequencer A channels configuration. */
+static const adc_ch_config_t adc_seqa_ch_config[ADC_ID_LAST] =
 {
-    {.ch = 0, .value = 0, .acumulator = 0, .counter = 0},   // ADC_CH_INA282_1
+    {.ch = 0, .port = 1, .pin = 9, .func = IOCON_FUNC3, .detect = &sin_detect_main},    // ADC_ID_SINUS_DETECT
 };
 
+#if ADC_HOUSEKEEPING
+/** Sequencer B housekeeping channels configuration. */
+static const adc_ch_config_t adc_seqb_ch_config[ADC_HK_ID_LAST] =
+{
+    {.ch = 1, .port = 0, .pin = 23, .func = IOCON_FUNC1, .detect = NULL},               // ADC_HK_ID_SUPPLY
+};
+#endif // ADC_HOUSEKEEPING
+
+/** Sequencer A data. */
+static volatile adc_seqa_data_t adc_seqa_data = {0};
+
+#if ADC_ADAPTIVE
+/** Sample rate divider applied to sampling timer. */
+static volatile uint32_t adc_divider = 1;
+#endif // ADC_ADAPTIVE
+
+#if ADC_ERRORS
+/** Sample stream errors. */
+static volatile adc_errors_t adc_errors = {0};
+#endif // ADC_ERRORS
+
+/** Sampling interrupt jitter. */
+static volatile adc_jitter_t adc_jitter = {.count = 0, .count_min = UINT32_MAX, .count_max = 0};
+
+#if ADC_DMA
+/** DMA ping-pong buffers, raw sequencer A global data register values. */
+static uint32_t adc_dma_buffer[2][ADC_DMA_BLOCK * ADC_OVERSAMPLE * ADC_ID_LAST];
+/** DMA reload descriptors of ping-pong buffers, must be 16 byte aligned. */
+static DMA_CHDESC_T adc_dma_desc[2] __attribute__ ((aligned(16)));
+/** Index of buffer DMA is writing to. */
+static volatile uint32_t adc_dma_active = 0;
+/** Index of last complete buffer. */
+static volatile uint32_t adc_dma_ready = 0;
+/** First conversion trigger time of ping-pong buffers, 32-bit timer 1 count. */
+static volatile uint32_t adc_dma_time[2] = {0};
+/** Conversion period of ping-pong buffers, in core clock cycles. */
+static volatile uint32_t adc_dma_period[2] = {0};
+/** Block timing, used only in DMA interrupt. */
+static adc_timing_block_t adc_dma_timing = {0};
+/** DMA buffer complete interrupts count. */
+static volatile uint32_t adc_dma_irq_count = 0;
+/** Flag that shows if last complete buffer is not processed yet. */
+static volatile bool adc_dma_pending = false;
+/** ADC DMA thread id. */
+static osThreadId_t adc_dma_thread_id = NULL;
+#endif // ADC_DMA
+
+#if ADC_HOUSEKEEPING
+/** Housekeeping data. */
+static volatile adc_hk_t adc_hk = {0};
+/** Flag that shows if housekeeping thread waits for sequence B. */
+static volatile bool adc_hk_request = false;
+/** ADC housekeeping thread id. */
+static osThreadId_t adc_hk_thread_id = NULL;
+#endif // ADC_HOUSEKEEPING
+
+#if ADC_CAPTURE
+/** Captured blocks queue id. */
+static osMessageQueueId_t adc_capture_queue_id = NULL;
+/** ADC capture thread id. */
+static osThreadId_t adc_capture_thread_id = NULL;
+/** Samples per channel captured since start, sequence of next block. */
+static uint32_t adc_capture_sequence = 0;
+/** Blocks lost by capture, counted from sequence gaps. */
+static volatile uint32_t adc_capture_lost = 0;
+#endif // ADC_CAPTURE
+
+#if ADC_THRESHOLD
+/** Flag that shows if signal is above threshold comparator zero level. */
+static volatile bool adc_threshold_high = false;
+#endif // ADC_THRESHOLD
+
 /**********************************************************************************************************************
  * Exported variables
  *********************************************************************************************************************/
@@ -62,12 +209,111 @@ volatile adc_ch_data_t adc_seqa_ch_data[ADC_ID_LAST] =
 /**********************************************************************************************************************
  * Prototypes of local functions
  *********************************************************************************************************************/
+#if ADC_JITTER
+/**
+ * @brief   Record CT32B0 count at sampling interrupt entry.
+ */
+static void adc_jitter_update(void);
+#endif // ADC_JITTER
+
+/**
+ * @brief   Accumulate conversions of all channels, decimate by @ref ADC_OVERSAMPLE and pass to detectors.
+ *
+ * @note    Trigger of last conversion is latched by free-running timer, sample is timestamped in the middle of its
+ *          conversions, so detectors measure real sample intervals. Invalid and overrun results are skipped.
+ */
+static void adc_decimate(void);
+
+#if ADC_ADAPTIVE
+/**
+ * @brief   Change sample rate to one requested by detectors.
+ *
+ * @note    Must be called right after sample, rate of channel with highest frequency is used.
+ *
+ * @return  State of rate change.
+ * @retval  0   rate is not changed.
+ * @retval  1   rate is changed, it applies to next conversion period.
+ */
+static bool adc_adapt(void);
+#endif // ADC_ADAPTIVE
+
+#if ADC_THRESHOLD
+/**
+ * @brief   Set threshold comparator to catch next zero crossing.
+ *
+ * @note    Comparator detects crossing of low threshold only, it is moved to zero level plus or minus hysteresis,
+ *          on the opposite side from the signal, so comparator works as Schmitt trigger.
+ *
+ * @param   high    Flag that shows if signal is above zero level.
+ */
+static void adc_threshold_set(bool high);
+#endif // ADC_THRESHOLD
+
+#if ADC_HOUSEKEEPING
+/**
+ * @brief   Get phase of sequencer A period, see @ref adc_timing_phase.
+ *
+ * @return  Core clock cycles since last sequencer A trigger.
+ */
+static uint32_t adc_hk_phase(void);
+
+/**
+ * @brief   Start requested housekeeping sequence.
+ *
+ * @note    Called from sequencer A path right after its sequence is converted, so sequence B runs in free time
+ *          before next sequencer A trigger. Late call, when sequence B would not end before next trigger, leaves
+ *          request for next sequence A.
+ */
+static void adc_hk_trigger(void);
+
+/**
+ * @brief   ADC housekeeping thread, periodically converts sequencer B channels.
+ *
+ * @param   argument    Pointer to  thread arguments.
+ */
+static void adc_hk_thread(void *argument);
+#endif // ADC_HOUSEKEEPING
+
+#if ADC_CAPTURE
+/**
+ * @brief   Queue block and detector outputs after it for capture thread, block is lost if queue is full.
+ *
+ * @param   samples Samples of channels.
+ * @param   time    First sample timestamp, in core clock cycles.
+ * @param   period  Time between samples, in core clock cycles.
+ */
+static void adc_capture_put(uint16_t samples[ADC_ID_LAST][ADC_DMA_BLOCK], uint32_t time, uint32_t period);
+
+/**
+ * @brief   ADC capture thread, writes records of queued blocks to debug UART.
+ *
+ * @param   argument    Not used.
+ */
+static void adc_capture_thread(void *argument);
+#endif // ADC_CAPTURE
+
+#if ADC_DMA
+/**
+ * @brief   Setup DMA channel to move sequencer A results to ping-pong buffers.
+ */
+static void adc_dma_init(void);
+
+/**
+ * @brief   ADC DMA thread, runs detection over complete buffers.
+ *
+ * @param   argument    Pointer to  thread arguments.
+ */
+static void adc_dma_thread(void *argument);
+#endif // ADC_DMA
 
 /**********************************************************************************************************************
  * Exported functions
  *********************************************************************************************************************/
 void adc_init(void)
 {
+    uint32_t chansel = 0;
+    uint32_t i = 0;
+
     /* Setup ADC for 12-bit mode and normal power */
     Chip_ADC_Init(LPC_ADC, 0);
 
@@ -82,67 +328,757 @@ void adc_init(void)
     /* Setup ADC clock rate */
     Chip_ADC_SetClockRate(LPC_ADC, ADC_CLK);
 
+    /* Setup channel pins, sequencer A scans all of them. */
+    for(i = 0; i < ADC_ID_LAST; i++)
+    {
+        Chip_IOCON_PinMuxSet(LPC_IOCON, adc_seqa_ch_config[i].port, adc_seqa_ch_config[i].pin,
+                             (adc_seqa_ch_config[i].func | IOCON_MODE_INACT | IOCON_ADMODE_EN));
+        chansel |= ADC_SEQ_CTRL_CHANSEL(adc_seqa_ch_config[i].ch);
+    }
+
     /* Setup sequencer A. */
     Chip_ADC_SetupSequencer(LPC_ADC, ADC_SEQA_IDX,
                             (
-                             ADC_SEQ_CTRL_CHANSEL(adc_seqa_ch_data[ADC_ID_SINUS_DETECT].ch) |
-                             ADC_SEQ_CTRL_LOWPRIO |
+                             chansel |
+#if ADC_HW_TRIGGER
+                             // Conversion is started exactly on CT32B0 MAT0 rising edge.
+                             ADC_SEQ_CTRL_HWTRIG_CT32B0_MAT0 |
+                             ADC_SEQ_CTRL_HWTRIG_POLPOS |
+#endif // ADC_HW_TRIGGER
+                             // LOWPRIO bit is not set, sequencer B triggers can not interrupt sequencer A.
+#if ADC_DMA
+                             // End of conversion mode, DMA read of data register clears request.
+                             0
+#else
                              ADC_SEQ_CTRL_MODE_EOS
+#endif // ADC_DMA
                              ));
 
-    // ADC_ID_SINUS_DETECT
-    Chip_IOCON_PinMuxSet(LPC_IOCON, 1, 9, (IOCON_FUNC3 | IOCON_MODE_INACT | IOCON_ADMODE_EN));
+#if ADC_HOUSEKEEPING
+    /* Setup housekeeping channel pins and sequencer B, it is started by software. */
+    chansel = 0;
+    for(i = 0; i < ADC_HK_ID_LAST; i++)
+    {
+        Chip_IOCON_PinMuxSet(LPC_IOCON, adc_seqb_ch_config[i].port, adc_seqb_ch_config[i].pin,
+                             (adc_seqb_ch_config[i].func | IOCON_MODE_INACT | IOCON_ADMODE_EN));
+        chansel |= ADC_SEQ_CTRL_CHANSEL(adc_seqb_ch_config[i].ch);
+    }
+    Chip_ADC_SetupSequencer(LPC_ADC, ADC_SEQB_IDX, (chansel | ADC_SEQ_CTRL_MODE_EOS));
+#endif // ADC_HOUSEKEEPING
 
-    /* Power up the internal temperature sensor - this also selects the temperature sensor as the input for the ADC0 input */
+    /* Keep the internal temperature sensor powered down, when powered it replaces ADC0 input used by detection. */
     Chip_SYSCTL_PowerDown(SYSCTL_POWERDOWN_TS_PD);
 
+#if ADC_THRESHOLD
+    /* Threshold 0 low value is moved around zero level, high value is not used */
+    adc_threshold_set(false);
+    Chip_ADC_SetThrHighValue(LPC_ADC, 0, 0xFFF);
+#else
     /* Setup threshold 0 low and high values to about 25% and 75% of max */
     Chip_ADC_SetThrLowValue(LPC_ADC, 0, ((1 * 0xFFF) / 4));
     Chip_ADC_SetThrHighValue(LPC_ADC, 0, ((3 * 0xFFF) / 4));
+#endif // ADC_THRESHOLD
     
     /* Clear all pending interrupts */
     Chip_ADC_ClearFlags(LPC_ADC, Chip_ADC_GetFlags(LPC_ADC));
-    /* Enable ADC overrun and sequence A completion interrupts */
+#if ADC_THRESHOLD
+    /* Enable only threshold crossing interrupt, conversions run without CPU */
+    Chip_ADC_EnableInt(LPC_ADC, ADC_INTEN_CMP_ENABLE(ADC_INTEN_CMP_CROSSTH, adc_seqa_ch_config[ADC_ID_SINUS_DETECT].ch));
+    NVIC_ClearPendingIRQ(ADC_A_IRQn);
+    NVIC_EnableIRQ(ADC_A_IRQn);
+#else
+    /* Enable sequence A completion interrupt, overruns are counted from result flags */
     Chip_ADC_EnableInt(LPC_ADC, (ADC_INTEN_SEQA_ENABLE));
+#endif // ADC_THRESHOLD
+#if ADC_DMA
+    /* Sequencer A interrupt is DMA trigger only. */
+    adc_dma_init();
+#elif ADC_HW_TRIGGER
     /* Enable ADC NVIC interrupt */
-    //NVIC_EnableIRQ(ADC_A_IRQn);
+    NVIC_ClearPendingIRQ(ADC_A_IRQn);
+    NVIC_EnableIRQ(ADC_A_IRQn);
+#endif // ADC_DMA
+
+#if ADC_HOUSEKEEPING
+    /* Enable sequence B completion interrupt */
+    Chip_ADC_EnableInt(LPC_ADC, ADC_INTEN_SEQB_ENABLE);
+    NVIC_ClearPendingIRQ(ADC_B_IRQn);
+    NVIC_EnableIRQ(ADC_B_IRQn);
+    Chip_ADC_EnableSequencer(LPC_ADC, ADC_SEQB_IDX);
+#endif // ADC_HOUSEKEEPING
 
     /* Enable sequencer */
     Chip_ADC_EnableSequencer(LPC_ADC, ADC_SEQA_IDX);
 
+#if !ADC_HW_TRIGGER
     /* Start Burst sequencer. */
     Chip_ADC_StartBurstSequencer(LPC_ADC, ADC_SEQA_IDX);
+#endif // ADC_HW_TRIGGER
 
     return;
 }
 
 void adc_handler(void)
+{
+#if ADC_JITTER
+    adc_jitter_update();
+#endif // ADC_JITTER
+
+    // Burst sequencer converts much faster than timer rate, so every read is new conversion.
+    adc_decimate();
+    
+    return;
+}
+
+void adc_tick_handler(uint32_t time)
+{
+#if ADC_THRESHOLD
+    sin_detect_process_timeout(&sin_detect_main, time);
+    if(sin_detect_main.data.lost)
+    {
+        // Signal is lost, comparator may wait on wrong side, arm it from current signal level.
+        adc_threshold_set(ADC_DR_RESULT(Chip_ADC_GetDataReg(LPC_ADC, adc_seqa_ch_config[ADC_ID_SINUS_DETECT].ch))
+                          >= ADC_THRESHOLD_ZERO);
+    }
+#endif // ADC_THRESHOLD
+
+    return;
+}
+
+bool adc_dma_start(void)
+{
+#if ADC_DMA
+    if((adc_dma_thread_id = osThreadNew(adc_dma_thread, NULL, &adc_dma_thread_attr)) == NULL)
+    {
+        return false;
+    }
+#endif // ADC_DMA
+
+    return true;
+}
+
+bool adc_hk_start(void)
+{
+#if ADC_HOUSEKEEPING
+    if((adc_hk_thread_id = osThreadNew(adc_hk_thread, NULL, &adc_hk_thread_attr)) == NULL)
+    {
+        return false;
+    }
+#endif // ADC_HOUSEKEEPING
+
+    return true;
+}
+
+bool adc_capture_start(void)
+{
+#if ADC_CAPTURE
+    // Block must fit UART ring buffer whole, it is never sent in parts.
+    if(ADC_CAPTURE_SIZE > UART_0_TX_DATA_SIZE)
+    {
+        return false;
+    }
+    if((adc_capture_queue_id = osMessageQueueNew(ADC_CAPTURE_QUEUE, sizeof(adc_capture_t), NULL)) == NULL)
+    {
+        return false;
+    }
+    if((adc_capture_thread_id = osThreadNew(adc_capture_thread, NULL, &adc_capture_thread_attr)) == NULL)
+    {
+        return false;
+    }
+#endif // ADC_CAPTURE
+
+    return true;
+}
+
+uint32_t adc_capture_get_lost(void)
+{
+#if ADC_CAPTURE
+    return adc_capture_lost;
+#else
+    return 0;
+#endif // ADC_CAPTURE
+}
+
+void adc_hk_get(adc_hk_t *hk)
+{
+#if ADC_HOUSEKEEPING
+    uint32_t i = 0;
+
+    for(i = 0; i < ADC_HK_ID_LAST; i++)
+    {
+        hk->value[i] = adc_hk.value[i];
+    }
+    hk->count = adc_hk.count;
+    hk->lost = adc_hk.lost;
+    hk->period = adc_hk.period;
+    hk->phase_max = adc_hk.phase_max;
+#endif // ADC_HOUSEKEEPING
+
+    return;
+}
+
+uint32_t adc_dma_get_irq_count(void)
+{
+#if ADC_DMA
+    return adc_dma_irq_count;
+#else
+    return 0;
+#endif // ADC_DMA
+}
+
+uint32_t adc_get_divider(void)
+{
+#if ADC_ADAPTIVE
+    return adc_divider;
+#else
+    return 1;
+#endif // ADC_ADAPTIVE
+}
+
+void adc_get_errors(adc_errors_t *errors)
+{
+#if ADC_ERRORS
+    errors->overrun = adc_errors.overrun;
+    errors->invalid = adc_errors.invalid;
+    errors->late = adc_errors.late;
+#if !ADC_HW_TRIGGER
+    errors->late += timers_32_0_get_late();
+#endif // ADC_HW_TRIGGER
+#endif // ADC_ERRORS
+
+    return;
+}
+
+void adc_get_jitter(adc_jitter_t *jitter)
+{
+    jitter->count = adc_jitter.count;
+    jitter->count_min = adc_jitter.count_min;
+    jitter->count_max = adc_jitter.count_max;
+
+    return;
+}
+
+/**********************************************************************************************************************
+ * Private functions
+ *********************************************************************************************************************/
+static void adc_decimate(void)
 {
     uint32_t raw = 0;
-    uint8_t i = 0;
+    uint32_t period = 0;
+    uint32_t since = 0;
+    uint32_t time = 0;
+    uint32_t i = 0;
 
-    for(i = 0; i < ADC_AVG_COUNT; i++)
+    for(i = 0; i < ADC_ID_LAST; i++)
+    {
+        raw = Chip_ADC_GetDataReg(LPC_ADC, adc_seqa_ch_config[i].ch);
+        // Result bits hold previous conversion if not valid, overrun result is not of its trigger, both are skipped.
+        if(!(raw & ADC_DR_DATAVALID))
+        {
+#if ADC_ERRORS
+            adc_errors.invalid++;
+#endif // ADC_ERRORS
+            continue;
+        }
+#if ADC_HW_TRIGGER
+        if(raw & ADC_DR_OVERRUN)
+        {
+#if ADC_ERRORS
+            adc_errors.overrun++;
+#endif // ADC_ERRORS
+            continue;
+        }
+#endif // ADC_HW_TRIGGER
+        adc_seqa_data.acumulator[i] += ADC_DR_RESULT(raw);
+        adc_seqa_data.valid[i]++;
+    }
+    if(++adc_seqa_data.counter < ADC_OVERSAMPLE)
     {
-        raw = Chip_ADC_GetDataReg(LPC_ADC, adc_seqa_ch_data[ADC_ID_SINUS_DETECT].ch);
-        if(ADC_DR_DATAVALID & raw)
+        return;
+    }
+    adc_seqa_data.counter = 0;
+    // Rate is changed only between samples, so averaged conversions are evenly spaced.
+    period = timers_32_0_get_period();
+    time = timers_32_0_get_trigger(&since);
+#if ADC_HW_TRIGGER
+    // Sequence of last trigger can not be converted yet, results are of one before, interrupt is late.
+    if(since < ADC_TIMING_SEQA_CYCLES)
+    {
+        time -= period;
+    }
+#endif // ADC_HW_TRIGGER
+    time -= ((ADC_OVERSAMPLE - 1) * period) / 2;
+    for(i = 0; i < ADC_ID_LAST; i++)
+    {
+        // Boxcar average of valid conversions, rounded, previous value is kept if there is none.
+        if(adc_seqa_data.valid[i] == ADC_OVERSAMPLE)
         {
-            adc_seqa_ch_data[ADC_ID_SINUS_DETECT].counter++;
-            adc_seqa_ch_data[ADC_ID_SINUS_DETECT].acumulator += ADC_DR_RESULT(raw);
+            adc_seqa_data.value[i] = (adc_seqa_data.acumulator[i] + (ADC_OVERSAMPLE / 2)) / ADC_OVERSAMPLE;
         }
-        if(i == (ADC_AVG_COUNT - 1))
+        else if(adc_seqa_data.valid[i])
         {
-            adc_seqa_ch_data[ADC_ID_SINUS_DETECT].value =
-                    adc_seqa_ch_data[ADC_ID_SINUS_DETECT].acumulator / adc_seqa_ch_data[ADC_ID_SINUS_DETECT].counter;
-            adc_seqa_ch_data[ADC_ID_SINUS_DETECT].acumulator = 0;
-            adc_seqa_ch_data[ADC_ID_SINUS_DETECT].counter = 0;
+            adc_seqa_data.value[i] = (adc_seqa_data.acumulator[i] + (adc_seqa_data.valid[i] / 2))
+                                     / adc_seqa_data.valid[i];
         }
+        adc_seqa_data.acumulator[i] = 0;
+        adc_seqa_data.valid[i] = 0;
+        sin_detect_process_timed(adc_seqa_ch_config[i].detect, adc_seqa_data.value[i], time);
     }
+#if ADC_ADAPTIVE
+    adc_adapt();
+#endif // ADC_ADAPTIVE
 
-    sin_detect_process(adc_seqa_ch_data[ADC_ID_SINUS_DETECT].value);
-    
     return;
 }
 
-/**********************************************************************************************************************
- * Private functions
- *********************************************************************************************************************/
+#if ADC_ADAPTIVE
+static bool adc_adapt(void)
+{
+    uint32_t divider = UINT32_MAX;
+    uint32_t target = 0;
+    uint32_t i = 0;
+
+    for(i = 0; i < ADC_ID_LAST; i++)
+    {
+        target = sin_detect_get_divider(adc_seqa_ch_config[i].detect);
+        if(target < divider)
+        {
+            divider = target;
+        }
+    }
+    if(divider == adc_divider || !timers_32_0_set_divider(divider))
+    {
+        return false;
+    }
+    adc_divider = divider;
+
+    return true;
+}
+#endif // ADC_ADAPTIVE
+
+#if ADC_THRESHOLD
+static void adc_threshold_set(bool high)
+{
+    adc_threshold_high = high;
+    Chip_ADC_SetThrLowValue(LPC_ADC, 0, high ? (ADC_THRESHOLD_ZERO - ADC_THRESHOLD_HYS)
+                                             : (ADC_THRESHOLD_ZERO + ADC_THRESHOLD_HYS));
+
+    return;
+}
+#endif // ADC_THRESHOLD
+
+#if ADC_JITTER
+static void adc_jitter_update(void)
+{
+    // Timer is reset on match and runs at core clock, so its count is cycles spent since match.
+    adc_jitter.count = Chip_TIMER_ReadCount(LPC_TIMER32_0);
+    if(adc_jitter.count < adc_jitter.count_min)
+    {
+        adc_jitter.count_min = adc_jitter.count;
+    }
+    if(adc_jitter.count > adc_jitter.count_max)
+    {
+        adc_jitter.count_max = adc_jitter.count;
+    }
+
+    return;
+}
+#endif // ADC_JITTER
+
+#if ADC_HOUSEKEEPING
+static uint32_t adc_hk_phase(void)
+{
+    // EMR bit 0 is MAT0 level.
+    return adc_timing_phase(Chip_TIMER_ReadCount(LPC_TIMER32_0), (LPC_TIMER32_0->EMR & (1 << 0)) != 0,
+                            LPC_TIMER32_0->MR[0]);
+}
+
+static void adc_hk_trigger(void)
+{
+    if(adc_hk_request && adc_timing_seqb_fits(adc_hk_phase(), timers_32_0_get_period()))
+    {
+        adc_hk_request = false;
+        Chip_ADC_StartSequencer(LPC_ADC, ADC_SEQB_IDX);
+    }
+
+    return;
+}
+
+static void adc_hk_thread(void *argument)
+{
+    uint32_t i = 0;
+
+    while(1)
+    {
+        osDelay(ADC_HOUSEKEEPING_PERIOD);
+        osThreadFlagsClear(ADC_FLAG_HK);
+        adc_hk_request = true;
+        if(osThreadFlagsWait(ADC_FLAG_HK, osFlagsWaitAny, ADC_HK_TIMEOUT) & osFlagsError)
+        {
+            // Sequencer A is not running, nothing to fit sequence B after.
+            adc_hk_request = false;
+            adc_hk.lost++;
+            continue;
+        }
+        for(i = 0; i < ADC_HK_ID_LAST; i++)
+        {
+            adc_hk.value[i] = ADC_DR_RESULT(Chip_ADC_GetDataReg(LPC_ADC, adc_seqb_ch_config[i].ch));
+        }
+        adc_hk.count++;
+    }
+}
+
+/**
+ * @brief   ADC sequence B interrupt handler, housekeeping sequence is complete.
+ */
+void ADC_B_IRQHandler(void)
+{
+    uint32_t phase = 0;
+
+    // Phase first, it proves sequence B was done before next sequencer A trigger.
+    phase = adc_hk_phase();
+
+    if(Chip_ADC_GetFlags(LPC_ADC) & ADC_FLAGS_SEQB_INT_MASK)
+    {
+        Chip_ADC_ClearFlags(LPC_ADC, ADC_FLAGS_SEQB_INT_MASK);
+        if(phase > adc_hk.phase_max)
+        {
+            adc_hk.phase_max = phase;
+        }
+        // Period follows sample rate, shortest one is at full rate.
+        adc_hk.period = 2 * (LPC_TIMER32_0->MR[0] + 1);
+        if(adc_hk_thread_id != NULL)
+        {
+            osThreadFlagsSet(adc_hk_thread_id, ADC_FLAG_HK);
+        }
+    }
+
+    return;
+}
+#endif // ADC_HOUSEKEEPING
+
+#if ADC_DMA
+static void adc_dma_init(void)
+{
+    uint32_t xfercfg = 0;
+    uint32_t i = 0;
+
+    /* Setup DMA controller with descriptor table. */
+    Chip_DMA_Init(LPC_DMA);
+    Chip_DMA_Enable(LPC_DMA);
+    Chip_DMA_SetSRAMBase(LPC_DMA, DMA_ADDR(Chip_DMA_Table));
+
+    /* Every sequencer A conversion triggers one 32-bit transfer from its global data register. */
+    Chip_DMA_EnableChannel(LPC_DMA, ADC_DMA_CH);
+    Chip_DMA_EnableIntChannel(LPC_DMA, ADC_DMA_CH);
+    Chip_DMA_SetHWTrigger(LPC_DMATRIGMUX, ADC_DMA_CH, DMATRIG_ADC0_SEQA_IRQ);
+    Chip_DMA_SetupChannelConfig(LPC_DMA, ADC_DMA_CH,
+                                (DMA_CFG_HWTRIGEN | DMA_CFG_TRIGPOL_HIGH | DMA_CFG_TRIGTYPE_EDGE |
+                                 DMA_CFG_TRIGBURST_BURST | DMA_CFG_BURSTPOWER_1 | DMA_CFG_CHPRIORITY(0)));
+
+    /* Buffers are linked in loop, each one reloads the other and sets interrupt A when complete. */
+    xfercfg = (DMA_XFERCFG_CFGVALID | DMA_XFERCFG_RELOAD | DMA_XFERCFG_SETINTA |
+               DMA_XFERCFG_WIDTH_32 | DMA_XFERCFG_SRCINC_0 | DMA_XFERCFG_DSTINC_1 |
+               DMA_XFERCFG_XFERCOUNT(ADC_DMA_BLOCK * ADC_OVERSAMPLE * ADC_ID_LAST));
+    for(i = 0; i < 2; i++)
+    {
+        adc_dma_desc[i].xfercfg = xfercfg;
+        adc_dma_desc[i].source = DMA_ADDR(&LPC_ADC->SEQ_GDAT[ADC_SEQA_IDX]);
+        adc_dma_desc[i].dest = DMA_ADDR(&adc_dma_buffer[i][(ADC_DMA_BLOCK * ADC_OVERSAMPLE * ADC_ID_LAST) - 1]);
+        adc_dma_desc[i].next = DMA_ADDR(&adc_dma_desc[i ^ 1]);
+    }
+    Chip_DMA_SetupTranChannel(LPC_DMA, ADC_DMA_CH, &adc_dma_desc[0]);
+    Chip_DMA_SetupChannelTransfer(LPC_DMA, ADC_DMA_CH, xfercfg);
+    adc_dma_active = 0;
+
+    /* Enable DMA NVIC interrupt */
+    NVIC_ClearPendingIRQ(DMA_IRQn);
+    NVIC_EnableIRQ(DMA_IRQn);
+
+    return;
+}
+
+static void adc_dma_thread(void *argument)
+{
+    static uint16_t samples[ADC_ID_LAST][ADC_DMA_BLOCK];
+    uint32_t sum[ADC_ID_LAST];
+    uint32_t valid[ADC_ID_LAST];
+    const uint32_t *raw = NULL;
+    uint32_t ok = 0;
+#if ADC_ERRORS
+    uint32_t invalid = 0;
+    uint32_t overrun = 0;
+#endif // ADC_ERRORS
+    uint32_t time = 0;
+    uint32_t period = 0;
+    uint32_t i = 0;
+    uint32_t j = 0;
+    uint32_t k = 0;
+
+    while(1)
+    {
+        osThreadFlagsWait(ADC_FLAG_BLOCK, osFlagsWaitAny, osWaitForever);
+        // First sample is in the middle of its conversions, rate could change between blocks only.
+        period = adc_dma_period[adc_dma_ready];
+        time = adc_dma_time[adc_dma_ready] + (((ADC_OVERSAMPLE - 1) * period) / 2);
+        // DMA is filling other buffer now, this one is stable for next block time.
+        raw = adc_dma_buffer[adc_dma_ready];
+        for(i = 0; i < ADC_DMA_BLOCK; i++)
+        {
+            // Boxcar decimation of consecutive conversions, rounded, channels are interleaved in order of sequence.
+            for(k = 0; k < ADC_ID_LAST; k++)
+            {
+                sum[k] = 0;
+                valid[k] = 0;
+            }
+            for(j = 0; j < ADC_OVERSAMPLE; j++)
+            {
+                for(k = 0; k < ADC_ID_LAST; k++)
+                {
+#if ADC_ERRORS
+                    // Status bits are counted branch free, it is the hottest loop.
+                    invalid += (~*raw) >> 31;
+                    overrun += (*raw >> 30) & 1;
+#endif // ADC_ERRORS
+                    // Only valid results without overrun are summed, masked instead of branch.
+                    ok = (*raw >> 31) & ~(*raw >> 30);
+                    sum[k] += ADC_DR_RESULT(*raw++) & (0 - ok);
+                    valid[k] += ok;
+                }
+            }
+            for(k = 0; k < ADC_ID_LAST; k++)
+            {
+                if(valid[k] == ADC_OVERSAMPLE)
+                {
+                    samples[k][i] = (uint16_t)((sum[k] + (ADC_OVERSAMPLE / 2)) / ADC_OVERSAMPLE);
+                }
+                else if(valid[k])
+                {
+                    samples[k][i] = (uint16_t)((sum[k] + (valid[k] / 2)) / valid[k]);
+                }
+                else
+                {
+                    // No valid conversion, previous sample is kept, it is last of previous block for first one.
+                    samples[k][i] = samples[k][(i + ADC_DMA_BLOCK - 1) % ADC_DMA_BLOCK];
+                }
+            }
+        }
+        // Each detector runs over its whole block, so its state stays in registers, one pass over channels with
+        // detector state as structure of arrays reloads it every sample and was slower (sin_detect_eval layout case).
+        for(k = 0; k < ADC_ID_LAST; k++)
+        {
+            sin_detect_process_block_timed(adc_seqa_ch_config[k].detect, samples[k], ADC_DMA_BLOCK, time,
+                                           ADC_OVERSAMPLE * period);
+        }
+#if ADC_CAPTURE
+        adc_capture_put(samples, time, ADC_OVERSAMPLE * period);
+#endif // ADC_CAPTURE
+        adc_dma_pending = false;
+#if ADC_ERRORS
+        adc_errors.invalid += invalid;
+        adc_errors.overrun += overrun;
+        invalid = 0;
+        overrun = 0;
+#endif // ADC_ERRORS
+    }
+}
+
+/**
+ * @brief   DMA interrupt handler, ping-pong buffer is complete.
+ */
+void DMA_IRQHandler(void)
+{
+    uint32_t period = 0;
+    uint32_t since = 0;
+    uint32_t trigger = 0;
+    uint32_t done = 0;
+    bool idle = false;
+
+    if(Chip_DMA_GetActiveIntAChannels(LPC_DMA) & (1 << ADC_DMA_CH))
+    {
+        Chip_DMA_ClearActiveIntAChannel(LPC_DMA, ADC_DMA_CH);
+        adc_dma_ready = adc_dma_active;
+        adc_dma_active ^= 1;
+        // Whole block was converted at one rate, it changes only here.
+        period = timers_32_0_get_period();
+        adc_dma_period[adc_dma_ready] = period;
+        // Trigger is read once, block time is counted on from first trigger after start and only checked against it.
+        if(adc_dma_irq_count == 0)
+        {
+            adc_timing_block_init(&adc_dma_timing, timers_32_0_get_first());
+        }
+        trigger = timers_32_0_get_trigger(&since);
+        // Transfer count field holds transfers left minus one, it is reloaded for next block already.
+        done = (ADC_DMA_BLOCK * ADC_OVERSAMPLE * ADC_ID_LAST)
+               - (((LPC_DMA->DMACH[ADC_DMA_CH].XFERCFG >> 16) & 0x3FF) + 1);
+        done /= ADC_ID_LAST;
+        adc_dma_time[adc_dma_ready] = adc_timing_block_done(&adc_dma_timing, period, trigger, since, done, &idle);
+#if ADC_ADAPTIVE
+        // Rate can change only if last trigger is last of block, block boundary is the sample boundary.
+        if(idle)
+        {
+            adc_adapt();
+        }
+#endif // ADC_ADAPTIVE
+        adc_timing_block_next(&adc_dma_timing, timers_32_0_get_period());
+        adc_dma_irq_count++;
+#if ADC_ERRORS
+        // Thread is still on previous block, DMA is writing into buffer it reads.
+        if(adc_dma_pending)
+        {
+            adc_errors.late++;
+        }
+#endif // ADC_ERRORS
+        adc_dma_pending = true;
+#if ADC_HOUSEKEEPING
+        // Last conversion of block was just moved, sequencer A is idle until next trigger.
+        adc_hk_trigger();
+#endif // ADC_HOUSEKEEPING
+        if(adc_dma_thread_id != NULL)
+        {
+            osThreadFlagsSet(adc_dma_thread_id, ADC_FLAG_BLOCK);
+        }
+        timers_32_0_update_profile();
+    }
+
+    return;
+}
+#elif ADC_HW_TRIGGER
+/**
+ * @brief   ADC sequence A interrupt handler, conversion was triggered by CT32B0 MAT0.
+ */
+void ADC_A_IRQHandler(void)
+{
+#if ADC_JITTER
+    adc_jitter_update();
+#endif // ADC_JITTER
+
+    if(Chip_ADC_GetFlags(LPC_ADC) & ADC_FLAGS_SEQA_INT_MASK)
+    {
+        Chip_ADC_ClearFlags(LPC_ADC, ADC_FLAGS_SEQA_INT_MASK);
+        // End of sequence, all channels are converted.
+#if ADC_HOUSEKEEPING
+        adc_hk_trigger();
+#endif // ADC_HOUSEKEEPING
+        adc_decimate();
+#if ADC_ERRORS
+        // Next sequence ended before this one was handled.
+        if(Chip_ADC_GetFlags(LPC_ADC) & ADC_FLAGS_SEQA_INT_MASK)
+        {
+            adc_errors.late++;
+        }
+#endif // ADC_ERRORS
+        timers_32_0_update_profile();
+    }
+
+    return;
+}
+#elif ADC_THRESHOLD
+/**
+ * @brief   ADC threshold crossing interrupt handler, signal crossed zero level outside hysteresis.
+ */
+void ADC_A_IRQHandler(void)
+{
+    uint32_t time = 0;
+
+    // Timestamp first, interrupt latency is the only timing error.
+    time = timers_32_1_get_count();
+
+    if(Chip_ADC_GetFlags(LPC_ADC) & ADC_FLAGS_THCMP_MASK(adc_seqa_ch_config[ADC_ID_SINUS_DETECT].ch))
+    {
+        Chip_ADC_ClearFlags(LPC_ADC, ADC_FLAGS_THCMP_MASK(adc_seqa_ch_config[ADC_ID_SINUS_DETECT].ch));
+        // Wait for crossing in opposite direction, signal is now on the other side of zero level.
+        adc_threshold_set(!adc_threshold_high);
+        sin_detect_process_crossing(&sin_detect_main, time, adc_threshold_high);
+    }
+
+    return;
+}
+#endif // ADC_DMA
+
+#if ADC_CAPTURE
+static void adc_capture_put(uint16_t samples[ADC_ID_LAST][ADC_DMA_BLOCK], uint32_t time, uint32_t period)
+{
+    // Static, so DMA thread stack does not grow by block.
+    static adc_capture_t capture;
+    sin_detect_output_t output = {0};
+    uint32_t k = 0;
+
+    if(adc_capture_queue_id == NULL)
+    {
+        return;
+    }
+
+    capture.block.sequence = adc_capture_sequence;
+    capture.block.count = ADC_DMA_BLOCK;
+    capture.block.time = time;
+    capture.block.period = period;
+    memcpy(capture.samples, samples, sizeof(capture.samples));
+    adc_capture_sequence += ADC_DMA_BLOCK;
+    // Outputs are taken right after block, replay compares its own state at the same sample.
+    for(k = 0; k < ADC_ID_LAST; k++)
+    {
+        sin_detect_get_output(adc_seqa_ch_config[k].detect, &output);
+        capture.output[k].sequence = adc_capture_sequence;
+        capture.output[k].channel = (uint8_t)k;
+        capture.output[k].flags = output.valid ? CAPTURE_OUTPUT_VALID : 0;
+        capture.output[k].flags |= output.state ? CAPTURE_OUTPUT_STATE : 0;
+        capture.output[k].divider = (uint16_t)output.divider;
+        capture.output[k].frequency = output.frequency;
+    }
+    // Lost block leaves gap in sequence, capture thread counts it.
+    osMessageQueuePut(adc_capture_queue_id, &capture, 0, 0);
+
+    return;
+}
+
+static void adc_capture_thread(void *argument)
+{
+    static uint8_t record[ADC_CAPTURE_SIZE];
+    static adc_capture_t capture;
+    capture_header_t header = {0};
+    uint32_t sequence = 0;
+    uint32_t blocks = 0;
+    uint32_t size = 0;
+    uint32_t k = 0;
+
+    header.version = CAPTURE_VERSION;
+    header.channels = ADC_ID_LAST;
+    header.bits = CAPTURE_BITS;
+    header.flags = CAPTURE_FLAG_TIMESTAMPS;
+    header.rate = (uint32_t)(SIN_DETECT_RATE * 1000.0F);
+    header.clock = bsp_get_core_clock();
+    for(k = 0; k < ADC_ID_LAST; k++)
+    {
+        header.map[k] = adc_seqa_ch_config[k].ch;
+    }
+    bsp_get_board_id(header.board);
+    header.firmware[0] = APP_VERSION_0;
+    header.firmware[1] = APP_VERSION_1;
+    header.firmware[2] = APP_VERSION_2;
+    header.firmware[3] = APP_VERSION_3;
+
+    while(1)
+    {
+        osMessageQueueGet(adc_capture_queue_id, &capture, NULL, osWaitForever);
+        adc_capture_lost += (capture.block.sequence - sequence) / ADC_DMA_BLOCK;
+        sequence = capture.block.sequence + ADC_DMA_BLOCK;
+        // Header is repeated, so host can join running capture.
+        if((blocks++ % ADC_CAPTURE_HEADER) == 0)
+        {
+            size = capture_write_header(record, sizeof(record), &header);
+            debug_send_data_os(record, size);
+        }
+        size = capture_write_samples(record, sizeof(record), &header, &capture.block, &capture.samples[0][0],
+                                     ADC_DMA_BLOCK);
+        for(k = 0; k < ADC_ID_LAST; k++)
+        {
+            size += capture_write_output(&record[size], sizeof(record) - size, &capture.output[k]);
+        }
+        if(!debug_send_data_os(record, size))
+        {
+            adc_capture_lost++;
+        }
+    }
+}
+#endif // ADC_CAPTURE
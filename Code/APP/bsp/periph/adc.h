@@ -28,6 +28,7 @@ extern "C" {
  * Includes
  *********************************************************************************************************************/
 #include <stdint.h>
+#include <stdbool.h>
 
 /**********************************************************************************************************************
  * Exported definitions and macros
@@ -35,6 +36,41 @@ extern "C" {
 #define ADC_CLK                 4400000     //!< 1000000, set to 4.4Mhz
 #define ADC_VREF                2500.0F     //!< Reference voltage in mV.
 #define ADC_RESOLUTION          4096.0F     //!< ADC resolution 12 bit.
+#define ADC_HW_TRIGGER          1           //!< Sequencer A triggered by CT32B0 MAT0 - 1, read from CT32B0 interrupt - 0.
+#define ADC_JITTER              0           //!< Sampling interrupt jitter measurement enable - 1, disable - 0, not with DMA.
+#define ADC_DMA                 1           //!< Samples moved by DMA in blocks to thread - 1, ADC interrupt per sample - 0.
+#define ADC_DMA_BLOCK           64          //!< DMA ping-pong buffer size in samples.
+#define ADC_OVERSAMPLE          8           //!< Conversions per sample, averaged by boxcar decimation, needs DMA.
+#define ADC_THRESHOLD           0           //!< Zero crossings detected by ADC threshold comparator - 1, sampled - 0.
+#define ADC_THRESHOLD_ZERO      2048        //!< Threshold comparator zero level in ADC counts.
+#define ADC_THRESHOLD_HYS       25          //!< Threshold comparator hysteresis around zero level in ADC counts.
+#define ADC_ADAPTIVE            1           //!< Sample rate follows measured frequency - 1, fixed rate - 0.
+#define ADC_ERRORS              1           //!< Sample stream overrun, invalid and late sample counters enable - 1, disable - 0.
+#define ADC_HOUSEKEEPING        1           //!< Housekeeping channels on sequencer B enable - 1, disable - 0.
+#define ADC_HOUSEKEEPING_PERIOD 1000        //!< Housekeeping conversions period in ms.
+#define ADC_HK_TIMEOUT          250         //!< Housekeeping sequence timeout in ms, two DMA blocks at max. divider.
+#define ADC_CAPTURE             0           //!< Samples and detector outputs streamed on debug UART - 1, disable - 0.
+#define ADC_CAPTURE_QUEUE       4           //!< Blocks queued for capture thread, covers bursts of debug text.
+#define ADC_CAPTURE_HEADER      64          //!< Blocks between repeated capture headers.
+
+#if ADC_DMA && !ADC_HW_TRIGGER
+#error "ADC_DMA: requires ADC_HW_TRIGGER!"
+#endif
+#if ADC_THRESHOLD && (ADC_HW_TRIGGER || ADC_DMA)
+#error "ADC_THRESHOLD: requires free-running burst, disable ADC_HW_TRIGGER and ADC_DMA!"
+#endif
+#if ADC_ADAPTIVE && ADC_THRESHOLD
+#error "ADC_ADAPTIVE: there is no sampling rate in threshold mode, disable ADC_ADAPTIVE!"
+#endif
+#if ADC_HOUSEKEEPING && !ADC_HW_TRIGGER
+#error "ADC_HOUSEKEEPING: burst sequencer A leaves no free slots, enable ADC_HW_TRIGGER!"
+#endif
+#if ADC_CAPTURE && !ADC_DMA
+#error "ADC_CAPTURE: blocks are captured by DMA thread, enable ADC_DMA!"
+#endif
+#if !ADC_DMA && !ADC_THRESHOLD && (ADC_OVERSAMPLE > 1)
+#error "ADC_OVERSAMPLE: without DMA every conversion interrupts, enable ADC_DMA or set ADC_OVERSAMPLE to 1!"
+#endif
 
 
 /**Convert ADC value to millivolts. */
@@ -44,7 +80,11 @@ extern "C" {
  * Exported types
  *********************************************************************************************************************/
 /**
- * @brief ADC channel list.
+ * @brief ADC channel list, sequencer A scans all of them on every trigger.
+ *
+ * @note    Keep in ascending order of ADC channel number, it is order of conversions in sequence. Sequence must be
+ *          converted before next trigger, rate * @ref ADC_OVERSAMPLE * count must stay below @ref ADC_CLK / 25, and
+ *          sequence B must fit after it with @ref ADC_HOUSEKEEPING, adc_timing_test checks it.
  */
 typedef enum
 {
@@ -52,6 +92,51 @@ typedef enum
     ADC_ID_LAST,                //!< Last should stay last.
 } adc_id_t;
 
+/**
+ * @brief ADC housekeeping channel list, sequencer B converts all of them on request from housekeeping thread.
+ */
+typedef enum
+{
+    ADC_HK_ID_SUPPLY = 0,       //!< Supply voltage divider PIN.
+    ADC_HK_ID_LAST,             //!< Last should stay last.
+} adc_hk_id_t;
+
+#if ADC_DMA && ((ADC_DMA_BLOCK * ADC_OVERSAMPLE * ADC_ID_LAST) > 1024)
+#error "ADC_DMA_BLOCK: DMA transfer is limited to 1024 conversions!"
+#endif
+
+/**
+ * @brief   Sampling interrupt jitter, CT32B0 count at interrupt entry, in core clock cycles since timer match.
+ */
+typedef struct
+{
+    uint32_t count;         //!< Last interrupt count.
+    uint32_t count_min;     //!< Minimum interrupt count since start.
+    uint32_t count_max;     //!< Maximum interrupt count since start.
+} adc_jitter_t;
+
+/**
+ * @brief   Sample stream errors, stream is gap-free while all counters stay 0.
+ */
+typedef struct
+{
+    uint32_t overrun;       //!< Conversion results overwritten before read.
+    uint32_t invalid;       //!< Results read without valid data, previous result was used again.
+    uint32_t late;          //!< Samples or blocks processed after next one was due.
+} adc_errors_t;
+
+/**
+ * @brief   Housekeeping data, conversion time is phase of sequencer A period, in core clock cycles since trigger.
+ */
+typedef struct
+{
+    uint32_t value[ADC_HK_ID_LAST]; //!< Last conversion results in ADC counts.
+    uint32_t count;                 //!< Completed sequences count.
+    uint32_t lost;                  //!< Sequences not completed in time count.
+    uint32_t period;                //!< Sequencer A trigger period.
+    uint32_t phase_max;             //!< Maximum phase of sequence B completion, must be below period.
+} adc_hk_t;
+
 /**********************************************************************************************************************
  * Prototypes of exported constants
  *********************************************************************************************************************/
@@ -69,9 +154,105 @@ typedef enum
 void adc_init(void);
 /**
  * @brief   ADC handler for timer.
+ *
+ * @note    Timer runs at sample rate, @ref ADC_OVERSAMPLE is 1 without DMA, every call reads new burst conversion.
+ *
+ * @note    Used only if @ref ADC_HW_TRIGGER is disabled, otherwise samples are processed in ADC or DMA interrupt.
  */
 void adc_handler(void);
 
+/**
+ * @brief   ADC handler for periodic time base tick.
+ *
+ * @note    Used only if @ref ADC_THRESHOLD is enabled, checks for signal loss.
+ *
+ * @param   time    Current time base count.
+ */
+void adc_tick_handler(uint32_t time);
+
+/**
+ * @brief   Start ADC DMA block processing thread.
+ *
+ * @note    Used only if @ref ADC_DMA is enabled, must be called from thread before sampling timer is started.
+ *
+ * @return  State of thread creation.
+ * @retval  0   failed.
+ * @retval  1   success.
+ */
+bool adc_dma_start(void);
+
+/**
+ * @brief   Get sample rate divider applied to sampling timer.
+ *
+ * @note    Rate is changed only if @ref ADC_ADAPTIVE is enabled.
+ *
+ * @return  Divider of configured sample rate, 1 - full rate.
+ */
+uint32_t adc_get_divider(void);
+
+/**
+ * @brief   Get sample stream errors.
+ *
+ * @note    Errors are counted only if @ref ADC_ERRORS is enabled. Overrun is counted only with @ref ADC_HW_TRIGGER,
+ *          burst sequencer overwrites results between timer reads by design.
+ *
+ * @param   errors  Pointer to errors to fill. See @ref adc_errors_t.
+ */
+void adc_get_errors(adc_errors_t *errors);
+
+/**
+ * @brief   Start ADC housekeeping thread.
+ *
+ * @note    Used only if @ref ADC_HOUSEKEEPING is enabled.
+ *
+ * @return  State of thread creation.
+ * @retval  0   failed.
+ * @retval  1   success.
+ */
+bool adc_hk_start(void);
+
+/**
+ * @brief   Get ADC housekeeping data.
+ *
+ * @param   hk  Pointer to housekeeping data to fill. See @ref adc_hk_t.
+ */
+void adc_hk_get(adc_hk_t *hk);
+
+/**
+ * @brief   Start ADC capture thread, it streams samples and detector outputs of every block.
+ *
+ * @note    Used only if @ref ADC_CAPTURE is enabled, must be called from thread before sampling timer is started.
+ *          Records share debug UART with text, see capture.h.
+ *
+ * @return  State of thread creation.
+ * @retval  0   failed.
+ * @retval  1   success.
+ */
+bool adc_capture_start(void);
+
+/**
+ * @brief   Get blocks lost by capture, queue was full or UART did not take record in time.
+ *
+ * @return  Lost blocks count since start.
+ */
+uint32_t adc_capture_get_lost(void);
+
+/**
+ * @brief   Get ADC DMA buffer complete interrupts count.
+ *
+ * @return  Interrupts count since start.
+ */
+uint32_t adc_dma_get_irq_count(void);
+
+/**
+ * @brief   Get sampling interrupt jitter.
+ *
+ * @note    Jitter is collected only if @ref ADC_JITTER is enabled, it is count_max - count_min.
+ *
+ * @param   jitter  Pointer to jitter to fill. See @ref adc_jitter_t.
+ */
+void adc_get_jitter(adc_jitter_t *jitter);
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,139 @@
+/**
+ **********************************************************************************************************************
+ * @file        adc_timing.c
+ * @author      Diamond Sparrow
+ * @version     1.0.0.0
+ * @date        2026-10-16
+ * @brief       ADC sequencer timing C source file, hardware free, so it is tested on host.
+ **********************************************************************************************************************
+ * @warning     THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR \n
+ *              IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND\n
+ *              FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR\n
+ *              CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL\n
+ *              DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,\n
+ *              DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN\n
+ *              CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF\n
+ *              THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ **********************************************************************************************************************
+ */
+
+/**********************************************************************************************************************
+ * Includes
+ *********************************************************************************************************************/
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "bsp/periph/adc_timing.h"
+
+/**********************************************************************************************************************
+ * Private definitions and macros
+ *********************************************************************************************************************/
+
+/**********************************************************************************************************************
+ * Private typedef
+ *********************************************************************************************************************/
+
+/**********************************************************************************************************************
+ * Private constants
+ *********************************************************************************************************************/
+
+/**********************************************************************************************************************
+ * Private variables
+ *********************************************************************************************************************/
+
+/**********************************************************************************************************************
+ * Exported variables
+ *********************************************************************************************************************/
+
+/**********************************************************************************************************************
+ * Prototypes of local functions
+ *********************************************************************************************************************/
+
+/**********************************************************************************************************************
+ * Exported functions
+ *********************************************************************************************************************/
+uint32_t adc_timing_phase(uint32_t count, bool high, uint32_t match)
+{
+    // Match value plus one is half of sequencer A period.
+    if(!high)
+    {
+        count += match + 1;
+    }
+
+    return count;
+}
+
+bool adc_timing_seqb_fits(uint32_t phase, uint32_t period)
+{
+    // Late sequence A interrupt can come after next trigger, sequence A is converting then.
+    if(phase < ADC_TIMING_SEQA_CYCLES)
+    {
+        return false;
+    }
+
+    return (phase + ADC_TIMING_SEQB_MARGIN + ADC_TIMING_SEQB_CYCLES) < period;
+}
+
+void adc_timing_block_init(adc_timing_block_t *block, uint32_t first)
+{
+    block->first = first;
+    block->last = first;
+    block->resync = 0;
+    block->synced = true;
+
+    return;
+}
+
+uint32_t adc_timing_block_done(adc_timing_block_t *block, uint32_t period, uint32_t trigger, uint32_t since,
+                               uint32_t done, bool *idle)
+{
+    const uint32_t triggers = ADC_DMA_BLOCK * ADC_OVERSAMPLE;
+    int32_t diff = 0;
+    uint32_t ahead = UINT32_MAX;
+    uint32_t moved = done;
+    bool sure = true;
+
+    block->last = block->first + ((triggers - 1) * period);
+    // Triggers since last of block, fixed delay between timer reads is far below half period.
+    diff = (int32_t)(trigger - block->last);
+    if(diff > -(int32_t)(period / 2))
+    {
+        ahead = (uint32_t)(diff + (int32_t)(period / 2)) / period;
+    }
+    // Transfers of last trigger are surely not done before its sequence is converted and surely done after settle.
+    if(since < ADC_TIMING_SEQA_CYCLES)
+    {
+        moved++;
+    }
+    else if(since < ADC_TIMING_DMA_SETTLE)
+    {
+        sure = false;
+    }
+    // Else DMA missed trigger or interrupt came after next block.
+    if(!block->synced || (sure ? (ahead != moved) : ((ahead != done) && (ahead != (done + 1)))))
+    {
+        if(block->synced)
+        {
+            block->resync++;
+        }
+        // Timing taken while transfers of last trigger are not sure can be one period off, rate must not change.
+        block->synced = sure;
+        block->last = trigger - (moved * period);
+        ahead = sure ? moved : 1;
+    }
+    *idle = (ahead == 0);
+
+    return block->last - ((triggers - 1) * period);
+}
+
+void adc_timing_block_next(adc_timing_block_t *block, uint32_t period)
+{
+    // Rate changes only between triggers, so next block starts one new period after last trigger.
+    block->first = block->last + period;
+
+    return;
+}
+
+/**********************************************************************************************************************
+ * Private functions
+ *********************************************************************************************************************/
@@ -0,0 +1,144 @@
+/**
+ **********************************************************************************************************************
+ * @file        adc_timing.h
+ * @author      Diamond Sparrow
+ * @version     1.0.0.0
+ * @date        2026-10-16
+ * @brief       ADC sequencer timing C header file, hardware free, so it is tested on host.
+ **********************************************************************************************************************
+ * @warning     THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR \n
+ *              IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND\n
+ *              FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR\n
+ *              CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL\n
+ *              DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,\n
+ *              DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN\n
+ *              CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF\n
+ *              THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ **********************************************************************************************************************
+ */
+
+#ifndef ADC_TIMING_H_
+#define ADC_TIMING_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**********************************************************************************************************************
+ * Includes
+ *********************************************************************************************************************/
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "bsp/periph/adc.h"
+#include "sin_detect.h"
+
+/**********************************************************************************************************************
+ * Exported definitions and macros
+ *********************************************************************************************************************/
+/** Conversion time of conversions count in core clock cycles, ADC needs 25 clocks per conversion. */
+#define ADC_TIMING_CYCLES(COUNT)    ((uint32_t)(((COUNT) * 25 * SIN_DETECT_CLOCK) / ADC_CLK) + 1)
+/** Sequencer A conversion time in core clock cycles. */
+#define ADC_TIMING_SEQA_CYCLES      ADC_TIMING_CYCLES(ADC_ID_LAST)
+/** Sequencer B conversion time in core clock cycles. */
+#define ADC_TIMING_SEQB_CYCLES      ADC_TIMING_CYCLES(ADC_HK_ID_LAST)
+/** Core clock cycles from sequencer B start call till its conversion starts, covers register writes. */
+#define ADC_TIMING_SEQB_MARGIN      32
+/** Core clock cycles after trigger when its sequence A is surely moved by DMA. */
+#define ADC_TIMING_DMA_SETTLE       (ADC_TIMING_SEQA_CYCLES + 32)
+
+/**********************************************************************************************************************
+ * Exported types
+ *********************************************************************************************************************/
+/**
+ * @brief   DMA block timing, first trigger time is carried from block to block.
+ */
+typedef struct
+{
+    uint32_t first;     //!< First trigger time of block being filled, 32-bit timer 1 count.
+    uint32_t last;      //!< Last trigger time of completed block, 32-bit timer 1 count.
+    uint32_t resync;    //!< Times block timing was taken again from trigger time after stream slip.
+    bool synced;        //!< Flag that shows if first trigger time is known.
+} adc_timing_block_t;
+
+/**********************************************************************************************************************
+ * Prototypes of exported constants
+ *********************************************************************************************************************/
+
+/**********************************************************************************************************************
+ * Prototypes of exported variables
+ *********************************************************************************************************************/
+
+/**********************************************************************************************************************
+ * Prototypes of exported functions
+ *********************************************************************************************************************/
+/**
+ * @brief   Get phase of sequencer A period.
+ *
+ * @note    CT32B0 MAT0 toggles on every match and rising edge triggers sequencer A, timer resets on match, so phase is
+ *          timer count in first half of period and timer count plus match value plus one in second half.
+ *
+ * @param   count   CT32B0 count.
+ * @param   high    MAT0 level, high in first half of period.
+ * @param   match   CT32B0 match value.
+ *
+ * @return  Core clock cycles since last sequencer A trigger.
+ */
+uint32_t adc_timing_phase(uint32_t count, bool high, uint32_t match);
+
+/**
+ * @brief   Check if sequence B started now converts between sequences A.
+ *
+ * @note    Sequence A of last trigger must be converted already and sequence B must be converted before next trigger,
+ *          else it would delay sampling instant of sequence A.
+ *
+ * @param   phase   Core clock cycles since last sequencer A trigger, see @ref adc_timing_phase.
+ * @param   period  Sequencer A trigger period in core clock cycles.
+ *
+ * @return  State of sequence B fit.
+ * @retval  0   sequence B must wait for next sequence A.
+ * @retval  1   sequence B can be started.
+ */
+bool adc_timing_seqb_fits(uint32_t phase, uint32_t period);
+
+/**
+ * @brief   Initialize DMA block timing.
+ *
+ * @param   block   Block timing.
+ * @param   first   First trigger time, see @ref timers_32_0_get_first.
+ */
+void adc_timing_block_init(adc_timing_block_t *block, uint32_t first);
+
+/**
+ * @brief   Get time of DMA block that was just completed.
+ *
+ * @note    Triggers are one period apart, so block time is counted on from first trigger, latched trigger time only
+ *          checks it and shows if next block has started. Sequence of last trigger may be still converting or moving,
+ *          so its transfers may not be counted in done, both counts are right till settle time. After stream slip
+ *          timing is taken from trigger time again, till it is sure sample rate must not change.
+ *
+ * @param   block   Block timing.
+ * @param   period  Trigger period of completed block in core clock cycles.
+ * @param   trigger Time of last trigger, see @ref timers_32_0_get_trigger.
+ * @param   since   Core clock cycles since last trigger.
+ * @param   done    Triggers of next block with all transfers done.
+ * @param   idle    Pointer where to save if there was no trigger since last of block, sample rate can change then.
+ *
+ * @return  First trigger time of completed block, 32-bit timer 1 count.
+ */
+uint32_t adc_timing_block_done(adc_timing_block_t *block, uint32_t period, uint32_t trigger, uint32_t since,
+                               uint32_t done, bool *idle);
+
+/**
+ * @brief   Start timing of next DMA block, it is called after sample rate could change.
+ *
+ * @param   block   Block timing.
+ * @param   period  Trigger period of next block in core clock cycles.
+ */
+void adc_timing_block_next(adc_timing_block_t *block, uint32_t period);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ADC_TIMING_H_ */
@@ -26,11 +26,16 @@
 #include "bsp/periph/timers.h"
 #include "bsp/periph/adc.h"
 
+#include "sin_detect.h"
+
 #include "chip.h"
 
 /**********************************************************************************************************************
  * Private definitions and macros
  *********************************************************************************************************************/
+#if TIMERS_32_1_CAPTURE && ADC_THRESHOLD
+#error "TIMERS_32_1_CAPTURE: zero crossings can come from one source only, disable ADC_THRESHOLD!"
+#endif
 
 /**********************************************************************************************************************
  * Private typedef
@@ -43,6 +48,16 @@
 /**********************************************************************************************************************
  * Private variables
  *********************************************************************************************************************/
+/** Sampling interrupt profile. */
+static volatile timers_profile_t timers_32_0_profile = {0};
+/** 32-bit timer 0 match period at start rate, in counts. */
+static uint32_t timers_32_0_period = 0;
+/** First trigger time after start, 32-bit timer 1 count. */
+static uint32_t timers_32_0_first = 0;
+/** 32-bit timer 0 late interrupts count. */
+static volatile uint32_t timers_32_0_late = 0;
+/** 32-bit timer 1 periodic interrupt step in counts. */
+static uint32_t timers_32_1_step = 0;
 
 /**********************************************************************************************************************
  * Exported variables
@@ -69,8 +84,10 @@ void timers_32_0_init(void)
     /* Timer setup for match and interrupt at TICKRATE_HZ */
     Chip_TIMER_Reset(LPC_TIMER32_0);
 
+#if !ADC_HW_TRIGGER
     /* Enable both timers to generate interrupts when time matches */
     Chip_TIMER_MatchEnableInt(LPC_TIMER32_0, 0);
+#endif // ADC_HW_TRIGGER
 
     /* Setup prescale value on 32-bit timer to extend range */
     //Chip_TIMER_PrescaleSet(LPC_TIMER32_0, 0xFFFFFFFF);
@@ -81,17 +98,21 @@ void timers_32_0_init(void)
     /* Setup both timers to restart when match occurs */
     Chip_TIMER_ResetOnMatchEnable(LPC_TIMER32_0, 0);
 
-    /* Sets external match control (MATn.matchnum) pin control */
-    //Chip_TIMER_ExtMatchControlSet(LPC_TIMER32_0, 0, TIMER_EXTMATCH_TOGGLE, 0);
+#if ADC_HW_TRIGGER
+    /* MAT0 toggles on match, its rising edge triggers ADC sequencer A. */
+    Chip_TIMER_ExtMatchControlSet(LPC_TIMER32_0, 0, TIMER_EXTMATCH_TOGGLE, 0);
+#endif // ADC_HW_TRIGGER
 
     /* Enable timer. */
     //Chip_TIMER_Enable(LPC_TIMER32_0);
 
+#if !ADC_HW_TRIGGER
     /* Clear both timers of any pending interrupts */
     NVIC_ClearPendingIRQ(TIMER_32_0_IRQn);
 
     /* Enable both timer interrupts */
     NVIC_EnableIRQ(TIMER_32_0_IRQn);
+#endif // ADC_HW_TRIGGER
 
     return;
 }
@@ -122,15 +143,92 @@ void timers_32_0_start(uint32_t rate)
     /* Timer rate is system clock rate */
     freq = Chip_Clock_GetSystemClockRate();
 
+#if ADC_HW_TRIGGER
+    /* MAT0 toggles on every match, so match at twice the rate gives one rising edge per sample. */
+    timers_32_0_period = freq / (rate * 2);
+#else
     /* Setup 16-bit timer's duration (32-bit match time) */
-    Chip_TIMER_SetMatch(LPC_TIMER32_0, 0, (freq / rate));
+    timers_32_0_period = freq / rate;
+#endif // ADC_HW_TRIGGER
+    /* Timer is reset on count after match, so period is match value plus one. */
+    Chip_TIMER_SetMatch(LPC_TIMER32_0, 0, timers_32_0_period - 1);
 
     /* Start both timers */
+    __disable_irq();
     Chip_TIMER_Enable(LPC_TIMER32_0);
+    // Counter starts from zero with MAT0 low, so first match is first trigger.
+    timers_32_0_first = Chip_TIMER_ReadCount(LPC_TIMER32_1) + timers_32_0_period;
+    __enable_irq();
 
     return;
 }
 
+bool timers_32_0_set_divider(uint32_t divider)
+{
+    uint32_t match = (timers_32_0_period * divider) - 1;
+    bool ret = false;
+
+    __disable_irq();
+#if ADC_HW_TRIGGER
+    // Current half of sample period started at trigger only while MAT0 is high, EMR bit 0 is MAT0 level.
+    if(LPC_TIMER32_0->EMR & (1 << 0))
+#endif // ADC_HW_TRIGGER
+    {
+        // Counter must not pass new match before it is written, it would run till overflow.
+        if((Chip_TIMER_ReadCount(LPC_TIMER32_0) + TIMERS_32_0_MARGIN) < match)
+        {
+            Chip_TIMER_SetMatch(LPC_TIMER32_0, 0, match);
+            ret = true;
+        }
+    }
+    __enable_irq();
+
+    return ret;
+}
+
+uint32_t timers_32_0_get_period(void)
+{
+#if ADC_HW_TRIGGER
+    return 2 * (LPC_TIMER32_0->MR[0] + 1);
+#else
+    return LPC_TIMER32_0->MR[0] + 1;
+#endif // ADC_HW_TRIGGER
+}
+
+uint32_t timers_32_0_get_first(void)
+{
+    return timers_32_0_first;
+}
+
+uint32_t timers_32_0_get_trigger(uint32_t *since)
+{
+    uint32_t count = 0;
+    uint32_t check = 0;
+    uint32_t time = 0;
+
+    __disable_irq();
+    do
+    {
+        // Both timers count core clock, so fixed delay between reads is only constant offset of all times.
+        count = Chip_TIMER_ReadCount(LPC_TIMER32_0);
+        check = count;
+#if ADC_HW_TRIGGER
+        // Conversion is triggered on rising MAT0 edge, while MAT0 is low second half of sample period runs.
+        if(!(LPC_TIMER32_0->EMR & (1 << 0)))
+        {
+            count += LPC_TIMER32_0->MR[0] + 1;
+        }
+#endif // ADC_HW_TRIGGER
+        time = Chip_TIMER_ReadCount(LPC_TIMER32_1);
+    }
+    // Timer was reset on match between reads, count and MAT0 level could be of different halves.
+    while(Chip_TIMER_ReadCount(LPC_TIMER32_0) < check);
+    __enable_irq();
+    *since = count;
+
+    return time - count;
+}
+
 void timers_32_0_stop(void)
 {
     /* Disable timer. */
@@ -139,6 +237,86 @@ void timers_32_0_stop(void)
     return;
 }
 
+void timers_32_0_update_profile(void)
+{
+#if TIMERS_32_0_PROFILE
+    uint32_t cycles = 0;
+
+    // Timer is reset on match and runs at core clock, so its count is cycles spent since trigger.
+    timers_32_0_get_trigger(&cycles);
+    timers_32_0_profile.cycles = cycles;
+    if(cycles > timers_32_0_profile.cycles_max)
+    {
+        timers_32_0_profile.cycles_max = cycles;
+    }
+#endif // TIMERS_32_0_PROFILE
+
+    return;
+}
+
+void timers_32_0_get_profile(timers_profile_t *profile)
+{
+    profile->cycles = timers_32_0_profile.cycles;
+    profile->cycles_max = timers_32_0_profile.cycles_max;
+
+    return;
+}
+
+uint32_t timers_32_0_get_late(void)
+{
+    return timers_32_0_late;
+}
+
+void timers_32_1_init(void)
+{
+    /* Initialize 32-bit timer 1 clock */
+    Chip_TIMER_Init(LPC_TIMER32_1);
+
+    /* Timer is free-running, match 0 only generates periodic interrupt */
+    Chip_TIMER_Reset(LPC_TIMER32_1);
+    Chip_TIMER_MatchEnableInt(LPC_TIMER32_1, 0);
+
+#if TIMERS_32_1_CAPTURE
+    /* External comparator output, every edge is zero crossing, latched by hardware without interrupt latency */
+    Chip_IOCON_PinMuxSet(LPC_IOCON, 0, 12, (IOCON_FUNC3 | IOCON_MODE_INACT | IOCON_DIGMODE_EN));
+    Chip_TIMER_CaptureRisingEdgeEnable(LPC_TIMER32_1, 0);
+    Chip_TIMER_CaptureFallingEdgeEnable(LPC_TIMER32_1, 0);
+    Chip_TIMER_CaptureEnableInt(LPC_TIMER32_1, 0);
+#endif // TIMERS_32_1_CAPTURE
+
+    /* Clear timer of any pending interrupts */
+    NVIC_ClearPendingIRQ(TIMER_32_1_IRQn);
+
+    /* Enable timer interrupts */
+    NVIC_EnableIRQ(TIMER_32_1_IRQn);
+
+    return;
+}
+
+void timers_32_1_start(uint32_t rate)
+{
+    uint32_t freq = 0;
+
+    /* Timer rate is system clock rate */
+    freq = Chip_Clock_GetSystemClockRate();
+
+    /* Count at selected rate */
+    Chip_TIMER_PrescaleSet(LPC_TIMER32_1, (freq / rate) - 1);
+
+    /* First periodic interrupt */
+    timers_32_1_step = rate / TIMERS_32_1_TICK;
+    Chip_TIMER_SetMatch(LPC_TIMER32_1, 0, timers_32_1_step);
+
+    /* Start timer */
+    Chip_TIMER_Enable(LPC_TIMER32_1);
+
+    return;
+}
+
+uint32_t timers_32_1_get_count(void)
+{
+    return Chip_TIMER_ReadCount(LPC_TIMER32_1);
+}
 
 /**********************************************************************************************************************
  * Private functions
@@ -148,8 +326,44 @@ void CT32B0_IRQHandler(void)
 {
     if(Chip_TIMER_MatchPending(LPC_TIMER32_0, 0))
     {
-        adc_handler();
+        // Clear before handler, so match during handler is not lost.
         Chip_TIMER_ClearMatch(LPC_TIMER32_0, 0);
+        adc_handler();
+#if ADC_ERRORS
+        if(Chip_TIMER_MatchPending(LPC_TIMER32_0, 0))
+        {
+            timers_32_0_late++;
+        }
+#endif // ADC_ERRORS
+#if !ADC_HW_TRIGGER
+        timers_32_0_update_profile();
+#endif // !ADC_HW_TRIGGER
+    }
+
+    return;
+}
+
+void CT32B1_IRQHandler(void)
+{
+#if TIMERS_32_1_CAPTURE
+    if(Chip_TIMER_CapturePending(LPC_TIMER32_1, 0))
+    {
+        Chip_TIMER_ClearCapture(LPC_TIMER32_1, 0);
+        // Capture does not tell edge, pin reads its level whatever its function is, high after rising edge.
+        sin_detect_process_crossing(&sin_detect_main, Chip_TIMER_ReadCapture(LPC_TIMER32_1, 0),
+                                    Chip_GPIO_GetPinState(LPC_GPIO, 0, 12));
+    }
+#endif // TIMERS_32_1_CAPTURE
+    if(Chip_TIMER_MatchPending(LPC_TIMER32_1, 0))
+    {
+        Chip_TIMER_ClearMatch(LPC_TIMER32_1, 0);
+        // Timer is not reset on match, move match to next period.
+        Chip_TIMER_SetMatch(LPC_TIMER32_1, 0, LPC_TIMER32_1->MR[0] + timers_32_1_step);
+#if TIMERS_32_1_CAPTURE
+        sin_detect_process_timeout(&sin_detect_main, Chip_TIMER_ReadCount(LPC_TIMER32_1));
+#else
+        adc_tick_handler(Chip_TIMER_ReadCount(LPC_TIMER32_1));
+#endif // TIMERS_32_1_CAPTURE
     }
 
     return;
@@ -27,14 +27,28 @@ extern "C" {
 /**********************************************************************************************************************
  * Includes
  *********************************************************************************************************************/
+#include <stdint.h>
+#include <stdbool.h>
 
 /**********************************************************************************************************************
  * Exported definitions and macros
  *********************************************************************************************************************/
+#define TIMERS_32_0_PROFILE     0   //!< Sampling interrupt profiling enable - 1., disable - 0.
+#define TIMERS_32_0_MARGIN      32  //!< 32-bit timer 0 min. counts till new match when rate is changed.
+#define TIMERS_32_1_TICK        100 //!< 32-bit timer 1 periodic interrupt rate in Hz.
+#define TIMERS_32_1_CAPTURE     0   //!< Zero crossings captured by 32-bit timer 1 CAP0 (PIO0_12) enable - 1, disable - 0.
 
 /**********************************************************************************************************************
  * Exported types
  *********************************************************************************************************************/
+/**
+ * @brief   Sampling interrupt profile, cycles are counted from sampling trigger till end of interrupt handler.
+ */
+typedef struct
+{
+    uint32_t cycles;        //!< Last interrupt cycles.
+    uint32_t cycles_max;    //!< Maximum interrupt cycles since start.
+} timers_profile_t;
 
 /**********************************************************************************************************************
  * Prototypes of exported constants
@@ -64,11 +78,106 @@ void timers_32_0_deinit(void);
  */
 void timers_32_0_start(uint32_t rate);
 
+/**
+ * @brief   Divide 32-bit timer 0 start rate without glitch.
+ *
+ * @note    Must be called right after sample, new rate applies from it on. With @ref ADC_HW_TRIGGER it is
+ *          refused in second half of MAT0 period, it would make one sample period of mixed length.
+ *
+ * @param   divider Divider of rate timer was started at.
+ *
+ * @return  State of rate change.
+ * @retval  0   it is too late in timer period, retry after next sample.
+ * @retval  1   rate is changed.
+ */
+bool timers_32_0_set_divider(uint32_t divider);
+
+/**
+ * @brief   Get 32-bit timer 0 sampling trigger period.
+ *
+ * @note    Timer counts at core clock and is reset on match, so ADC conversions are exactly one period apart.
+ *          With @ref ADC_HW_TRIGGER conversion is triggered on every second match.
+ *
+ * @return  Period in core clock cycles, at rate currently applied.
+ */
+uint32_t timers_32_0_get_period(void);
+
+/**
+ * @brief   Get time of first 32-bit timer 0 sampling trigger after start.
+ *
+ * @note    32-bit timer 1 must be started at core clock before timer 0, see @ref timers_32_1_start.
+ *
+ * @return  32-bit timer 1 count at first trigger, its read delay differs from @ref timers_32_0_get_trigger by few
+ *          cycles.
+ */
+uint32_t timers_32_0_get_first(void);
+
+/**
+ * @brief   Get time of last 32-bit timer 0 sampling trigger.
+ *
+ * @note    32-bit timer 1 must be started at core clock, see @ref timers_32_1_start. Trigger is latched from timer
+ *          counts, so interrupt latency does not move it.
+ *
+ * @param   since   Pointer to store core clock cycles passed since trigger.
+ *
+ * @return  32-bit timer 1 count at trigger.
+ */
+uint32_t timers_32_0_get_trigger(uint32_t *since);
+
 /**
  * @brief   Stop 32-bit timer 0.
  */
 void timers_32_0_stop(void);
 
+/**
+ * @brief   Update sampling interrupt profile, must be called at end of sampling interrupt handler.
+ *
+ * @note    Sampling interrupt is 32-bit timer 0 interrupt, ADC sequence A interrupt with @ref ADC_HW_TRIGGER or DMA
+ *          interrupt with @ref ADC_DMA, there cycles include conversion time. Does nothing if
+ *          @ref TIMERS_32_0_PROFILE is disabled.
+ */
+void timers_32_0_update_profile(void);
+
+/**
+ * @brief   Get sampling interrupt profile.
+ *
+ * @note    Profile is collected only if @ref TIMERS_32_0_PROFILE is enabled.
+ *
+ * @param   profile Pointer to profile to fill. See @ref timers_profile_t.
+ */
+void timers_32_0_get_profile(timers_profile_t *profile);
+
+/**
+ * @brief   Get 32-bit timer 0 late interrupts count.
+ *
+ * @note    Interrupt is late if it is still running on next match, so next sample is delayed. Counted only if
+ *          @ref ADC_ERRORS is enabled.
+ *
+ * @return  Late interrupts count since start.
+ */
+uint32_t timers_32_0_get_late(void);
+
+/**
+ * @brief   Initialize 32 bit timer 1 as free-running time base.
+ *
+ * @note    If @ref TIMERS_32_1_CAPTURE is enabled, both edges of external comparator output on CAP0 are captured.
+ */
+void timers_32_1_init(void);
+
+/**
+ * @brief   Start 32-bit timer 1 counting at selected rate, with periodic interrupt at @ref TIMERS_32_1_TICK.
+ *
+ * @param   rate    Count rate in Hz, core clock must be its multiple.
+ */
+void timers_32_1_start(uint32_t rate);
+
+/**
+ * @brief   Get 32-bit timer 1 count.
+ *
+ * @return  Free-running count.
+ */
+uint32_t timers_32_1_get_count(void);
+
 
 #ifdef __cplusplus
 }
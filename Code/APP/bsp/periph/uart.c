@@ -118,6 +118,11 @@ uint32_t uart_0_send_rb_empty(void)
     return (RingBuffer_IsEmpty(&uart_0_tx_rb));
 }
 
+uint32_t uart_0_get_send_rb_free(void)
+{
+    return (uint32_t)RingBuffer_GetFree(&uart_0_tx_rb);
+}
+
 uint32_t uart_0_send_rb_irq(uint8_t *data, uint32_t size)
 {
     return Chip_UART0_SendRB(LPC_USART0, &uart_0_tx_rb, data, size);
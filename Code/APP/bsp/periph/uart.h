@@ -29,10 +29,16 @@ extern "C" {
  *********************************************************************************************************************/
 #include <stdint.h>
 
+#include "bsp/periph/adc.h"
+
 /**********************************************************************************************************************
  * Exported definitions and macros
  *********************************************************************************************************************/
+#if ADC_CAPTURE
+#define UART_0_BAUDRATE             230400  //!< UART 0 baudrate in bps, raised for sample capture stream.
+#else
 #define UART_0_BAUDRATE             115200  //!< UART 0 baudrate in bps.
+#endif // ADC_CAPTURE
 #define UART_0_TX_DATA_SIZE         512     //!< UART 0 transmit data buffer size in bytes.
 #define UART_0_RX_DATA_SIZE         512     //!< UART 0 receive data buffer size in bytes.
 
@@ -73,6 +79,13 @@ void uart_0_send_blocking(const uint8_t data[], uint32_t size);
  */
 uint32_t uart_0_is_send_rb_empty(void);
 
+/**
+ * @brief   Get free space of UART 0 send ring buffer.
+ *
+ * @return  Free space in bytes.
+ */
+uint32_t uart_0_get_send_rb_free(void);
+
 /**
  * @brief   Send data to UART 0 using ring buffer via interrupt.
  *
@@ -0,0 +1,144 @@
+/**
+ **********************************************************************************************************************
+ * @file        sin_detect_hal.c
+ * @author      Diamond Sparrow
+ * @version     1.0.0.0
+ * @date        2026-10-16
+ * @brief       Sinusoidal signal frequency detection hardware abstraction of LPC11U68 board C source file.
+ **********************************************************************************************************************
+ * @warning     THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR \n
+ *              IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND\n
+ *              FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR\n
+ *              CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL\n
+ *              DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,\n
+ *              DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN\n
+ *              CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF\n
+ *              THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ **********************************************************************************************************************
+ */
+
+/**********************************************************************************************************************
+ * Includes
+ *********************************************************************************************************************/
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "periph/gpio.h"
+
+#include "sin_detect_hal.h"
+#include "chip.h"
+#include "cmsis_os2.h"
+
+/**********************************************************************************************************************
+ * Private definitions and macros
+ *********************************************************************************************************************/
+#define SIN_DETECT_HAL_FLAG_WORK    0x0001  //!< Thread flag: work is signalled.
+
+/**********************************************************************************************************************
+ * Private typedef
+ *********************************************************************************************************************/
+
+/**********************************************************************************************************************
+ * Private constants
+ *********************************************************************************************************************/
+/** Sin detection work thread attributes. */
+const osThreadAttr_t sin_detect_hal_thread_attr =
+{
+    .name = "SIN",
+    .stack_size = 512,
+    .priority = osPriorityAboveNormal,
+};
+
+/**********************************************************************************************************************
+ * Private variables
+ *********************************************************************************************************************/
+
+/**********************************************************************************************************************
+ * Exported variables
+ *********************************************************************************************************************/
+
+/**********************************************************************************************************************
+ * Prototypes of local functions
+ *********************************************************************************************************************/
+/**
+ * @brief   Sin detection work thread, runs work once per signal.
+ *
+ * @param   argument    Pointer to work. See @ref sin_detect_hal_work_t.
+ */
+static void sin_detect_hal_thread(void *argument);
+
+/**********************************************************************************************************************
+ * Exported functions
+ *********************************************************************************************************************/
+void sin_detect_hal_led(uint32_t led, bool on)
+{
+    if(led >= GPIO_ID_LAST)
+    {
+        return;
+    }
+
+    // LED is active low.
+    if(on)
+    {
+        gpio_output_low((gpio_id_t)led);
+    }
+    else
+    {
+        gpio_output_high((gpio_id_t)led);
+    }
+
+    return;
+}
+
+uint32_t sin_detect_hal_get_time(void)
+{
+    return osKernelGetSysTimerCount();
+}
+
+uint32_t sin_detect_hal_lock(void)
+{
+    uint32_t state = __get_PRIMASK();
+
+    __disable_irq();
+
+    return state;
+}
+
+void sin_detect_hal_unlock(uint32_t state)
+{
+    // Interrupts stay disabled if they were disabled before lock.
+    if(!state)
+    {
+        __enable_irq();
+    }
+
+    return;
+}
+
+bool sin_detect_hal_work_start(sin_detect_hal_work_t *work)
+{
+    work->id = osThreadNew(sin_detect_hal_thread, work, &sin_detect_hal_thread_attr);
+
+    return (work->id != NULL);
+}
+
+void sin_detect_hal_work_signal(sin_detect_hal_work_t *work)
+{
+    osThreadFlagsSet((osThreadId_t)work->id, SIN_DETECT_HAL_FLAG_WORK);
+
+    return;
+}
+
+/**********************************************************************************************************************
+ * Private functions
+ *********************************************************************************************************************/
+static void sin_detect_hal_thread(void *argument)
+{
+    sin_detect_hal_work_t *work = (sin_detect_hal_work_t *)argument;
+
+    while(1)
+    {
+        osThreadFlagsWait(SIN_DETECT_HAL_FLAG_WORK, osFlagsWaitAny, osWaitForever);
+        work->func(work->argument);
+    }
+}
@@ -0,0 +1,447 @@
+/**
+ **********************************************************************************************************************
+ * @file        capture.c
+ * @author      Diamond Sparrow
+ * @version     1.0.0.0
+ * @date        2026-10-16
+ * @brief       Raw sample capture format C source file.
+ **********************************************************************************************************************
+ * @warning     THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR \n
+ *              IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND\n
+ *              FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR\n
+ *              CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL\n
+ *              DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,\n
+ *              DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN\n
+ *              CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF\n
+ *              THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ **********************************************************************************************************************
+ */
+
+/**********************************************************************************************************************
+ * Includes
+ *********************************************************************************************************************/
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+
+#include "capture.h"
+
+/**********************************************************************************************************************
+ * Private definitions and macros
+ *********************************************************************************************************************/
+#define CAPTURE_OFFSET_TYPE     2           //!< Offset of record type.
+#define CAPTURE_OFFSET_LENGTH   3           //!< Offset of payload length.
+#define CAPTURE_OFFSET_PAYLOAD  5           //!< Offset of payload.
+#define CAPTURE_BLOCK_HEAD      6           //!< Samples payload head without timestamps: sequence and count.
+#define CAPTURE_BLOCK_TIME      8           //!< Samples payload head extension with timestamps: time and period.
+#define CAPTURE_CRC_INIT        0xFFFF      //!< CRC-16/CCITT initial value.
+#define CAPTURE_CRC_POLY        0x1021      //!< CRC-16/CCITT polynomial.
+#define CAPTURE_SAMPLE_MASK     ((1UL << CAPTURE_BITS) - 1)     //!< Sample bits mask.
+
+/**********************************************************************************************************************
+ * Private typedef
+ *********************************************************************************************************************/
+
+/**********************************************************************************************************************
+ * Private constants
+ *********************************************************************************************************************/
+
+/**********************************************************************************************************************
+ * Private variables
+ *********************************************************************************************************************/
+
+/**********************************************************************************************************************
+ * Exported variables
+ *********************************************************************************************************************/
+
+/**********************************************************************************************************************
+ * Prototypes of local functions
+ *********************************************************************************************************************/
+/**
+ * @brief   Calculate CRC-16/CCITT, bitwise, record rate is too low for table to pay off in flash.
+ *
+ * @param   data    Pointer to data.
+ * @param   size    Data size in bytes.
+ *
+ * @return  CRC.
+ */
+static uint16_t capture_crc(const uint8_t *data, uint32_t size);
+
+/**
+ * @brief   Write record frame around payload already written to buffer at @ref CAPTURE_OFFSET_PAYLOAD.
+ *
+ * @param   buffer  Pointer to buffer.
+ * @param   type    Record type. See @ref capture_record_t.
+ * @param   length  Payload length in bytes.
+ *
+ * @return  Record size in bytes.
+ */
+static uint32_t capture_frame(uint8_t *buffer, capture_record_t type, uint32_t length);
+
+/**
+ * @brief   Get payload samples head size.
+ *
+ * @param   header  Pointer to header of capture. See @ref capture_header_t.
+ *
+ * @return  Head size in bytes.
+ */
+static uint32_t capture_block_head(const capture_header_t *header);
+
+/**
+ * @brief   Write little endian 16 bit value.
+ *
+ * @param   data    Pointer to data.
+ * @param   value   Value, upper bits are ignored.
+ */
+static void capture_put_16(uint8_t *data, uint32_t value);
+
+/**
+ * @brief   Write little endian 32 bit value.
+ *
+ * @param   data    Pointer to data.
+ * @param   value   Value.
+ */
+static void capture_put_32(uint8_t *data, uint32_t value);
+
+/**
+ * @brief   Read little endian 16 bit value.
+ *
+ * @param   data    Pointer to data.
+ *
+ * @return  Value.
+ */
+static uint32_t capture_get_16(const uint8_t *data);
+
+/**
+ * @brief   Read little endian 32 bit value.
+ *
+ * @param   data    Pointer to data.
+ *
+ * @return  Value.
+ */
+static uint32_t capture_get_32(const uint8_t *data);
+
+/**********************************************************************************************************************
+ * Exported functions
+ *********************************************************************************************************************/
+uint32_t capture_write_header(uint8_t *buffer, uint32_t size, const capture_header_t *header)
+{
+    uint8_t *payload = &buffer[CAPTURE_OFFSET_PAYLOAD];
+    uint32_t i = 0;
+
+    if((size < CAPTURE_HEADER_SIZE) || (header->channels == 0) || (header->channels > CAPTURE_CHANNELS_MAX))
+    {
+        return 0;
+    }
+
+    payload[0] = header->version;
+    payload[1] = header->channels;
+    payload[2] = header->bits;
+    payload[3] = header->flags;
+    capture_put_32(&payload[4], header->rate);
+    capture_put_32(&payload[8], header->clock);
+    memcpy(&payload[12], header->map, CAPTURE_CHANNELS_MAX);
+    for(i = 0; i < 4; i++)
+    {
+        capture_put_32(&payload[20 + (4 * i)], header->board[i]);
+    }
+    memcpy(&payload[36], header->firmware, 4);
+
+    return capture_frame(buffer, CAPTURE_RECORD_HEADER, CAPTURE_HEADER_PAYLOAD);
+}
+
+uint32_t capture_write_samples(uint8_t *buffer, uint32_t size, const capture_header_t *header,
+                               const capture_block_t *block, const uint16_t *samples, uint32_t stride)
+{
+    uint8_t *payload = &buffer[CAPTURE_OFFSET_PAYLOAD];
+    uint8_t *packed = NULL;
+    uint32_t head = capture_block_head(header);
+    uint32_t total = block->count * header->channels;
+    uint32_t value = 0;
+    uint32_t n = 0;
+    uint32_t i = 0;
+    uint32_t k = 0;
+
+    if((total > CAPTURE_SAMPLES_MAX) || (size < (CAPTURE_FRAME_SIZE + head + CAPTURE_PACKED_SIZE(total))))
+    {
+        return 0;
+    }
+
+    capture_put_32(&payload[0], block->sequence);
+    capture_put_16(&payload[4], block->count);
+    if(header->flags & CAPTURE_FLAG_TIMESTAMPS)
+    {
+        capture_put_32(&payload[6], block->time);
+        capture_put_32(&payload[10], block->period);
+    }
+    // Channels are interleaved, even values take low 12 bits of 3 byte pair, odd values high 12 bits.
+    packed = &payload[head];
+    for(i = 0; i < block->count; i++)
+    {
+        for(k = 0; k < header->channels; k++)
+        {
+            value = samples[(k * stride) + i] & CAPTURE_SAMPLE_MASK;
+            if((n & 1) == 0)
+            {
+                packed[0] = (uint8_t)value;
+                packed[1] = (uint8_t)(value >> 8);
+            }
+            else
+            {
+                packed[1] |= (uint8_t)(value << 4);
+                packed[2] = (uint8_t)(value >> 4);
+                packed += 3;
+            }
+            n++;
+        }
+    }
+
+    return capture_frame(buffer, CAPTURE_RECORD_SAMPLES, head + CAPTURE_PACKED_SIZE(total));
+}
+
+uint32_t capture_write_output(uint8_t *buffer, uint32_t size, const capture_output_t *output)
+{
+    uint8_t *payload = &buffer[CAPTURE_OFFSET_PAYLOAD];
+
+    if(size < CAPTURE_OUTPUT_SIZE)
+    {
+        return 0;
+    }
+
+    capture_put_32(&payload[0], output->sequence);
+    payload[4] = output->channel;
+    payload[5] = output->flags;
+    capture_put_16(&payload[6], output->divider);
+    capture_put_32(&payload[8], output->frequency);
+
+    return capture_frame(buffer, CAPTURE_RECORD_OUTPUT, CAPTURE_OUTPUT_PAYLOAD);
+}
+
+void capture_parser_init(capture_parser_t *parser)
+{
+    memset(parser, 0, sizeof(capture_parser_t));
+
+    return;
+}
+
+capture_record_t capture_parse(capture_parser_t *parser, uint8_t byte)
+{
+    uint32_t length = 0;
+    uint32_t type = 0;
+
+    // Hunt for sync, second sync byte may be first one again.
+    if(parser->fill < 2)
+    {
+        if((parser->fill == 0) && (byte == CAPTURE_SYNC_0))
+        {
+            parser->record[parser->fill++] = byte;
+        }
+        else if((parser->fill == 1) && (byte == CAPTURE_SYNC_1))
+        {
+            parser->record[parser->fill++] = byte;
+        }
+        else if(byte == CAPTURE_SYNC_0)
+        {
+            parser->skipped++;
+        }
+        else
+        {
+            parser->skipped += parser->fill + 1;
+            parser->fill = 0;
+        }
+        return CAPTURE_RECORD_NONE;
+    }
+
+    parser->record[parser->fill++] = byte;
+    if(parser->fill == CAPTURE_OFFSET_PAYLOAD)
+    {
+        type = parser->record[CAPTURE_OFFSET_TYPE];
+        length = capture_get_16(&parser->record[CAPTURE_OFFSET_LENGTH]);
+        if((type == CAPTURE_RECORD_NONE) || (type >= CAPTURE_RECORD_LAST) || (length > CAPTURE_PAYLOAD_MAX))
+        {
+            parser->errors++;
+            parser->fill = 0;
+            return CAPTURE_RECORD_NONE;
+        }
+        parser->size = CAPTURE_FRAME_SIZE + length;
+    }
+    if((parser->size == 0) || (parser->fill < parser->size))
+    {
+        return CAPTURE_RECORD_NONE;
+    }
+
+    parser->fill = 0;
+    parser->size = 0;
+    length = capture_get_16(&parser->record[CAPTURE_OFFSET_LENGTH]);
+    if(capture_crc(&parser->record[CAPTURE_OFFSET_TYPE], 3 + length)
+       != capture_get_16(&parser->record[CAPTURE_OFFSET_PAYLOAD + length]))
+    {
+        parser->errors++;
+        return CAPTURE_RECORD_NONE;
+    }
+
+    return (capture_record_t)parser->record[CAPTURE_OFFSET_TYPE];
+}
+
+bool capture_read_header(const capture_parser_t *parser, capture_header_t *header)
+{
+    const uint8_t *payload = &parser->record[CAPTURE_OFFSET_PAYLOAD];
+    uint32_t i = 0;
+
+    if((parser->record[CAPTURE_OFFSET_TYPE] != CAPTURE_RECORD_HEADER)
+       || (capture_get_16(&parser->record[CAPTURE_OFFSET_LENGTH]) < CAPTURE_HEADER_PAYLOAD)
+       || (payload[0] != CAPTURE_VERSION) || (payload[1] == 0) || (payload[1] > CAPTURE_CHANNELS_MAX)
+       || (payload[2] != CAPTURE_BITS))
+    {
+        return false;
+    }
+
+    header->version = payload[0];
+    header->channels = payload[1];
+    header->bits = payload[2];
+    header->flags = payload[3];
+    header->rate = capture_get_32(&payload[4]);
+    header->clock = capture_get_32(&payload[8]);
+    memcpy(header->map, &payload[12], CAPTURE_CHANNELS_MAX);
+    for(i = 0; i < 4; i++)
+    {
+        header->board[i] = capture_get_32(&payload[20 + (4 * i)]);
+    }
+    memcpy(header->firmware, &payload[36], 4);
+
+    return true;
+}
+
+bool capture_read_samples(const capture_parser_t *parser, const capture_header_t *header, capture_block_t *block,
+                          uint16_t *samples, uint32_t stride)
+{
+    const uint8_t *payload = &parser->record[CAPTURE_OFFSET_PAYLOAD];
+    const uint8_t *packed = NULL;
+    uint32_t head = capture_block_head(header);
+    uint32_t total = 0;
+    uint32_t n = 0;
+    uint32_t i = 0;
+    uint32_t k = 0;
+
+    if(parser->record[CAPTURE_OFFSET_TYPE] != CAPTURE_RECORD_SAMPLES)
+    {
+        return false;
+    }
+    block->sequence = capture_get_32(&payload[0]);
+    block->count = capture_get_16(&payload[4]);
+    total = block->count * header->channels;
+    if((block->count > stride) || (total > CAPTURE_SAMPLES_MAX)
+       || (capture_get_16(&parser->record[CAPTURE_OFFSET_LENGTH]) != (head + CAPTURE_PACKED_SIZE(total))))
+    {
+        return false;
+    }
+    block->time = 0;
+    block->period = 0;
+    if(header->flags & CAPTURE_FLAG_TIMESTAMPS)
+    {
+        block->time = capture_get_32(&payload[6]);
+        block->period = capture_get_32(&payload[10]);
+    }
+
+    packed = &payload[head];
+    for(i = 0; i < block->count; i++)
+    {
+        for(k = 0; k < header->channels; k++)
+        {
+            if((n & 1) == 0)
+            {
+                samples[(k * stride) + i] = (uint16_t)(packed[0] | ((packed[1] & 0x0F) << 8));
+            }
+            else
+            {
+                samples[(k * stride) + i] = (uint16_t)((packed[1] >> 4) | (packed[2] << 4));
+                packed += 3;
+            }
+            n++;
+        }
+    }
+
+    return true;
+}
+
+bool capture_read_output(const capture_parser_t *parser, capture_output_t *output)
+{
+    const uint8_t *payload = &parser->record[CAPTURE_OFFSET_PAYLOAD];
+
+    if((parser->record[CAPTURE_OFFSET_TYPE] != CAPTURE_RECORD_OUTPUT)
+       || (capture_get_16(&parser->record[CAPTURE_OFFSET_LENGTH]) < CAPTURE_OUTPUT_PAYLOAD))
+    {
+        return false;
+    }
+
+    output->sequence = capture_get_32(&payload[0]);
+    output->channel = payload[4];
+    output->flags = payload[5];
+    output->divider = (uint16_t)capture_get_16(&payload[6]);
+    output->frequency = capture_get_32(&payload[8]);
+
+    return true;
+}
+
+/**********************************************************************************************************************
+ * Private functions
+ *********************************************************************************************************************/
+static uint16_t capture_crc(const uint8_t *data, uint32_t size)
+{
+    uint32_t crc = CAPTURE_CRC_INIT;
+    uint32_t i = 0;
+    uint32_t j = 0;
+
+    for(i = 0; i < size; i++)
+    {
+        crc ^= (uint32_t)data[i] << 8;
+        for(j = 0; j < 8; j++)
+        {
+            crc = (crc & 0x8000) ? ((crc << 1) ^ CAPTURE_CRC_POLY) : (crc << 1);
+        }
+    }
+
+    return (uint16_t)crc;
+}
+
+static uint32_t capture_frame(uint8_t *buffer, capture_record_t type, uint32_t length)
+{
+    buffer[0] = CAPTURE_SYNC_0;
+    buffer[1] = CAPTURE_SYNC_1;
+    buffer[CAPTURE_OFFSET_TYPE] = (uint8_t)type;
+    capture_put_16(&buffer[CAPTURE_OFFSET_LENGTH], length);
+    capture_put_16(&buffer[CAPTURE_OFFSET_PAYLOAD + length], capture_crc(&buffer[CAPTURE_OFFSET_TYPE], 3 + length));
+
+    return CAPTURE_FRAME_SIZE + length;
+}
+
+static uint32_t capture_block_head(const capture_header_t *header)
+{
+    return (header->flags & CAPTURE_FLAG_TIMESTAMPS) ? (CAPTURE_BLOCK_HEAD + CAPTURE_BLOCK_TIME) : CAPTURE_BLOCK_HEAD;
+}
+
+static void capture_put_16(uint8_t *data, uint32_t value)
+{
+    data[0] = (uint8_t)value;
+    data[1] = (uint8_t)(value >> 8);
+
+    return;
+}
+
+static void capture_put_32(uint8_t *data, uint32_t value)
+{
+    capture_put_16(&data[0], value);
+    capture_put_16(&data[2], value >> 16);
+
+    return;
+}
+
+static uint32_t capture_get_16(const uint8_t *data)
+{
+    return (uint32_t)data[0] | ((uint32_t)data[1] << 8);
+}
+
+static uint32_t capture_get_32(const uint8_t *data)
+{
+    return capture_get_16(&data[0]) | (capture_get_16(&data[2]) << 16);
+}
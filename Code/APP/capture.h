@@ -0,0 +1,245 @@
+/**
+ **********************************************************************************************************************
+ * @file        capture.h
+ * @author      Diamond Sparrow
+ * @version     1.0.0.0
+ * @date        2026-10-16
+ * @brief       Raw sample capture format C header file.
+ **********************************************************************************************************************
+ * @warning     THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR \n
+ *              IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND\n
+ *              FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR\n
+ *              CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL\n
+ *              DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,\n
+ *              DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN\n
+ *              CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF\n
+ *              THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ **********************************************************************************************************************
+ */
+
+#ifndef CAPTURE_H_
+#define CAPTURE_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**********************************************************************************************************************
+ * Includes
+ *********************************************************************************************************************/
+#include <stdint.h>
+#include <stdbool.h>
+
+/**********************************************************************************************************************
+ * Exported definitions and macros
+ *********************************************************************************************************************/
+/*
+ * Capture is a stream of records, so it can share debug UART with text: sync 0xA5 0x5A, type u8, payload length u16,
+ * payload, CRC-16/CCITT of type, length and payload u16. All fields are little endian. Header record comes first and
+ * is repeated, so capture can be joined at any time. Samples are packed two 12 bit values per 3 bytes.
+ */
+#define CAPTURE_SYNC_0              0xA5        //!< First sync byte, never in ASCII text.
+#define CAPTURE_SYNC_1              0x5A        //!< Second sync byte.
+#define CAPTURE_VERSION             1           //!< Format version.
+#define CAPTURE_BITS                12          //!< Sample bits.
+#define CAPTURE_CHANNELS_MAX        8           //!< Max. channels.
+#define CAPTURE_SAMPLES_MAX         512         //!< Max. samples of all channels in one record.
+#define CAPTURE_FLAG_TIMESTAMPS     0x01        //!< Header flag: sample records carry time and period.
+#define CAPTURE_OUTPUT_VALID        0x01        //!< Output flag: frequency is valid.
+#define CAPTURE_OUTPUT_STATE        0x02        //!< Output flag: frequency is in band.
+
+#define CAPTURE_FRAME_SIZE          7           //!< Record size without payload: sync, type, length and CRC.
+#define CAPTURE_HEADER_PAYLOAD      40          //!< Header record payload size.
+#define CAPTURE_OUTPUT_PAYLOAD      12          //!< Output record payload size.
+#define CAPTURE_PAYLOAD_MAX         (14 + CAPTURE_PACKED_SIZE(CAPTURE_SAMPLES_MAX)) //!< Max. payload size.
+#define CAPTURE_RECORD_MAX          (CAPTURE_FRAME_SIZE + CAPTURE_PAYLOAD_MAX)      //!< Max. record size.
+
+/** Packed size of samples in bytes. */
+#define CAPTURE_PACKED_SIZE(COUNT)  ((((COUNT) * 3) + 1) / 2)
+/** Header record size. */
+#define CAPTURE_HEADER_SIZE         (CAPTURE_FRAME_SIZE + CAPTURE_HEADER_PAYLOAD)
+/** Samples record size with timestamps, count is of all channels. */
+#define CAPTURE_SAMPLES_SIZE(COUNT) (CAPTURE_FRAME_SIZE + 14 + CAPTURE_PACKED_SIZE(COUNT))
+/** Output record size. */
+#define CAPTURE_OUTPUT_SIZE         (CAPTURE_FRAME_SIZE + CAPTURE_OUTPUT_PAYLOAD)
+
+/**********************************************************************************************************************
+ * Exported types
+ *********************************************************************************************************************/
+/**
+ * @brief   Capture record types.
+ */
+typedef enum
+{
+    CAPTURE_RECORD_NONE = 0,    //!< No complete record yet.
+    CAPTURE_RECORD_HEADER,      //!< Capture header. See @ref capture_header_t.
+    CAPTURE_RECORD_SAMPLES,     //!< Block of samples. See @ref capture_block_t.
+    CAPTURE_RECORD_OUTPUT,      //!< Detector output after block. See @ref capture_output_t.
+    CAPTURE_RECORD_LAST,        //!< Last should stay last.
+} capture_record_t;
+
+/**
+ * @brief   Capture header, describes samples of following records.
+ */
+typedef struct
+{
+    uint8_t version;                        //!< Format version, @ref CAPTURE_VERSION.
+    uint8_t channels;                       //!< Channels count, samples are interleaved in this order.
+    uint8_t bits;                           //!< Sample bits, @ref CAPTURE_BITS.
+    uint8_t flags;                          //!< Capture flags, CAPTURE_FLAG_*.
+    uint32_t rate;                          //!< Nominal sample rate in mHz.
+    uint32_t clock;                         //!< Timestamp clock in Hz.
+    uint8_t map[CAPTURE_CHANNELS_MAX];      //!< ADC channel number of each channel.
+    uint32_t board[4];                      //!< Board ID, MCU unique ID.
+    uint8_t firmware[4];                    //!< Firmware version.
+} capture_header_t;
+
+/**
+ * @brief   Block of samples.
+ */
+typedef struct
+{
+    uint32_t sequence;      //!< Index of first sample since capture start, gap shows lost records.
+    uint32_t count;         //!< Samples count per channel.
+    uint32_t time;          //!< First sample timestamp, in timestamp clock ticks, only with timestamps.
+    uint32_t period;        //!< Time between samples, in timestamp clock ticks, only with timestamps.
+} capture_block_t;
+
+/**
+ * @brief   Detector output reported by device.
+ */
+typedef struct
+{
+    uint32_t sequence;      //!< Samples processed before output was taken, per channel.
+    uint8_t channel;        //!< Channel index in header.
+    uint8_t flags;          //!< Output flags, CAPTURE_OUTPUT_*.
+    uint16_t divider;       //!< Sample rate divider requested by detector.
+    uint32_t frequency;     //!< Frequency, Q16.16 Hz, 0 if not valid.
+} capture_output_t;
+
+/**
+ * @brief   Capture parser, finds records in byte stream mixed with text.
+ */
+typedef struct
+{
+    uint8_t record[CAPTURE_RECORD_MAX];     //!< Record being received.
+    uint32_t fill;                          //!< Bytes of record received.
+    uint32_t size;                          //!< Record size, 0 - length is not received yet.
+    uint32_t skipped;                       //!< Bytes outside of records.
+    uint32_t errors;                        //!< Records dropped for length or CRC error.
+} capture_parser_t;
+
+/**********************************************************************************************************************
+ * Prototypes of exported constants
+ *********************************************************************************************************************/
+
+/**********************************************************************************************************************
+ * Prototypes of exported variables
+ *********************************************************************************************************************/
+
+/**********************************************************************************************************************
+ * Prototypes of exported functions
+ *********************************************************************************************************************/
+/**
+ * @brief   Write header record.
+ *
+ * @param   buffer  Pointer to buffer.
+ * @param   size    Buffer size in bytes.
+ * @param   header  Pointer to header. See @ref capture_header_t.
+ *
+ * @return  Record size in bytes, 0 - buffer is too small or header is not valid.
+ */
+uint32_t capture_write_header(uint8_t *buffer, uint32_t size, const capture_header_t *header);
+
+/**
+ * @brief   Write samples record.
+ *
+ * @param   buffer  Pointer to buffer.
+ * @param   size    Buffer size in bytes.
+ * @param   header  Pointer to header of capture. See @ref capture_header_t.
+ * @param   block   Pointer to block. See @ref capture_block_t.
+ * @param   samples Pointer to samples, sample i of channel k is samples[k * stride + i].
+ * @param   stride  Distance between channels in samples.
+ *
+ * @return  Record size in bytes, 0 - buffer is too small or block has too many samples.
+ */
+uint32_t capture_write_samples(uint8_t *buffer, uint32_t size, const capture_header_t *header,
+                               const capture_block_t *block, const uint16_t *samples, uint32_t stride);
+
+/**
+ * @brief   Write output record.
+ *
+ * @param   buffer  Pointer to buffer.
+ * @param   size    Buffer size in bytes.
+ * @param   output  Pointer to output. See @ref capture_output_t.
+ *
+ * @return  Record size in bytes, 0 - buffer is too small.
+ */
+uint32_t capture_write_output(uint8_t *buffer, uint32_t size, const capture_output_t *output);
+
+/**
+ * @brief   Initialize capture parser.
+ *
+ * @param   parser  Pointer to parser. See @ref capture_parser_t.
+ */
+void capture_parser_init(capture_parser_t *parser);
+
+/**
+ * @brief   Parse next byte of stream.
+ *
+ * @note    Bytes outside of records are skipped, record with length or CRC error is dropped and search for sync
+ *          restarts after it, so lost byte costs that record and at most the next one. Record stays in parser till
+ *          next byte.
+ *
+ * @param   parser  Pointer to parser. See @ref capture_parser_t.
+ * @param   byte    Byte of stream.
+ *
+ * @return  Type of record completed by byte. See @ref capture_record_t.
+ */
+capture_record_t capture_parse(capture_parser_t *parser, uint8_t byte);
+
+/**
+ * @brief   Read header from last parsed record.
+ *
+ * @param   parser  Pointer to parser. See @ref capture_parser_t.
+ * @param   header  Pointer to header to fill. See @ref capture_header_t.
+ *
+ * @return  State of read.
+ * @retval  0   record is not header of supported version.
+ * @retval  1   success.
+ */
+bool capture_read_header(const capture_parser_t *parser, capture_header_t *header);
+
+/**
+ * @brief   Read samples from last parsed record.
+ *
+ * @param   parser  Pointer to parser. See @ref capture_parser_t.
+ * @param   header  Pointer to header of capture. See @ref capture_header_t.
+ * @param   block   Pointer to block to fill. See @ref capture_block_t.
+ * @param   samples Pointer to samples, sample i of channel k is samples[k * stride + i].
+ * @param   stride  Distance between channels in samples, max. samples per channel.
+ *
+ * @return  State of read.
+ * @retval  0   record is not samples record of header or it does not fit.
+ * @retval  1   success.
+ */
+bool capture_read_samples(const capture_parser_t *parser, const capture_header_t *header, capture_block_t *block,
+                          uint16_t *samples, uint32_t stride);
+
+/**
+ * @brief   Read output from last parsed record.
+ *
+ * @param   parser  Pointer to parser. See @ref capture_parser_t.
+ * @param   output  Pointer to output to fill. See @ref capture_output_t.
+ *
+ * @return  State of read.
+ * @retval  0   record is not output.
+ * @retval  1   success.
+ */
+bool capture_read_output(const capture_parser_t *parser, capture_output_t *output);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* CAPTURE_H_ */
@@ -107,6 +107,30 @@ void debug_send_os(const char *fmt, ...)
     return;
 }
 
+bool debug_send_data_os(uint8_t *data, uint32_t size)
+{
+    uint32_t wait = 0;
+    bool ret = false;
+
+    if (osSemaphoreAcquire(debug_lock_id, DEBUG_LOCK_TIMEOUT) == osOK)
+    {
+        // Ring buffer takes what fits, so wait till all fits, record cut by half is lost anyway.
+        while((uart_0_get_send_rb_free() < size) && (wait < DEBUG_LOCK_TIMEOUT))
+        {
+            osDelay(1);
+            wait++;
+        }
+        if(uart_0_get_send_rb_free() >= size)
+        {
+            uart_0_send_rb_irq(data, size);
+            ret = true;
+        }
+        osSemaphoreRelease(debug_lock_id);
+    }
+
+    return ret;
+}
+
 void debug_send_blocking(uint8_t *data, uint32_t size)
 {
     uart_0_send_blocking(data, size);
@@ -101,6 +101,21 @@ void debug_send(const char *fmt, ...);
  */
 void debug_send_os(const char *fmt, ...);
 
+/**
+ * @brief   Send binary data between debug messages, whole or nothing.
+ *
+ * @note    Waits for room in send ring buffer, so data is never cut in the middle. Use this function when OS
+ *          running. @ref debug_init should be called before.
+ *
+ * @param   data    Pointer to data.
+ * @param   size    Data size in bytes, max. UART 0 send ring buffer size.
+ *
+ * @return  State of send.
+ * @retval  0   data is dropped, lock or room timeout.
+ * @retval  1   data is queued.
+ */
+bool debug_send_data_os(uint8_t *data, uint32_t size);
+
 /**
  * @brief   Send debug massage in blocking mode.
  *
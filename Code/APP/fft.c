@@ -0,0 +1,196 @@
+/**
+ **********************************************************************************************************************
+ * @file        fft.c
+ * @author      Diamond Sparrow
+ * @version     1.0.0.0
+ * @date        2026-10-16
+ * @brief       Fixed point FFT C source file.
+ **********************************************************************************************************************
+ * @warning     THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR \n
+ *              IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND\n
+ *              FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR\n
+ *              CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL\n
+ *              DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,\n
+ *              DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN\n
+ *              CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF\n
+ *              THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ **********************************************************************************************************************
+ */
+
+/**********************************************************************************************************************
+ * Includes
+ *********************************************************************************************************************/
+#include <stdint.h>
+
+#include "fft.h"
+#include "sine.h"
+
+/**********************************************************************************************************************
+ * Private constants
+ *********************************************************************************************************************/
+
+/**********************************************************************************************************************
+ * Private definitions and macros
+ *********************************************************************************************************************/
+
+/**********************************************************************************************************************
+ * Private typedef
+ *********************************************************************************************************************/
+
+/**********************************************************************************************************************
+ * Private variables
+ *********************************************************************************************************************/
+
+/**********************************************************************************************************************
+ * Exported variables
+ *********************************************************************************************************************/
+
+/**********************************************************************************************************************
+ * Prototypes of local functions
+ *********************************************************************************************************************/
+/**
+ * @brief   Reorder complex values in bit reversed order.
+ *
+ * @param   data    Pointer to n complex values, interleaved real and imaginary parts.
+ * @param   n       Values count, power of 2.
+ */
+static void fft_bit_reverse(int16_t *data, uint32_t n);
+
+/**********************************************************************************************************************
+ * Exported functions
+ *********************************************************************************************************************/
+void fft_cfft_q15(int16_t *data, uint32_t n)
+{
+    uint32_t len = 0;
+    uint32_t half = 0;
+    uint32_t step = 0;
+    uint32_t i = 0;
+    uint32_t k = 0;
+    int32_t wr = 0;
+    int32_t wi = 0;
+    int32_t tr = 0;
+    int32_t ti = 0;
+    int32_t ar = 0;
+    int32_t ai = 0;
+    int16_t *a = 0;
+    int16_t *b = 0;
+
+    fft_bit_reverse(data, n);
+
+    for(len = 2; len <= n; len <<= 1)
+    {
+        half = len >> 1;
+        // Twiddle phase step, full turn is 2^32.
+        step = 0x80000000UL / half;
+        for(k = 0; k < half; k++)
+        {
+            // Twiddle exp(-j * 2 * pi * k / len).
+            wr = sine_cos_q15(k * step);
+            wi = -sine_q15(k * step);
+            for(i = k; i < n; i += len)
+            {
+                a = &data[2 * i];
+                b = &data[2 * (i + half)];
+                tr = ((b[0] * wr) - (b[1] * wi)) >> 15;
+                ti = ((b[0] * wi) + (b[1] * wr)) >> 15;
+                ar = a[0];
+                ai = a[1];
+                a[0] = (int16_t)((ar + tr) >> 1);
+                a[1] = (int16_t)((ai + ti) >> 1);
+                b[0] = (int16_t)((ar - tr) >> 1);
+                b[1] = (int16_t)((ai - ti) >> 1);
+            }
+        }
+    }
+
+    return;
+}
+
+void fft_rfft_q15(int16_t *data, uint32_t n)
+{
+    uint32_t half = n >> 1;
+    uint32_t step = 0;
+    uint32_t k = 0;
+    int32_t ar = 0;
+    int32_t ai = 0;
+    int32_t br = 0;
+    int32_t bi = 0;
+    int32_t er = 0;
+    int32_t ei = 0;
+    int32_t or = 0;
+    int32_t oi = 0;
+    int32_t wr = 0;
+    int32_t wi = 0;
+    int32_t tr = 0;
+    int32_t ti = 0;
+
+    // Even and odd samples are real and imaginary parts of half size complex FFT, output is scaled by 2/n.
+    fft_cfft_q15(data, half);
+
+    // Bin 0 and bin n/2 are real.
+    ar = data[0];
+    ai = data[1];
+    data[0] = (int16_t)((ar + ai) >> 1);
+    data[1] = (int16_t)((ar - ai) >> 1);
+
+    // Split the rest, bins k and n/2 - k at once, with extra 1/2 scaling.
+    step = 0x80000000UL / half;
+    for(k = 1; k <= (half >> 1); k++)
+    {
+        ar = data[2 * k];
+        ai = data[(2 * k) + 1];
+        br = data[2 * (half - k)];
+        bi = data[(2 * (half - k)) + 1];
+        // Even part (A + conj(B)) / 4, odd part -j * (A - conj(B)) / 4.
+        er = (ar + br) >> 2;
+        ei = (ai - bi) >> 2;
+        or = (ai + bi) >> 2;
+        oi = (br - ar) >> 2;
+        // Odd part rotated by exp(-j * 2 * pi * k / n).
+        wr = sine_cos_q15(k * step);
+        wi = -sine_q15(k * step);
+        tr = ((or * wr) - (oi * wi)) >> 15;
+        ti = ((or * wi) + (oi * wr)) >> 15;
+        // X[k] = E + T, X[n/2 - k] = conj(E - T).
+        data[2 * k] = (int16_t)(er + tr);
+        data[(2 * k) + 1] = (int16_t)(ei + ti);
+        if(k != (half - k))
+        {
+            data[2 * (half - k)] = (int16_t)(er - tr);
+            data[(2 * (half - k)) + 1] = (int16_t)(ti - ei);
+        }
+    }
+
+    return;
+}
+
+/**********************************************************************************************************************
+ * Private functions
+ *********************************************************************************************************************/
+static void fft_bit_reverse(int16_t *data, uint32_t n)
+{
+    uint32_t i = 0;
+    uint32_t j = 0;
+    uint32_t bit = 0;
+    int16_t tmp = 0;
+
+    for(i = 1; i < n; i++)
+    {
+        for(bit = n >> 1; j & bit; bit >>= 1)
+        {
+            j ^= bit;
+        }
+        j ^= bit;
+        if(i < j)
+        {
+            tmp = data[2 * i];
+            data[2 * i] = data[2 * j];
+            data[2 * j] = tmp;
+            tmp = data[(2 * i) + 1];
+            data[(2 * i) + 1] = data[(2 * j) + 1];
+            data[(2 * j) + 1] = tmp;
+        }
+    }
+
+    return;
+}
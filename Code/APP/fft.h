@@ -0,0 +1,76 @@
+/**
+ **********************************************************************************************************************
+ * @file        fft.h
+ * @author      Diamond Sparrow
+ * @version     1.0.0.0
+ * @date        2026-10-16
+ * @brief       Fixed point FFT C header file.
+ **********************************************************************************************************************
+ * @warning     THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR \n
+ *              IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND\n
+ *              FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR\n
+ *              CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL\n
+ *              DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,\n
+ *              DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN\n
+ *              CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF\n
+ *              THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ **********************************************************************************************************************
+ */
+
+#ifndef FFT_H_
+#define FFT_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**********************************************************************************************************************
+ * Includes
+ *********************************************************************************************************************/
+#include <stdint.h>
+
+/**********************************************************************************************************************
+ * Exported constants
+ *********************************************************************************************************************/
+
+/**********************************************************************************************************************
+ * Exported definitions and macros
+ *********************************************************************************************************************/
+
+/**********************************************************************************************************************
+ * Exported types
+ *********************************************************************************************************************/
+
+/**********************************************************************************************************************
+ * Prototypes of exported variables
+ *********************************************************************************************************************/
+
+/**********************************************************************************************************************
+ * Prototypes of exported functions
+ *********************************************************************************************************************/
+/**
+ * @brief   In place complex radix-2 FFT in Q15.
+ *
+ * @note    Every stage is scaled by 1/2, so output is scaled by 1/n and can not overflow.
+ *
+ * @param   data    Pointer to n complex values, interleaved real and imaginary parts.
+ * @param   n       FFT size, power of 2.
+ */
+void fft_cfft_q15(int16_t *data, uint32_t n);
+
+/**
+ * @brief   In place real FFT in Q15.
+ *
+ * @note    Output is scaled by 1/n, as in CMSIS arm_rfft_q15. Bins [0:n/2-1] are stored as interleaved real and
+ *          imaginary parts, bin 0 is real, so its imaginary part holds real bin n/2.
+ *
+ * @param   data    Pointer to n real values.
+ * @param   n       FFT size, power of 2, at least 4.
+ */
+void fft_rfft_q15(int16_t *data, uint32_t n);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* FFT_H_ */
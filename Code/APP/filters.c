@@ -55,11 +55,16 @@
 /**********************************************************************************************************************
  * Private functions
  *********************************************************************************************************************/
-double filters_low_pass(filters_low_pass_t *data, double input, double cut_off)
+int32_t filters_low_pass(filters_low_pass_t *data, int32_t input, uint32_t cut_off)
 {
+    int32_t delta = 0;
+
     data->input = input;
     data->cut_off = cut_off;
-    data->output = data->output + (data->cut_off * (data->input - data->output));
+    // Multiply is split by high and low half of delta, so it fits 32 bits and is still exact.
+    delta = data->input - data->output;
+    data->output += (delta >> FILTERS_CUT_OFF_BITS) * (int32_t)data->cut_off;
+    data->output += (int32_t)((((uint32_t)delta & (FILTERS_CUT_OFF_ONE - 1)) * data->cut_off) >> FILTERS_CUT_OFF_BITS);
 
     return data->output;
 }
@@ -35,6 +35,8 @@ extern "C" {
 /**********************************************************************************************************************
  * Exported definitions and macros
  *********************************************************************************************************************/
+#define FILTERS_CUT_OFF_BITS    16                              //!< Fractional bits of filter cut off.
+#define FILTERS_CUT_OFF_ONE     (1UL << FILTERS_CUT_OFF_BITS)   //!< Filter cut off of one, output follows input.
 
 /**********************************************************************************************************************
  * Exported types
@@ -44,9 +46,9 @@ extern "C" {
  */
 typedef struct
 {
-    double input;   //!< Input value.
-    double output;  //!< Output value.
-    double cut_off; //!< Filter cut off.
+    int32_t input;      //!< Input value.
+    int32_t output;     //!< Output value.
+    uint32_t cut_off;   //!< Filter cut off, @ref FILTERS_CUT_OFF_BITS fractional bits.
 } filters_low_pass_t;
 
 /**********************************************************************************************************************
@@ -59,13 +61,15 @@ typedef struct
 /**
  * @brief   Low pass filter.
  *
+ * @note    Integer only, output is rounded down and follows input with any fixed point format.
+ *
  * @param   data    Pointer to low pass filter data. See @ref filters_low_pass_t.
  * @param   input   Input data for low pass filter.
- * @param   cut_off Cut off value.
+ * @param   cut_off Cut off value, up to @ref FILTERS_CUT_OFF_ONE.
  *
  * @return  Output value of low pass filter.
  */
-double filters_low_pass(filters_low_pass_t *data, double input, double cut_off);
+int32_t filters_low_pass(filters_low_pass_t *data, int32_t input, uint32_t cut_off);
 
 #ifdef __cplusplus
 }
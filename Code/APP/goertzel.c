@@ -0,0 +1,239 @@
+/**
+ **********************************************************************************************************************
+ * @file        goertzel.c
+ * @author      Diamond Sparrow
+ * @version     1.0.0.0
+ * @date        2026-10-16
+ * @brief       Goertzel filter bank C source file.
+ **********************************************************************************************************************
+ * @warning     THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR \n
+ *              IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND\n
+ *              FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR\n
+ *              CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL\n
+ *              DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,\n
+ *              DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN\n
+ *              CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF\n
+ *              THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ **********************************************************************************************************************
+ */
+
+
+/**********************************************************************************************************************
+ * Includes
+ *********************************************************************************************************************/
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include <math.h>
+
+#include "goertzel.h"
+
+/**********************************************************************************************************************
+ * Private constants
+ *********************************************************************************************************************/
+
+/**********************************************************************************************************************
+ * Private definitions and macros
+ *********************************************************************************************************************/
+#define GOERTZEL_COEFF_MASK     ((1L << GOERTZEL_COEFF_BITS) - 1)   //!< Mask of coefficient fractional bits.
+
+/**********************************************************************************************************************
+ * Private typedef
+ *********************************************************************************************************************/
+
+/**********************************************************************************************************************
+ * Private variables
+ *********************************************************************************************************************/
+
+/**********************************************************************************************************************
+ * Exported variables
+ *********************************************************************************************************************/
+
+/**********************************************************************************************************************
+ * Prototypes of local functions
+ *********************************************************************************************************************/
+/**
+ * @brief   Multiply filter state by bin coefficient.
+ *
+ * @note    Product is split in two 32-bit multiplications, so no 64-bit math is needed on Cortex-M0+.
+ *
+ * @param   coeff   Bin coefficient, @ref GOERTZEL_COEFF_BITS fractional bits.
+ * @param   s       Filter state.
+ *
+ * @return  (coeff * s) >> @ref GOERTZEL_COEFF_BITS.
+ */
+static inline int32_t goertzel_mul(int32_t coeff, int32_t s);
+
+/**
+ * @brief   Integer square root.
+ *
+ * @param   value   Value.
+ *
+ * @return  Square root of value rounded down.
+ */
+static uint32_t goertzel_sqrt(uint32_t value);
+
+/**********************************************************************************************************************
+ * Exported functions
+ *********************************************************************************************************************/
+bool goertzel_init(goertzel_t *data, float rate, float freq_low, float freq_high, uint32_t bins, uint32_t block)
+{
+    uint32_t i = 0;
+
+    // Bin main lobes must overlap, frequency between bins would be lost otherwise.
+    if(bins < 2 || bins > GOERTZEL_BINS_MAX || block == 0 || freq_high <= freq_low || (2.0F * freq_high) >= rate
+       || ((freq_high - freq_low) / (float)(bins - 1)) > (rate / (float)block))
+    {
+        return false;
+    }
+
+    memset(data, 0, sizeof(goertzel_t));
+    data->bins = bins;
+    data->block = block;
+    data->freq_low = (uint32_t)(freq_low * 65536.0F);
+    data->freq_step = (uint32_t)(((freq_high - freq_low) / (float)(bins - 1)) * 65536.0F);
+
+    for(i = 0; i < bins; i++)
+    {
+        data->coeff[i] = (int32_t)(2.0F * cosf(2.0F * 3.14159265F * (freq_low + ((freq_high - freq_low) * i)
+                                                                      / (float)(bins - 1)) / rate)
+                         * (1L << GOERTZEL_COEFF_BITS));
+    }
+
+    return true;
+}
+
+bool goertzel_process(goertzel_t *data, uint32_t sample)
+{
+    uint32_t i = 0;
+    int32_t x = 0;
+    int32_t s = 0;
+    int64_t s1 = 0;
+    int64_t s2 = 0;
+
+    // Remove DC, otherwise its leakage would swamp lowest bins.
+    x = (int32_t)sample - data->offset;
+    data->sum += sample;
+
+    for(i = 0; i < data->bins; i++)
+    {
+        s = x + goertzel_mul(data->coeff[i], data->s1[i]) - data->s2[i];
+        data->s2[i] = data->s1[i];
+        data->s1[i] = s;
+    }
+
+    if(++data->n < data->block)
+    {
+        return false;
+    }
+
+    // Block is finished, calculate bins power and restart filters.
+    for(i = 0; i < data->bins; i++)
+    {
+        s1 = data->s1[i];
+        s2 = data->s2[i];
+        data->power[i] = (uint64_t)((s1 * s1) + (s2 * s2) - (((data->coeff[i] * s1) >> GOERTZEL_COEFF_BITS) * s2));
+        data->s1[i] = 0;
+        data->s2[i] = 0;
+    }
+    data->offset = (int32_t)(data->sum / data->block);
+    data->sum = 0;
+    data->n = 0;
+
+    return true;
+}
+
+uint32_t goertzel_peak(goertzel_t *data, uint32_t snr, uint32_t amplitude)
+{
+    uint32_t i = 0;
+    uint32_t peak = 0;
+    uint32_t scale = 0;
+    uint64_t total = 0;
+    uint64_t floor = 0;
+    uint32_t center = 0;
+    uint32_t left = 0;
+    uint32_t right = 0;
+    int32_t shift = 0;
+
+    for(i = 0; i < data->bins; i++)
+    {
+        total += data->power[i];
+        if(data->power[i] > data->power[peak])
+        {
+            peak = i;
+        }
+    }
+
+    // Sine of peak to peak amplitude A has power (A * block / 4)^2 in its bin, tone half way between bins still
+    // has sinc(0.5)^2 = 0.405 (13 / 32) of it, weaker tone is no tone however clean it is.
+    floor = (uint64_t)((amplitude * data->block) / 4);
+    floor = ((floor * floor) * 13) / 32;
+
+    // Compare peak with mean power of bins, no tone - no frequency.
+    if(data->power[peak] == 0 || data->power[peak] < floor || (data->power[peak] * data->bins) < (total * snr))
+    {
+        return 0;
+    }
+
+    // Block is not windowed, so bin response is sinc: tone delta of bin from peak towards stronger neighbour gives
+    // |X[neighbour]| / |X[peak]| = delta / (1 - delta), delta = |X[neighbour]| / (|X[peak]| + |X[neighbour]|).
+    // Power is scaled down to 30 bits by even shift, so magnitudes keep the same scale, shift is in 1/256 of bin.
+    while((data->power[peak] >> scale) >= (1UL << 30))
+    {
+        scale += 2;
+    }
+    center = goertzel_sqrt((uint32_t)(data->power[peak] >> scale));
+    if(peak > 0)
+    {
+        left = goertzel_sqrt((uint32_t)(data->power[peak - 1] >> scale));
+    }
+    if(peak < (data->bins - 1))
+    {
+        right = goertzel_sqrt((uint32_t)(data->power[peak + 1] >> scale));
+    }
+    if(right >= left && right > 0)
+    {
+        shift = (int32_t)((256 * right) / (center + right));
+    }
+    else if(left > right)
+    {
+        shift = -(int32_t)((256 * left) / (center + left));
+    }
+
+    return data->freq_low + (data->freq_step * peak) + (uint32_t)(((int32_t)data->freq_step * shift) / 256);
+}
+
+/**********************************************************************************************************************
+ * Private functions
+ *********************************************************************************************************************/
+static inline int32_t goertzel_mul(int32_t coeff, int32_t s)
+{
+    return (coeff * (s >> GOERTZEL_COEFF_BITS)) + ((coeff * (s & GOERTZEL_COEFF_MASK)) >> GOERTZEL_COEFF_BITS);
+}
+
+static uint32_t goertzel_sqrt(uint32_t value)
+{
+    uint32_t root = 0;
+    uint32_t bit = 1UL << 30;
+
+    // Digit by digit, one result bit per step.
+    while(bit > value)
+    {
+        bit >>= 2;
+    }
+    while(bit != 0)
+    {
+        if(value >= (root + bit))
+        {
+            value -= root + bit;
+            root = (root >> 1) + bit;
+        }
+        else
+        {
+            root >>= 1;
+        }
+        bit >>= 2;
+    }
+
+    return root;
+}
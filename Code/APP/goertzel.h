@@ -0,0 +1,119 @@
+/**
+ **********************************************************************************************************************
+ * @file        goertzel.h
+ * @author      Diamond Sparrow
+ * @version     1.0.0.0
+ * @date        2026-10-16
+ * @brief       Goertzel filter bank C header file.
+ **********************************************************************************************************************
+ * @warning     THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR \n
+ *              IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND\n
+ *              FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR\n
+ *              CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL\n
+ *              DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,\n
+ *              DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN\n
+ *              CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF\n
+ *              THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ **********************************************************************************************************************
+ */
+
+#ifndef GOERTZEL_H_
+#define GOERTZEL_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**********************************************************************************************************************
+ * Includes
+ *********************************************************************************************************************/
+#include <stdint.h>
+#include <stdbool.h>
+
+/**********************************************************************************************************************
+ * Exported constants
+ *********************************************************************************************************************/
+
+/**********************************************************************************************************************
+ * Exported definitions and macros
+ *********************************************************************************************************************/
+#define GOERTZEL_BINS_MAX       16  //!< Maximum bins count in filter bank.
+#define GOERTZEL_COEFF_BITS     14  //!< Fractional bits of bin coefficients.
+
+/**********************************************************************************************************************
+ * Exported types
+ *********************************************************************************************************************/
+/**
+ * @brief   Goertzel filter bank data.
+ */
+typedef struct
+{
+    uint32_t bins;                      //!< Bins count.
+    uint32_t block;                     //!< Block size in samples.
+    uint32_t n;                         //!< Samples processed in current block.
+    uint32_t sum;                       //!< Samples sum in current block.
+    int32_t offset;                     //!< DC offset removed from samples, mean of last block.
+    uint32_t freq_low;                  //!< Frequency of first bin in Hz, Q16.16.
+    uint32_t freq_step;                 //!< Frequency step between bins in Hz, Q16.16.
+    int32_t coeff[GOERTZEL_BINS_MAX];   //!< Bin coefficients 2 * cos(w), @ref GOERTZEL_COEFF_BITS fractional bits.
+    int32_t s1[GOERTZEL_BINS_MAX];      //!< Bin filter state s[n - 1].
+    int32_t s2[GOERTZEL_BINS_MAX];      //!< Bin filter state s[n - 2].
+    uint64_t power[GOERTZEL_BINS_MAX];  //!< Bin power of last block.
+} goertzel_t;
+
+/**********************************************************************************************************************
+ * Prototypes of exported variables
+ *********************************************************************************************************************/
+
+/**********************************************************************************************************************
+ * Prototypes of exported functions
+ *********************************************************************************************************************/
+/**
+ * @brief   Initialize Goertzel filter bank with bins evenly spaced from low to high frequency.
+ *
+ * @note    Uses floating point math, do not call it from interrupt. Bin width is rate / block, it must not be
+ *          narrower than step between bins, so every frequency from low to high falls in a bin main lobe.
+ *
+ * @param   data        Pointer to Goertzel filter bank data. See @ref goertzel_t.
+ * @param   rate        Sample rate in Hz.
+ * @param   freq_low    Frequency of first bin in Hz.
+ * @param   freq_high   Frequency of last bin in Hz.
+ * @param   bins        Bins count, up to @ref GOERTZEL_BINS_MAX.
+ * @param   block       Block size in samples.
+ *
+ * @return  State of initialization.
+ * @retval  0   failed.
+ * @retval  1   success.
+ */
+bool goertzel_init(goertzel_t *data, float rate, float freq_low, float freq_high, uint32_t bins, uint32_t block);
+
+/**
+ * @brief   Process one sample by Goertzel filter bank.
+ *
+ * @param   data    Pointer to Goertzel filter bank data. See @ref goertzel_t.
+ * @param   sample  ADC sample.
+ *
+ * @return  State of block.
+ * @retval  0   block is not finished yet.
+ * @retval  1   block is finished, bin power is updated.
+ */
+bool goertzel_process(goertzel_t *data, uint32_t sample);
+
+/**
+ * @brief   Find frequency of strongest bin of last block.
+ *
+ * @note    Frequency is refined by ratio of peak and stronger neighbour bin magnitudes.
+ *
+ * @param   data        Pointer to Goertzel filter bank data. See @ref goertzel_t.
+ * @param   snr         Minimal ratio of peak bin power to mean bin power.
+ * @param   amplitude   Minimal peak to peak amplitude of tone in ADC counts, sets absolute power floor of peak.
+ *
+ * @return  Peak frequency in Hz, Q16.16, 0 if peak is below snr or power floor.
+ */
+uint32_t goertzel_peak(goertzel_t *data, uint32_t snr, uint32_t amplitude);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* GOERTZEL_H_ */
@@ -0,0 +1,172 @@
+/**
+ **********************************************************************************************************************
+ * @file        pll.c
+ * @author      Diamond Sparrow
+ * @version     1.0.0.0
+ * @date        2026-10-16
+ * @brief       Digital phase locked loop C source file.
+ **********************************************************************************************************************
+ * @warning     THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR \n
+ *              IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND\n
+ *              FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR\n
+ *              CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL\n
+ *              DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,\n
+ *              DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN\n
+ *              CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF\n
+ *              THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ **********************************************************************************************************************
+ */
+
+/**********************************************************************************************************************
+ * Includes
+ *********************************************************************************************************************/
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+
+#include "pll.h"
+#include "sine.h"
+
+/**********************************************************************************************************************
+ * Private constants
+ *********************************************************************************************************************/
+
+/**********************************************************************************************************************
+ * Private definitions and macros
+ *********************************************************************************************************************/
+#define PLL_PHASE_TURN          4294967296.0F   //!< Full turn in phase units.
+#define PLL_DETECTOR_GAIN       20861.0F        //!< Limiting phase detector gain, 2 / pi in Q15 per radian.
+#define PLL_DAMPING             0.707F          //!< Loop damping factor.
+#define PLL_ACQUIRE_WIDER       4.0F            //!< Loop bandwidth multiplier while not locked.
+#define PLL_OFFSET_SHIFT        10              //!< DC offset averaging over 2^n samples.
+#define PLL_LOCK_SHIFT          7               //!< Lock detector averaging over 2^n samples.
+#define PLL_LOCK_ON             12000           //!< Lock detector level to lock, of 20861 at perfect lock.
+#define PLL_LOCK_OFF            8000            //!< Lock detector level to lose lock.
+#define PLL_PRESET_SHIFT        3               //!< NCO is preset if period differs more than 1/2^n of NCO.
+
+/**********************************************************************************************************************
+ * Private typedef
+ *********************************************************************************************************************/
+
+/**********************************************************************************************************************
+ * Private variables
+ *********************************************************************************************************************/
+
+/**********************************************************************************************************************
+ * Exported variables
+ *********************************************************************************************************************/
+
+/**********************************************************************************************************************
+ * Prototypes of local functions
+ *********************************************************************************************************************/
+
+/**********************************************************************************************************************
+ * Exported functions
+ *********************************************************************************************************************/
+bool pll_init(pll_t *data, float rate, float freq_min, float freq_max, float bandwidth)
+{
+    float gain = 0;
+    float wn = 0;
+
+    if(freq_min <= 0 || freq_max <= freq_min || (2.0F * freq_max) >= rate || bandwidth <= 0)
+    {
+        return false;
+    }
+
+    memset(data, 0, sizeof(pll_t));
+    data->rate = (uint32_t)(rate * 65536.0F);
+    data->step_min = (int32_t)(freq_min * PLL_PHASE_TURN / rate);
+    data->step_max = (int32_t)(freq_max * PLL_PHASE_TURN / rate);
+    data->step = (data->step_min / 2) + (data->step_max / 2);
+    data->integrator = (int64_t)data->step << 8;
+
+    // Linear model: phase detector gives PLL_DETECTOR_GAIN per radian, NCO turns 2^32 / (2 * pi) per radian.
+    gain = PLL_DETECTOR_GAIN * 6.2831853F / PLL_PHASE_TURN;
+    wn = 6.2831853F * bandwidth / rate;
+    data->kp_track = (int32_t)(2.0F * PLL_DAMPING * wn / gain);
+    data->ki_track = (int32_t)(wn * wn * 256.0F / gain);
+    wn *= PLL_ACQUIRE_WIDER;
+    data->kp_acquire = (int32_t)(2.0F * PLL_DAMPING * wn / gain);
+    data->ki_acquire = (int32_t)(wn * wn * 256.0F / gain);
+
+    return true;
+}
+
+bool pll_process(pll_t *data, uint32_t sample)
+{
+    int32_t x = 0;
+    int32_t error = 0;
+    int32_t kp = 0;
+    int32_t ki = 0;
+    int32_t step = 0;
+
+    // Remove DC, only sign of signal is used, so loop gain does not depend on amplitude.
+    x = ((int32_t)sample << PLL_OFFSET_SHIFT) - data->offset;
+    data->offset += x >> PLL_OFFSET_SHIFT;
+
+    // Phase detector: NCO lagging signal gives positive error. Lock detector: in-phase product.
+    if(x >= 0)
+    {
+        error = sine_cos_q15(data->phase);
+        data->lock += sine_q15(data->phase) - (data->lock >> PLL_LOCK_SHIFT);
+    }
+    else
+    {
+        error = -sine_cos_q15(data->phase);
+        data->lock += -sine_q15(data->phase) - (data->lock >> PLL_LOCK_SHIFT);
+    }
+
+    // Lock detector with hysteresis.
+    if(data->locked)
+    {
+        data->locked = (data->lock >> PLL_LOCK_SHIFT) > PLL_LOCK_OFF;
+    }
+    else
+    {
+        data->locked = (data->lock >> PLL_LOCK_SHIFT) > PLL_LOCK_ON;
+    }
+
+    // Frequency aided acquisition: when not locked, preset NCO from signal period if it is far off.
+    data->period++;
+    if(x >= 0 && !data->positive)
+    {
+        step = (int32_t)(0xFFFFFFFFUL / data->period);
+        if(!data->locked && step >= data->step_min && step <= data->step_max
+           && ((step > (data->step + (data->step >> PLL_PRESET_SHIFT)))
+               || (step < (data->step - (data->step >> PLL_PRESET_SHIFT)))))
+        {
+            data->integrator = (int64_t)step << 8;
+        }
+        data->period = 0;
+    }
+    data->positive = (x >= 0);
+
+    // Proportional-integral loop filter, narrow when locked, wide while acquiring.
+    kp = data->locked ? data->kp_track : data->kp_acquire;
+    ki = data->locked ? data->ki_track : data->ki_acquire;
+    data->integrator += ki * error;
+    if(data->integrator < ((int64_t)data->step_min << 8))
+    {
+        data->integrator = (int64_t)data->step_min << 8;
+    }
+    else if(data->integrator > ((int64_t)data->step_max << 8))
+    {
+        data->integrator = (int64_t)data->step_max << 8;
+    }
+    data->step = (int32_t)(data->integrator >> 8) + (kp * error);
+
+    // Numerically controlled oscillator.
+    data->phase += (uint32_t)data->step;
+
+    return data->locked;
+}
+
+uint32_t pll_frequency(pll_t *data)
+{
+    // Integrator holds frequency without phase detector ripple, phase step is frequency in 1 / 2^32 of rate.
+    return (uint32_t)(((uint64_t)(data->integrator >> 8) * data->rate) >> 32);
+}
+
+/**********************************************************************************************************************
+ * Private functions
+ *********************************************************************************************************************/
@@ -0,0 +1,117 @@
+/**
+ **********************************************************************************************************************
+ * @file        pll.h
+ * @author      Diamond Sparrow
+ * @version     1.0.0.0
+ * @date        2026-10-16
+ * @brief       Digital phase locked loop C header file.
+ **********************************************************************************************************************
+ * @warning     THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR \n
+ *              IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND\n
+ *              FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR\n
+ *              CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL\n
+ *              DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,\n
+ *              DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN\n
+ *              CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF\n
+ *              THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ **********************************************************************************************************************
+ */
+
+#ifndef PLL_H_
+#define PLL_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**********************************************************************************************************************
+ * Includes
+ *********************************************************************************************************************/
+#include <stdint.h>
+#include <stdbool.h>
+
+/**********************************************************************************************************************
+ * Exported constants
+ *********************************************************************************************************************/
+
+/**********************************************************************************************************************
+ * Exported definitions and macros
+ *********************************************************************************************************************/
+
+/**********************************************************************************************************************
+ * Exported types
+ *********************************************************************************************************************/
+/**
+ * @brief   Digital phase locked loop data.
+ */
+typedef struct
+{
+    uint32_t rate;          //!< Sample rate in Hz, Q16.16.
+    uint32_t phase;         //!< NCO phase, full turn is 2^32.
+    int32_t step;           //!< NCO phase step per sample.
+    int64_t integrator;     //!< Loop filter integrator, phase step of frequency estimate with 8 fractional bits.
+    int32_t step_min;       //!< Minimal NCO phase step.
+    int32_t step_max;       //!< Maximal NCO phase step.
+    int32_t kp_track;       //!< Loop filter proportional gain when locked.
+    int32_t ki_track;       //!< Loop filter integral gain when locked, 8 fractional bits.
+    int32_t kp_acquire;     //!< Loop filter proportional gain when not locked.
+    int32_t ki_acquire;     //!< Loop filter integral gain when not locked, 8 fractional bits.
+    int32_t offset;         //!< DC offset accumulator.
+    bool positive;          //!< Flag that shows if last sample was above DC offset.
+    uint32_t period;        //!< Samples since last rising edge, for frequency aided acquisition.
+    int32_t lock;           //!< Lock detector accumulator.
+    bool locked;            //!< Flag that shows if loop is locked.
+} pll_t;
+
+/**********************************************************************************************************************
+ * Prototypes of exported variables
+ *********************************************************************************************************************/
+
+/**********************************************************************************************************************
+ * Prototypes of exported functions
+ *********************************************************************************************************************/
+/**
+ * @brief   Initialize digital phase locked loop.
+ *
+ * @note    Uses floating point math to calculate loop gains, do not call it from interrupt.
+ *          Loop is critically damped, while not locked bandwidth is 4 times wider and NCO is preset from measured
+ *          signal period for faster acquisition.
+ *
+ * @param   data        Pointer to phase locked loop data. See @ref pll_t.
+ * @param   rate        Sample rate in Hz.
+ * @param   freq_min    Lowest tracked frequency in Hz, loop starts in the middle of the range.
+ * @param   freq_max    Highest tracked frequency in Hz.
+ * @param   bandwidth   Loop natural frequency in Hz when locked.
+ *
+ * @return  State of initialization.
+ * @retval  0   failed.
+ * @retval  1   success.
+ */
+bool pll_init(pll_t *data, float rate, float freq_min, float freq_max, float bandwidth);
+
+/**
+ * @brief   Process one sample by phase locked loop.
+ *
+ * @param   data    Pointer to phase locked loop data. See @ref pll_t.
+ * @param   sample  ADC sample.
+ *
+ * @return  Lock state.
+ * @retval  0   loop is not locked.
+ * @retval  1   loop is locked.
+ */
+bool pll_process(pll_t *data, uint32_t sample);
+
+/**
+ * @brief   Get frequency tracked by phase locked loop.
+ *
+ * @param   data    Pointer to phase locked loop data. See @ref pll_t.
+ *
+ * @return  Frequency in Hz, Q16.16.
+ */
+uint32_t pll_frequency(pll_t *data);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* PLL_H_ */
@@ -24,41 +24,67 @@
 #include <stdbool.h>
 #include <string.h>
 
-#include "bsp/periph/adc.h"
-#include "bsp/periph/gpio.h"
-#include "bsp/periph/timers.h"
-
 #include "debug.h"
 #include "sin_detect.h"
-#include "filters.h"
+#include "sin_detect_hal.h"
+#include "sine.h"
 
 /**********************************************************************************************************************
  * Private definitions and macros
  *********************************************************************************************************************/
-#define SIN_DETECT_CYCLES       32                      //!< Cycles count after witch is reached will calculate frequency.
-#define SIN_DETECT_LP_CUTOFF    0.5F                    //!< Sin detection low pass filter cutoff.
-#define SIN_DETECT_ZERO         (ADC_RESOLUTION / 2)    //!< Zero level.
-#define SIN_DETECT_FREQ_LOW     100.0F                  //!< Sin detection low frequency in Hz.
-#define SIN_DETECT_FREQ_HIGH    300.0F                  //!< Sin detection low frequency in Hz.
-#define SIN_DETECT_FREQ_HYS     2.0F                    //!< Sin detection hysteresis level
+#define SIN_DETECT_CYCLES       4                       //!< Cycles count after witch is reached will calculate frequency.
+#define SIN_DETECT_LP_CUTOFF    ((uint32_t)(0.75F * FILTERS_CUT_OFF_ONE))  //!< Sin detection low pass filter cutoff.
+#define SIN_DETECT_ZERO         2048UL                  //!< Zero level, middle of 12-bit ADC range.
+#define SIN_DETECT_ZERO_FIXED   0                       //!< Zero level mode: fixed at @ref SIN_DETECT_ZERO.
+#define SIN_DETECT_ZERO_MINMAX  1                       //!< Zero level mode: middle of signal minimum and maximum.
+#define SIN_DETECT_ZERO_MEAN    2                       //!< Zero level mode: signal mean.
+#define SIN_DETECT_ZERO_MODE    SIN_DETECT_ZERO_MINMAX  //!< Zero level tracking mode.
+#define SIN_DETECT_ZERO_WINDOW  0.002F                  //!< Min. zero level tracking window in seconds.
+#define SIN_DETECT_ZERO_TIMEOUT 0.05F                   //!< Max. zero level tracking window in seconds.
+#define SIN_DETECT_FRAC_BITS    8                       //!< Fractional bits of time counter (sub-sample resolution).
+#define SIN_DETECT_FRAC_ONE     (1UL << SIN_DETECT_FRAC_BITS)       //!< One sample period in time counter units.
+#define SIN_DETECT_PERIOD_MAX   (1UL << 24)             //!< Accumulated period limit of integer reciprocal.
+#define SIN_DETECT_NOISE_SHIFT  6                       //!< Noise estimate averaging over 2^n samples.
+#define SIN_DETECT_NOISE_FIT    6                       //!< Sample period change of 2^-n fits noise predictor again.
+#define SIN_DETECT_COS_ONE      32768L                  //!< One in Q15 of noise predictor cosine.
+#define SIN_DETECT_HYS_MIN      2                       //!< Minimal zero crossing hysteresis in ADC counts.
+#define SIN_DETECT_TIMEOUT      4                       //!< Signal loss timeout in periods of band low frequency.
+#define SIN_DETECT_AMPLITUDE_MIN    50                  //!< Minimal signal peak to peak amplitude in ADC counts.
+#define SIN_DETECT_SAMPLES      12                      //!< Target samples per signal period of adaptive rate.
+#define SIN_DETECT_SAMPLES_MIN  4                       //!< Min. samples per period of band high frequency.
+#define SIN_DETECT_DIVIDER_MAX  8                       //!< Max. sample rate divider.
+#define SIN_DETECT_GOERTZEL_BINS        16          //!< Goertzel engine bins count.
+#define SIN_DETECT_GOERTZEL_FREQ_LOW    50.0F       //!< Goertzel engine first bin frequency in Hz.
+#define SIN_DETECT_GOERTZEL_FREQ_HIGH   400.0F      //!< Goertzel engine last bin frequency in Hz.
+#define SIN_DETECT_GOERTZEL_SNR         4           //!< Goertzel engine minimal peak to mean bin power ratio.
+#define SIN_DETECT_FFT_FREQ_LOW         20.0F       //!< FFT engine lowest frequency in Hz.
+#define SIN_DETECT_FFT_SNR              12          //!< FFT engine minimal peak to mean bin power ratio.
+#define SIN_DETECT_PLL_FREQ_MIN         20.0F       //!< PLL engine lowest tracked frequency in Hz.
+#define SIN_DETECT_PLL_FREQ_MAX         600.0F      //!< PLL engine highest tracked frequency in Hz.
+#define SIN_DETECT_PLL_BANDWIDTH        5.0F        //!< PLL engine loop bandwidth in Hz when locked.
+#define SIN_DETECT_YIN_FREQ_LOW         50          //!< YIN engine lowest frequency in Hz.
+#define SIN_DETECT_YIN_FREQ_HIGH        500.0F      //!< YIN engine highest frequency in Hz.
+#define SIN_DETECT_YIN_WINDOW           256         //!< YIN engine integration window in samples (51.2 ms).
+#define SIN_DETECT_YIN_HOP              64          //!< YIN engine samples between estimates (12.8 ms).
+#define SIN_DETECT_YIN_CONFIDENCE       0.5F        //!< YIN engine minimal confidence of periodic signal.
+#define SIN_DETECT_FREQ_LOW     (100UL * SIN_DETECT_FREQ_ONE)   //!< Sin detection low frequency.
+#define SIN_DETECT_FREQ_HIGH    (300UL * SIN_DETECT_FREQ_ONE)   //!< Sin detection low frequency.
+#define SIN_DETECT_FREQ_HYS     (2UL * SIN_DETECT_FREQ_ONE)     //!< Sin detection hysteresis level
+#define SIN_DETECT_LED          2                       //!< Sin detection band LED, GPIO_ID_LED_BLUE on board.
+
+#if (SIN_DETECT_ENGINE == SIN_DETECT_ENGINE_YIN) \
+    && (((SIN_DETECT_RATE_MAX / SIN_DETECT_YIN_FREQ_LOW) + 1) > YIN_LAG_MAX)
+#error "SIN_DETECT_RATE_MAX: period of YIN lowest frequency does not fit lags, raise YIN_LAG_MAX!"
+#endif
+#if (SIN_DETECT_ENGINE == SIN_DETECT_ENGINE_YIN) \
+    && ((SIN_DETECT_YIN_WINDOW + (SIN_DETECT_RATE_MAX / SIN_DETECT_YIN_FREQ_LOW) + 2 + (2 * SIN_DETECT_YIN_HOP)) \
+        > YIN_RING_SIZE)
+#error "SIN_DETECT_RATE_MAX: YIN window with its lags does not fit samples ring, raise YIN_RING_SIZE!"
+#endif
 
 /**********************************************************************************************************************
  * Private typedef
  *********************************************************************************************************************/
-/**
- * @brief   Sinusoidal signal frequency detection data structure.
- */
-typedef struct
-{
-    uint32_t accumulator;       /**< Counter accumulator. */
-    uint32_t counter;           /**< Counter for time. */
-    uint32_t cycles;            /**< Cycles counter after which is reached will calculate frequency. */
-    uint32_t last_signal;       /**< Last signal value. */
-    uint32_t current_signal;    /**< Current signal value. */
-    float frequncy;             /**< Measured sinusoidal signal frequency, */
-    bool state;                 /**< Flag that show if frequency is between range @ref SIN_DETECT_FREQ_LOW
-                                     and @ref SIN_DETECT_FREQ_HIGH. true - yes, false - no. */
-} sin_detect_data_t;
 
 /**********************************************************************************************************************
  * Private constants
@@ -67,62 +93,409 @@ typedef struct
 /**********************************************************************************************************************
  * Private variables
  *********************************************************************************************************************/
-/** Sinusoidal signal frequency detection data. See @ref sin_detect_data_t. */
-volatile sin_detect_data_t sin_detect_data = {0};
-/** Son detection low pass filter data. See @ref filters_low_pass_t. */
-volatile filters_low_pass_t sin_detect_lp_filter = {0};
 
 /**********************************************************************************************************************
  * Exported variables
  *********************************************************************************************************************/
+const sin_detect_config_t sin_detect_config_main =
+{
+    .rate = SIN_DETECT_RATE,
+    .cycles = SIN_DETECT_CYCLES,
+    .lp_cut_off = SIN_DETECT_LP_CUTOFF,
+    .freq_low = SIN_DETECT_FREQ_LOW,
+    .freq_high = SIN_DETECT_FREQ_HIGH,
+    .freq_hys = SIN_DETECT_FREQ_HYS,
+    .led = SIN_DETECT_LED,
+    .timeout = SIN_DETECT_TIMEOUT,
+    .amplitude_min = SIN_DETECT_AMPLITUDE_MIN,
+    .clock = SIN_DETECT_CLOCK,
+    .samples = SIN_DETECT_SAMPLES,
+};
+sin_detect_t sin_detect_main = {0};
 
 /**********************************************************************************************************************
  * Prototypes of local functions
  *********************************************************************************************************************/
+/**
+ * @brief   Get time counter units per second.
+ *
+ * @param   config  Pointer to detection configuration. See @ref sin_detect_config_t.
+ *
+ * @return  Timestamp clock if it is configured, otherwise @ref SIN_DETECT_FRAC_ONE per sample period.
+ */
+static float sin_detect_unit(const sin_detect_config_t *config);
+
+/**
+ * @brief   Process one sample by configured detection engine.
+ *
+ * @param   ctx     Pointer to detection context. See @ref sin_detect_t.
+ * @param   signal  Sinusoidal signal.
+ */
+static void sin_detect_sample(sin_detect_t *ctx, uint32_t signal);
+
+#if SIN_DETECT_ENGINE == SIN_DETECT_ENGINE_ZERO_CROSS
 /**
  * @brief   Calculate sinusoidal signal frequency.
  *
- * @param   data    Pointer to Sinusoidal signal frequency detection data. See @ref sin_detect_data_t.
+ * @param   ctx     Pointer to detection context. See @ref sin_detect_t.
+ * @param   signal  Sinusoidal signal.
+ */
+static void sin_detect_frquency(sin_detect_t *ctx, uint32_t signal);
+
+/**
+ * @brief   Fit sinusoid predictor of noise estimate to measured frequency and sample period.
+ *
+ * @param   ctx     Pointer to detection context. See @ref sin_detect_t.
+ * @param   step    Time between samples, in time counter units.
+ */
+static void sin_detect_noise_fit(sin_detect_t *ctx, uint32_t step);
+
+/**
+ * @brief   Interpolate zero crossing instant between two samples.
+ *
+ * @param   last    Signal value before zero crossing.
+ * @param   current Signal value after zero crossing.
+ * @param   zero    Zero level.
+ * @param   step    Time between samples, in time counter units.
+ *
+ * @return  Time elapsed from zero crossing till current sample, in time counter units.
+ */
+static uint32_t sin_detect_interpolate(uint32_t last, uint32_t current, uint32_t zero, uint32_t step);
+#endif // SIN_DETECT_ENGINE_ZERO_CROSS
+
+/**
+ * @brief   Divide in frequency units, integer only.
+ *
+ * @param   num     Numerator.
+ * @param   den     Denominator, less than @ref SIN_DETECT_PERIOD_MAX.
+ *
+ * @return  num / den with @ref SIN_DETECT_FREQ_BITS fractional bits rounded down, 0 if den is out of range.
+ */
+static uint32_t sin_detect_reciprocal(uint32_t num, uint32_t den);
+
+/**
+ * @brief   Track sinusoidal signal zero level.
+ *
+ * @note    Zero level is updated once per signal period, on rising zero crossing, or after
+ *          @ref SIN_DETECT_ZERO_TIMEOUT if signal does not cross it at all.
+ *
+ * @param   ctx     Pointer to detection context. See @ref sin_detect_t.
  * @param   signal  Sinusoidal signal.
+ * @param   rising  Flag that shows if signal crossed zero level rising.
+ * @param   step    Time since last sample, in time counter units.
  */
-static void sin_detect_frquency(sin_detect_data_t *data, uint32_t signal);
+static void sin_detect_zero_track(sin_detect_t *ctx, uint32_t signal, bool rising, uint32_t step);
 
+#if SIN_DETECT_ENGINE != SIN_DETECT_ENGINE_ZERO_CROSS
 /**
- * @brief   Control led by sinusoidal signal frequency.
+ * @brief   Take frequency estimate of engine, it is valid on the same terms as zero crossing measurement.
  *
- * @param   freq    Frequency in Hz by which led will be controlled.
- * @param   state   Current state of whether frequency was in a range.
+ * @param   ctx     Pointer to detection context. See @ref sin_detect_t.
+ * @param   freq    Frequency, see @ref SIN_DETECT_FREQ_BITS, 0 - engine found no tone.
+ */
+static void sin_detect_estimate(sin_detect_t *ctx, uint32_t freq);
+#endif // SIN_DETECT_ENGINE_ZERO_CROSS
+
+/**
+ * @brief   Filter and save new frequency.
+ *
+ * @param   ctx     Pointer to detection context. See @ref sin_detect_t.
+ * @param   freq    Frequency, see @ref SIN_DETECT_FREQ_BITS.
+ */
+static void sin_detect_update(sin_detect_t *ctx, uint32_t freq);
+
+/**
+ * @brief   Update sample rate divider target from measured frequency.
+ *
+ * @param   ctx     Pointer to detection context. See @ref sin_detect_t.
+ * @param   freq    Frequency, see @ref SIN_DETECT_FREQ_BITS.
+ */
+static void sin_detect_adapt(sin_detect_t *ctx, uint32_t freq);
+
+/**
+ * @brief   Invalidate frequency when signal is lost or too weak and restart measurement.
  *
- * @return  State of whether frequency is in the range.
- * @retval  0   frequency is not in the range.
- * @retval  1   frequency is in the range.
+ * @param   ctx     Pointer to detection context. See @ref sin_detect_t.
  */
-static bool sin_detect_led_control(float freq, bool state);
+static void sin_detect_invalidate(sin_detect_t *ctx);
+
+/**
+ * @brief   Update state of whether frequency is in configured band and control led by it.
+ *
+ * @param   ctx     Pointer to detection context. See @ref sin_detect_t.
+ */
+static void sin_detect_led_control(sin_detect_t *ctx);
+
+#if SIN_DETECT_THREAD
+/**
+ * @brief   Sinusoidal signal frequency detection deferred work, processes last block of samples.
+ *
+ * @param   argument    Pointer to detection context. See @ref sin_detect_t.
+ */
+static void sin_detect_work(void *argument);
+#endif // SIN_DETECT_THREAD
 
 /**********************************************************************************************************************
  * Exported functions
  *********************************************************************************************************************/
-bool sin_detect_init(void)
+bool sin_detect_init(sin_detect_t *ctx, const sin_detect_config_t *config)
 {
-    timers_32_0_start(SIN_DETECT_RATE);
+    if(config->rate <= 0 || config->cycles == 0 || config->timeout == 0 || config->freq_low == 0
+       || config->clock < 0 || ((sin_detect_unit(config) / 2.0F) * config->cycles) >= 4294967296.0F
+       || (config->clock > 0 && (config->cycles % 2) != 0)
+       || ((sin_detect_unit(config) / config->rate) * SIN_DETECT_DIVIDER_MAX) >= 1048576.0F
+       || (config->samples > 0 && (config->rate * SIN_DETECT_FREQ_ONE) >= 4294967296.0F)
+       || config->freq_low < config->freq_hys || config->freq_high <= config->freq_low)
+    {
+        return false;
+    }
+
+    memset(ctx, 0, sizeof(sin_detect_t));
+    ctx->config = *config;
+    ctx->period_scale = (uint32_t)(sin_detect_unit(config) / 2.0F) * config->cycles;
+    ctx->unit = (uint32_t)sin_detect_unit(config);
+    ctx->zero_window = (uint32_t)(sin_detect_unit(config) * SIN_DETECT_ZERO_WINDOW);
+    ctx->zero_timeout = (uint32_t)(sin_detect_unit(config) * SIN_DETECT_ZERO_TIMEOUT);
+    ctx->timeout = (uint32_t)((sin_detect_unit(config) * config->timeout * SIN_DETECT_FREQ_ONE)
+                              / (float)config->freq_low);
+    ctx->divider_target = 1;
+    ctx->divider_max = 1;
+    if(config->samples > 0)
+    {
+        ctx->rate_freq = (uint32_t)((config->rate * SIN_DETECT_FREQ_ONE) / config->samples);
+        // Lowest rate still has several samples per period of band high frequency, it could come any time.
+        ctx->divider_max = (uint32_t)((config->rate * SIN_DETECT_FREQ_ONE)
+                                      / ((float)config->freq_high * SIN_DETECT_SAMPLES_MIN));
+        if(ctx->divider_max < 1)
+        {
+            ctx->divider_max = 1;
+        }
+        if(ctx->divider_max > SIN_DETECT_DIVIDER_MAX)
+        {
+            ctx->divider_max = SIN_DETECT_DIVIDER_MAX;
+        }
+    }
+    // Nominal sample period, it is used until samples are timestamped.
+    ctx->data.step = (uint32_t)(sin_detect_unit(config) / config->rate);
+    ctx->data.zero = SIN_DETECT_ZERO;
+    ctx->data.min = UINT32_MAX;
+    ctx->data.lost = true;
+    sin_detect_hal_led(config->led, false);
+
+    // Engines estimate once per block or hop, timeout starts after estimate is due, thread may finish it a block late.
+#if SIN_DETECT_ENGINE == SIN_DETECT_ENGINE_GOERTZEL
+    // Longest block whose bins still overlap, 214 samples (43 ms) at 5 kHz.
+    if(!goertzel_init(&ctx->goertzel, config->rate, SIN_DETECT_GOERTZEL_FREQ_LOW,
+                      SIN_DETECT_GOERTZEL_FREQ_HIGH, SIN_DETECT_GOERTZEL_BINS,
+                      (uint32_t)((config->rate * (SIN_DETECT_GOERTZEL_BINS - 1))
+                                 / (SIN_DETECT_GOERTZEL_FREQ_HIGH - SIN_DETECT_GOERTZEL_FREQ_LOW))))
+    {
+        return false;
+    }
+    ctx->timeout += ctx->data.step * ctx->goertzel.block;
+#endif // SIN_DETECT_ENGINE_GOERTZEL
+#if SIN_DETECT_ENGINE == SIN_DETECT_ENGINE_PLL
+    if(!pll_init(&ctx->pll, config->rate, SIN_DETECT_PLL_FREQ_MIN, SIN_DETECT_PLL_FREQ_MAX,
+                 SIN_DETECT_PLL_BANDWIDTH))
+    {
+        return false;
+    }
+#endif // SIN_DETECT_ENGINE_PLL
+#if SIN_DETECT_ENGINE == SIN_DETECT_ENGINE_FFT
+    if(!spectrum_init(&ctx->spectrum, SIN_DETECT_FFT_SIZE, config->rate, SIN_DETECT_FFT_FREQ_LOW,
+                      SIN_DETECT_FFT_SNR))
+    {
+        return false;
+    }
+    ctx->timeout += ctx->data.step * 2 * SIN_DETECT_FFT_SIZE;
+#endif // SIN_DETECT_ENGINE_FFT
+#if SIN_DETECT_ENGINE == SIN_DETECT_ENGINE_YIN
+    if(config->rate > SIN_DETECT_RATE_MAX)
+    {
+        DEBUG_INIT("Sin detect: YIN buffers are sized for %d Hz, %.0f Hz rate is too high.", SIN_DETECT_RATE_MAX,
+                   config->rate);
+        return false;
+    }
+    if(!yin_init(&ctx->yin, config->rate, SIN_DETECT_YIN_FREQ_LOW, SIN_DETECT_YIN_FREQ_HIGH,
+                 SIN_DETECT_YIN_WINDOW, SIN_DETECT_YIN_HOP, SIN_DETECT_YIN_CONFIDENCE))
+    {
+        return false;
+    }
+    ctx->timeout += ctx->data.step * 2 * SIN_DETECT_YIN_HOP;
+#endif // SIN_DETECT_ENGINE_YIN
+#if SIN_DETECT_THREAD
+    ctx->work.func = sin_detect_work;
+    ctx->work.argument = ctx;
+    if(!sin_detect_hal_work_start(&ctx->work))
+    {
+        return false;
+    }
+#endif // SIN_DETECT_THREAD
 
     return true;
 }
 
-void sin_detect_process(uint32_t signal)
+void sin_detect_process(sin_detect_t *ctx, uint32_t signal)
 {
-    // Calculate frequency.
-    sin_detect_frquency((sin_detect_data_t *)&sin_detect_data, signal);
+    sin_detect_sample(ctx, signal);
+
+    // Control led.
+    sin_detect_led_control(ctx);
+
+    return;
+}
+
+void sin_detect_process_block(sin_detect_t *ctx, const uint16_t *samples, uint32_t count)
+{
+    uint32_t i = 0;
+
+    // Context is not volatile, so compiler is free to keep its state in registers over the whole block.
+    for(i = 0; i < count; i++)
+    {
+        sin_detect_sample(ctx, samples[i]);
+    }
 
     // Control led.
-    sin_detect_data.state = sin_detect_led_control(sin_detect_data.frequncy, sin_detect_data.state);
+    sin_detect_led_control(ctx);
+
+    return;
+}
+
+void sin_detect_process_timed(sin_detect_t *ctx, uint32_t signal, uint32_t time)
+{
+    // Real time since last sample, timer slips and match rounding are measured, not assumed.
+    ctx->data.step = time - ctx->data.time_sample;
+    ctx->data.time_sample = time;
+
+    sin_detect_process(ctx, signal);
+
+    return;
+}
+
+void sin_detect_process_block_timed(sin_detect_t *ctx, const uint16_t *samples, uint32_t count, uint32_t time,
+                                    uint32_t period)
+{
+    uint32_t i = 0;
+
+    if(count == 0)
+    {
+        return;
+    }
+
+    // First sample is timed from last one of previous block, rate could change between blocks.
+    ctx->data.step = time - ctx->data.time_sample;
+    for(i = 0; i < count; i++)
+    {
+        sin_detect_sample(ctx, samples[i]);
+        ctx->data.step = period;
+    }
+    ctx->data.time_sample = time + ((count - 1) * period);
+
+    // Control led.
+    sin_detect_led_control(ctx);
+
+    return;
+}
+
+void sin_detect_process_crossing(sin_detect_t *ctx, uint32_t time, bool rising)
+{
+    sin_detect_data_t *data = &ctx->data;
+
+    if(data->lost)
+    {
+        // First zero crossing after signal loss, time before it is not a signal period.
+        data->lost = false;
+    }
+    else if(rising == data->positive)
+    {
+        // Crossing between was missed, time since last one is not a half period and rising and falling half
+        // periods would not pair any more, so cycles started before it are dropped.
+        data->missed++;
+        data->cycles = 0;
+        data->accumulator = 0;
+    }
+    else
+    {
+        // Timer is free-running, difference is right over its overflow. Pairs of half periods between
+        // crossings at different hysteresis levels are full periods, so cycles count is even.
+        data->cycles++;
+        data->accumulator += time - data->time;
+        if(data->cycles >= ctx->config.cycles)
+        {
+            sin_detect_update(ctx, sin_detect_reciprocal(ctx->period_scale, data->accumulator));
+            data->cycles = 0;
+            data->accumulator = 0;
+        }
+    }
+    data->positive = rising;
+    data->time = time;
+
+    // Control led.
+    sin_detect_led_control(ctx);
+
+    return;
+}
+
+void sin_detect_process_timeout(sin_detect_t *ctx, uint32_t time)
+{
+    // Signed difference, crossing timestamped after time was read is not a timeout.
+    if(!ctx->data.lost && (int32_t)(time - ctx->data.time) >= (int32_t)ctx->timeout)
+    {
+        sin_detect_invalidate(ctx);
+        sin_detect_led_control(ctx);
+    }
+
+    return;
+}
+
+uint32_t sin_detect_get_divider(sin_detect_t *ctx)
+{
+    return ctx->divider_target;
+}
+
+bool sin_detect_get_frequency(sin_detect_t *ctx, uint32_t *freq)
+{
+    uint32_t lock = 0;
+    bool valid = false;
+
+    lock = sin_detect_hal_lock();
+    valid = ctx->data.valid;
+    *freq = valid ? ctx->data.frequncy : 0;
+    sin_detect_hal_unlock(lock);
+
+    return valid;
+}
+
+void sin_detect_get_output(sin_detect_t *ctx, sin_detect_output_t *output)
+{
+    uint32_t lock = 0;
+
+    lock = sin_detect_hal_lock();
+    output->valid = ctx->data.valid;
+    output->state = ctx->data.state;
+    output->frequency = output->valid ? ctx->data.frequncy : 0;
+    output->divider = ctx->divider_target;
+    sin_detect_hal_unlock(lock);
 
     return;
 }
 
-void sin_detect_debug(void)
+void sin_detect_debug(sin_detect_t *ctx)
 {
-    DEBUG("Sin detect: %d, %.03f Hz;",  sin_detect_data.state, sin_detect_data.frequncy);
+    sin_detect_output_t output = {0};
+
+    sin_detect_get_output(ctx, &output);
+#if SIN_DETECT_ENGINE == SIN_DETECT_ENGINE_FFT
+    DEBUG("Sin detect: %d, %.03f Hz; FFT: %ld cycles;",
+          output.state, (float)output.frequency / SIN_DETECT_FREQ_ONE, ctx->block_cycles);
+#elif SIN_DETECT_ENGINE == SIN_DETECT_ENGINE_YIN
+    DEBUG("Sin detect: %d, %.03f Hz; YIN: %.02f confidence, %ld cycles;",
+          output.state, (float)output.frequency / SIN_DETECT_FREQ_ONE,
+          (float)ctx->yin.confidence / (1UL << YIN_FRAC_BITS), ctx->block_cycles);
+#else
+    DEBUG("Sin detect: %d, %.03f Hz%s;",  output.state, (float)output.frequency / SIN_DETECT_FREQ_ONE,
+          output.valid ? "" : ", no signal");
+#endif // SIN_DETECT_ENGINE
 
     return;
 }
@@ -130,83 +503,405 @@ void sin_detect_debug(void)
 /**********************************************************************************************************************
  * Private functions
  *********************************************************************************************************************/
-static void sin_detect_frquency(sin_detect_data_t *data, uint32_t signal)
+static float sin_detect_unit(const sin_detect_config_t *config)
 {
-    float freq = 0;
+    return (config->clock > 0) ? config->clock : (config->rate * SIN_DETECT_FRAC_ONE);
+}
+
+static void sin_detect_sample(sin_detect_t *ctx, uint32_t signal)
+{
+#if SIN_DETECT_ENGINE == SIN_DETECT_ENGINE_GOERTZEL
+    // Find frequency of strongest bin once per block.
+    if(goertzel_process(&ctx->goertzel, signal))
+    {
+        sin_detect_estimate(ctx, goertzel_peak(&ctx->goertzel, SIN_DETECT_GOERTZEL_SNR, ctx->config.amplitude_min));
+    }
+#elif SIN_DETECT_ENGINE == SIN_DETECT_ENGINE_PLL
+    // Track frequency every sample, no lock - no frequency.
+    sin_detect_estimate(ctx, pll_process(&ctx->pll, signal) ? pll_frequency(&ctx->pll) : 0);
+#elif SIN_DETECT_ENGINE == SIN_DETECT_ENGINE_FFT
+    // Collect block of samples, thread will find its frequency.
+    ctx->block[ctx->block_active][ctx->block_fill++] = (uint16_t)signal;
+    if(ctx->block_fill >= SIN_DETECT_FFT_SIZE)
+    {
+        ctx->block_fill = 0;
+        ctx->block_active ^= 1;
+        sin_detect_hal_work_signal(&ctx->work);
+    }
+#elif SIN_DETECT_ENGINE == SIN_DETECT_ENGINE_YIN
+    // Push sample to ring, thread will update estimate once per hop.
+    if(yin_push(&ctx->yin, signal))
+    {
+        sin_detect_hal_work_signal(&ctx->work);
+    }
+#else
+    // Calculate frequency.
+    sin_detect_frquency(ctx, signal);
+#endif // SIN_DETECT_ENGINE
+#if SIN_DETECT_ENGINE != SIN_DETECT_ENGINE_ZERO_CROSS
+    // No new estimate for too long - signal is lost, weak signal is no signal, as in zero crossing engine.
+    ctx->data.counter += ctx->data.step;
+    if(ctx->data.counter >= ctx->timeout)
+    {
+        sin_detect_invalidate(ctx);
+    }
+    // Signal never crosses tracked zero level here, window is max. one and amplitude is its peak to peak.
+    sin_detect_zero_track(ctx, signal, false, ctx->data.step);
+#endif // SIN_DETECT_ENGINE_ZERO_CROSS
+
+    return;
+}
+
+#if SIN_DETECT_ENGINE == SIN_DETECT_ENGINE_ZERO_CROSS
+static void sin_detect_frquency(sin_detect_t *ctx, uint32_t signal)
+{
+    sin_detect_data_t *data = &ctx->data;
+    uint32_t freq = 0;
+    uint32_t step = data->step;
+    int32_t diff = 0;
+    uint32_t hys = 0;
+    bool rising = false;
 
     // Save current signal.
     data->current_signal = signal;
 
-    // Increment time measurement counter.
-    data->counter++;
+    // Increment time measurement counter by one sample period, no zero crossing for too long - signal is lost.
+    data->counter += step;
+    if(data->counter >= ctx->timeout)
+    {
+        sin_detect_invalidate(ctx);
+    }
 
-    // Check if sin signal is at zero level.
-    if((data->last_signal > SIN_DETECT_ZERO && data->current_signal <= SIN_DETECT_ZERO)
-        || (data->last_signal < SIN_DETECT_ZERO && data->current_signal >= SIN_DETECT_ZERO))
+    // Estimate noise as mean absolute residual of sinusoid x[n] = 2 * cos(w) * x[n-1] - x[n-2] around zero level,
+    // w is phase of measured frequency per sample, so signal itself is rejected. Until frequency is measured w is 0
+    // and residual is second difference, sinusoid of amplitude A adds (2 / pi) * A * w^2 to it, e.g. 0.09 * A at
+    // 300 Hz sampled at 5 kHz, so hysteresis is up to 0.14 * A before first frequency, still below signal peak.
+    if(((step > data->noise_step) ? (step - data->noise_step) : (data->noise_step - step))
+       > (data->noise_step >> SIN_DETECT_NOISE_FIT))
     {
-        data->cycles++;
-        data->accumulator += data->counter;
-        if(data->cycles > SIN_DETECT_CYCLES)
+        sin_detect_noise_fit(ctx, step);
+    }
+    diff = (int32_t)data->current_signal + (int32_t)data->older_signal - (2 * (int32_t)data->zero)
+           - ((2 * data->noise_cos * ((int32_t)data->last_signal - (int32_t)data->zero)) >> 15);
+    data->noise += (uint32_t)((diff < 0) ? -diff : diff) - (data->noise >> SIN_DETECT_NOISE_SHIFT);
+    // Hysteresis is 1.5 of noise estimate.
+    hys = (3 * data->noise) >> (SIN_DETECT_NOISE_SHIFT + 1);
+    if(hys < SIN_DETECT_HYS_MIN)
+    {
+        hys = SIN_DETECT_HYS_MIN;
+    }
+
+    // Remember when signal crossed zero level, it will be confirmed when signal leaves hysteresis band.
+    if(data->positive ? (data->current_signal < data->zero && data->last_signal >= data->zero)
+                      : (data->current_signal >= data->zero && data->last_signal < data->zero))
+    {
+        data->crossing = data->counter - sin_detect_interpolate(data->last_signal, data->current_signal, data->zero,
+                                                                step);
+        data->crossed = true;
+    }
+
+    // Check if sin signal crossed zero level. Polarity is kept in a flag, so zero level update can not make a false crossing.
+    rising = (!data->positive && data->current_signal >= (data->zero + hys));
+    if((data->positive && (data->current_signal + hys) < data->zero) || rising)
+    {
+        data->positive = rising;
+        // Zero level moved over signal and crossing was not seen, take current sample.
+        if(!data->crossed)
+        {
+            data->crossing = data->counter - sin_detect_interpolate(data->last_signal, data->current_signal,
+                                                                    data->zero, step);
+        }
+        if(data->lost)
+        {
+            // First zero crossing after signal loss, time before it is not a signal period.
+            data->lost = false;
+        }
+        else
+        {
+            data->cycles++;
+            data->accumulator += data->crossing;
+        }
+        if(data->cycles >= ctx->config.cycles)
         {
             // Calculate frequency.
-            freq = 1.0 / (((float)(float)data->accumulator / (float)data->cycles) * 2.0 * (1.0 / SIN_DETECT_RATE));
-            // Pass frequency to low pass filter.
-            freq = filters_low_pass( (filters_low_pass_t *) &sin_detect_lp_filter, freq, SIN_DETECT_LP_CUTOFF);
-            // Save frequency.
-            data->frequncy = freq;
+            freq = sin_detect_reciprocal(ctx->period_scale, data->accumulator);
+            if(data->amplitude < ctx->config.amplitude_min)
+            {
+                // Amplitude is not measured yet or signal is too weak.
+                sin_detect_invalidate(ctx);
+            }
+            else
+            {
+                sin_detect_update(ctx, freq);
+            }
             // Clear cycles counter.
             data->cycles = 0;
             // Clear accumulator.
             data->accumulator = 0;
         }
-        // Clear time counter.
-        data->counter = 0;
+        // Restart time counter from zero crossing instant.
+        data->counter -= data->crossing;
+        data->crossing = 0;
+        data->crossed = false;
     }
 
-    // Save last signal.
+    // Update zero level for next crossings.
+    sin_detect_zero_track(ctx, signal, rising, step);
+
+    // Save last signals.
+    data->older_signal = data->last_signal;
     data->last_signal = signal;
 
     return;
 }
 
-static bool sin_detect_led_control(float freq, bool state)
+static void sin_detect_noise_fit(sin_detect_t *ctx, uint32_t step)
 {
-    bool ret = false;
+    sin_detect_data_t *data = &ctx->data;
+    uint32_t phase = 0;
+    int32_t cos0 = 0;
+    int32_t cos1 = 0;
 
-    if(state)
+    data->noise_step = step;
+    if(!data->valid)
     {
-        // Previous frequency was in range
-        if(freq >= (SIN_DETECT_FREQ_LOW - SIN_DETECT_FREQ_HYS)
-           && freq <= (SIN_DETECT_FREQ_HIGH + SIN_DETECT_FREQ_HYS))
-        {
-            // In rage [98:302], turn on LED.
-            gpio_output_low(GPIO_ID_LED_BLUE);
-            ret = true;
-        }
-        else
+        data->noise_cos = SIN_DETECT_COS_ONE;
+        return;
+    }
+
+    // Phase per sample, 2^32 is full turn: f * step / unit, frequency is below 2^26 and step below 2^20.
+    phase = (uint32_t)((((uint64_t)data->frequncy * step) << (32 - SIN_DETECT_FREQ_BITS)) / ctx->unit);
+    // Table points are 0.7 degree apart, too coarse for low frequencies, so cosine is interpolated between them.
+    cos0 = sine_cos_q15(phase & ~((1UL << (32 - SINE_TABLE_BITS)) - 1));
+    cos1 = sine_cos_q15((phase & ~((1UL << (32 - SINE_TABLE_BITS)) - 1)) + (1UL << (32 - SINE_TABLE_BITS)));
+    data->noise_cos = cos0 + (((cos1 - cos0) * (int32_t)((phase >> (32 - SINE_TABLE_BITS - 16)) & 0xFFFF)) >> 16);
+
+    return;
+}
+
+static uint32_t sin_detect_interpolate(uint32_t last, uint32_t current, uint32_t zero, uint32_t step)
+{
+    uint32_t change = 0;
+    uint32_t over = 0;
+
+    // Signal change during one sample period.
+    change = (current > last) ? (current - last) : (last - current);
+    // How far current signal is past zero level.
+    over = (current > zero) ? (current - zero) : (zero - current);
+
+    // Zero level could have moved since last sample, crossing can't be earlier than last sample.
+    if(over >= change)
+    {
+        return step;
+    }
+
+    // Linear interpolation, product fits 32 bits for 12-bit signal and step below 2^20, checked on init.
+    return (over * step) / change;
+}
+#endif // SIN_DETECT_ENGINE_ZERO_CROSS
+
+static uint32_t sin_detect_reciprocal(uint32_t num, uint32_t den)
+{
+    uint32_t quotient = 0;
+    uint32_t i = 0;
+
+    if(den == 0 || den >= SIN_DETECT_PERIOD_MAX)
+    {
+        return 0;
+    }
+
+    quotient = num / den;
+    num %= den;
+    // Fractional bits byte by byte, shifted remainder still fits 32 bits.
+    for(i = 0; i < (SIN_DETECT_FREQ_BITS / 8); i++)
+    {
+        num <<= 8;
+        quotient = (quotient << 8) + (num / den);
+        num %= den;
+    }
+
+    return quotient;
+}
+
+static void sin_detect_zero_track(sin_detect_t *ctx, uint32_t signal, bool rising, uint32_t step)
+{
+    sin_detect_data_t *data = &ctx->data;
+
+    // Minimum and maximum are tracked in every mode for signal amplitude.
+    if(signal < data->min)
+    {
+        data->min = signal;
+    }
+    if(signal > data->max)
+    {
+        data->max = signal;
+    }
+#if SIN_DETECT_ZERO_MODE == SIN_DETECT_ZERO_MEAN
+    data->sum += signal;
+#endif
+    data->samples++;
+    // Window is timed, sample rate can change.
+    data->window += step;
+
+    // Window is one signal period, but not shorter than noise could make it and not longer than timeout.
+    if((rising && data->window >= ctx->zero_window) || data->window >= ctx->zero_timeout)
+    {
+        data->amplitude = data->max - data->min;
+#if SIN_DETECT_ZERO_MODE == SIN_DETECT_ZERO_MINMAX
+        data->zero = (data->min + data->max) / 2;
+#elif SIN_DETECT_ZERO_MODE == SIN_DETECT_ZERO_MEAN
+        data->zero = data->sum / data->samples;
+        data->sum = 0;
+#endif
+        data->min = signal;
+        data->max = signal;
+        data->samples = 0;
+        data->window = 0;
+        // Flat or too weak signal, zero crossings are noise.
+        if(data->amplitude < ctx->config.amplitude_min)
         {
-            // Out of range, turn off LED
-            gpio_output_high(GPIO_ID_LED_BLUE);
-            ret = false;
+            sin_detect_invalidate(ctx);
         }
     }
+
+    return;
+}
+
+#if SIN_DETECT_ENGINE != SIN_DETECT_ENGINE_ZERO_CROSS
+static void sin_detect_estimate(sin_detect_t *ctx, uint32_t freq)
+{
+    sin_detect_data_t *data = &ctx->data;
+
+    if(freq == 0 || data->amplitude < ctx->config.amplitude_min)
+    {
+        sin_detect_invalidate(ctx);
+        return;
+    }
+
+    // Engines filter by themselves, estimate is taken as is and restarts loss timeout.
+    data->frequncy = freq;
+    data->valid = true;
+    data->lost = false;
+    data->counter = 0;
+
+    return;
+}
+#endif // SIN_DETECT_ENGINE_ZERO_CROSS
+
+static void sin_detect_update(sin_detect_t *ctx, uint32_t freq)
+{
+    sin_detect_data_t *data = &ctx->data;
+
+    // Start low pass filter from first frequency after signal loss.
+    if(!data->valid)
+    {
+        ctx->lp_filter.output = (int32_t)freq;
+    }
+    // Pass frequency to low pass filter.
+    freq = (uint32_t)filters_low_pass(&ctx->lp_filter, (int32_t)freq, ctx->config.lp_cut_off);
+    // Save frequency.
+    data->frequncy = freq;
+    data->valid = true;
+    // Noise predictor follows frequency.
+    data->noise_step = 0;
+    // Follow frequency by sample rate.
+    if(ctx->config.samples > 0)
+    {
+        sin_detect_adapt(ctx, freq);
+    }
+
+    return;
+}
+
+static void sin_detect_adapt(sin_detect_t *ctx, uint32_t freq)
+{
+    uint32_t divider = ctx->divider_target;
+
+    // Rate is too low for target samples per period, raise it at once.
+    while(divider > 1 && freq > (ctx->rate_freq / divider))
+    {
+        divider--;
+    }
+    // Lower rate only if it keeps target samples per period of 12.5% higher frequency.
+    while(divider < ctx->divider_max && (freq + (freq >> 3)) <= (ctx->rate_freq / (divider + 1)))
+    {
+        divider++;
+    }
+    ctx->divider_target = divider;
+
+    return;
+}
+
+static void sin_detect_invalidate(sin_detect_t *ctx)
+{
+    sin_detect_data_t *data = &ctx->data;
+
+    data->valid = false;
+    data->frequncy = 0;
+    data->lost = true;
+    data->cycles = 0;
+    data->accumulator = 0;
+    data->counter = 0;
+    data->crossing = 0;
+    data->crossed = false;
+    // Frequency is gone, predictor falls back to second difference.
+    data->noise_step = 0;
+    // Full rate catches any frequency of new signal.
+    ctx->divider_target = 1;
+
+    return;
+}
+
+static void sin_detect_led_control(sin_detect_t *ctx)
+{
+    const sin_detect_config_t *config = &ctx->config;
+    uint32_t freq = ctx->data.frequncy;
+    bool state = false;
+
+    if(ctx->data.state)
+    {
+        // Previous frequency was in range, e.g. [98:302].
+        state = (freq >= (config->freq_low - config->freq_hys) && freq <= (config->freq_high + config->freq_hys));
+    }
     else
     {
-        // Previous frequency was not in a range.
-        if(freq >= (SIN_DETECT_FREQ_LOW + SIN_DETECT_FREQ_HYS)
-           && freq <= (SIN_DETECT_FREQ_HIGH - SIN_DETECT_FREQ_HYS))
-        {
-            // In range [102:298], turn on LED.
-            gpio_output_low(GPIO_ID_LED_BLUE);
-            ret = true;
-        }
-        else
-        {
-            // Out of range, turn off LED
-            gpio_output_high(GPIO_ID_LED_BLUE);
-            ret = false;
-        }
+        // Previous frequency was not in a range, e.g. [102:298].
+        state = (freq >= (config->freq_low + config->freq_hys) && freq <= (config->freq_high - config->freq_hys));
+    }
+
+    // Write led only on change, in range - turn on, out of range - turn off.
+    if(state != ctx->data.state)
+    {
+        sin_detect_hal_led(config->led, state);
     }
+    ctx->data.state = state;
 
-    return ret;
+    return;
+}
+
+#if SIN_DETECT_THREAD
+static void sin_detect_work(void *argument)
+{
+    sin_detect_t *ctx = (sin_detect_t *)argument;
+    uint32_t start = 0;
+    uint32_t freq = 0;
+    uint32_t lock = 0;
+
+    start = sin_detect_hal_get_time();
+#if SIN_DETECT_ENGINE == SIN_DETECT_ENGINE_FFT
+    // Block which is not being filled is the last complete one.
+    freq = spectrum_estimate(&ctx->spectrum, ctx->block[ctx->block_active ^ 1], ctx->fft_work);
+#else
+    // Ring is updated by samples pushed since last estimate.
+    freq = yin_estimate(&ctx->yin);
+#endif // SIN_DETECT_ENGINE_FFT
+    ctx->block_cycles = sin_detect_hal_get_time() - start;
+
+    // Sampling interrupt checks amplitude and timeout of the same data.
+    lock = sin_detect_hal_lock();
+    sin_detect_estimate(ctx, freq);
+    sin_detect_hal_unlock(lock);
+
+    return;
 }
+#endif // SIN_DETECT_THREAD
@@ -30,22 +30,150 @@ extern "C" {
 #include <stdint.h>
 #include <stdbool.h>
 
+#include "filters.h"
+#include "goertzel.h"
+#include "pll.h"
+#include "spectrum.h"
+#include "yin.h"
+#include "sin_detect_hal.h"
+
 /**********************************************************************************************************************
  * Exported definitions and macros
  *********************************************************************************************************************/
 #define SIN_DETECT_RATE         5000.0F                 //!< Sin detection rate in Hz.
+#define SIN_DETECT_CLOCK        48000000.0F             //!< Zero crossing timestamp clock in Hz, core clock.
+#define SIN_DETECT_RATE_MAX     10000                   //!< Highest configured rate in Hz YIN engine is sized for.
+#define SIN_DETECT_FREQ_BITS    16                      //!< Fractional bits of frequency (Q16.16).
+#define SIN_DETECT_FREQ_ONE     (1UL << SIN_DETECT_FREQ_BITS)   //!< One Hz in frequency units.
+
+#define SIN_DETECT_ENGINE_ZERO_CROSS    0           //!< Detection engine: zero crossing period measurement.
+#define SIN_DETECT_ENGINE_GOERTZEL      1           //!< Detection engine: Goertzel filter bank peak.
+#define SIN_DETECT_ENGINE_FFT           2           //!< Detection engine: FFT peak, processed by thread.
+#define SIN_DETECT_ENGINE_PLL           3           //!< Detection engine: phase locked loop tracking.
+#define SIN_DETECT_ENGINE_YIN           4           //!< Detection engine: YIN period estimator, processed by thread.
+#ifndef SIN_DETECT_ENGINE
+#define SIN_DETECT_ENGINE       SIN_DETECT_ENGINE_ZERO_CROSS    //!< Detection engine, may be set by build.
+#endif // SIN_DETECT_ENGINE
+#if SIN_DETECT_ENGINE < SIN_DETECT_ENGINE_ZERO_CROSS || SIN_DETECT_ENGINE > SIN_DETECT_ENGINE_YIN
+#error "SIN_DETECT_ENGINE: unknown detection engine!"
+#endif
+#define SIN_DETECT_THREAD       ((SIN_DETECT_ENGINE == SIN_DETECT_ENGINE_FFT) \
+                                 || (SIN_DETECT_ENGINE == SIN_DETECT_ENGINE_YIN))   //!< Engine uses thread.
+#define SIN_DETECT_FFT_SIZE     512                     //!< FFT engine block size in samples (102.4 ms).
 
 /**********************************************************************************************************************
  * Exported types
  *********************************************************************************************************************/
+/**
+ * @brief   Sinusoidal signal frequency detection configuration.
+ */
+typedef struct
+{
+    float rate;                 //!< Sample rate in Hz.
+    uint32_t cycles;            //!< Zero crossings count after which frequency is calculated.
+    uint32_t lp_cut_off;        //!< Frequency low pass filter cut off, see @ref FILTERS_CUT_OFF_BITS.
+    uint32_t freq_low;          //!< Band low frequency, see @ref SIN_DETECT_FREQ_BITS.
+    uint32_t freq_high;         //!< Band high frequency, see @ref SIN_DETECT_FREQ_BITS.
+    uint32_t freq_hys;          //!< Band hysteresis, see @ref SIN_DETECT_FREQ_BITS.
+    uint32_t led;               //!< LED which is on while frequency is in band, @ref SIN_DETECT_HAL_LED_NONE - none.
+    uint32_t timeout;           //!< Periods of band low frequency without zero crossing after which signal is lost.
+    uint32_t amplitude_min;     //!< Minimal signal peak to peak amplitude in ADC counts, below it there is no signal.
+    float clock;                //!< Zero crossing timestamp clock in Hz, 0 - only samples are processed.
+    uint32_t samples;           //!< Target samples per signal period of adaptive sample rate, 0 - fixed rate.
+} sin_detect_config_t;
+
+/**
+ * @brief   Sinusoidal signal frequency detection data structure.
+ */
+typedef struct
+{
+    uint32_t accumulator;       /**< Counter accumulator, in time counter units. */
+    uint32_t counter;           /**< Time since last zero crossing, in time counter units: timestamp clock ticks if
+                                     clock is configured, 1 / 256 of sample period otherwise. */
+    uint32_t cycles;            /**< Cycles counter after which is reached will calculate frequency. */
+    uint32_t older_signal;      /**< Signal value before last one. */
+    uint32_t last_signal;       /**< Last signal value. */
+    uint32_t current_signal;    /**< Current signal value. */
+    uint32_t zero;              /**< Zero level, see @ref SIN_DETECT_ZERO_MODE. */
+    bool positive;              /**< Flag that shows if signal is above zero level. */
+    bool crossed;               /**< Flag that shows if not yet confirmed zero crossing was seen, see crossing. */
+    uint32_t crossing;          /**< Time from previous till not yet confirmed zero crossing, valid if crossed. */
+    uint32_t noise;             /**< Noise estimate accumulator, noise is (noise >> @ref SIN_DETECT_NOISE_SHIFT). */
+    int32_t noise_cos;          /**< Cosine of measured frequency phase per sample in Q15, sinusoid predictor. */
+    uint32_t noise_step;        /**< Sample period noise_cos is fitted for, 0 - fit again. */
+    uint32_t min;               /**< Signal minimum in zero level tracking window. */
+    uint32_t max;               /**< Signal maximum in zero level tracking window. */
+    uint32_t sum;               /**< Signal sum in zero level tracking window. */
+    uint32_t samples;           /**< Samples count in zero level tracking window. */
+    uint32_t amplitude;         /**< Signal peak to peak amplitude in last zero level tracking window. */
+    uint32_t time;              /**< Timestamp of last zero crossing, in timestamp clock ticks. */
+    uint32_t step;              /**< Time from last sample till current one, in time counter units. */
+    uint32_t time_sample;       /**< Timestamp of last sample, in timestamp clock ticks. */
+    uint32_t window;            /**< Time of zero level tracking window, in time counter units. */
+    bool lost;                  /**< Flag that shows if signal was lost, next zero crossing only restarts counter. */
+    bool valid;                 /**< Flag that shows if frequency is measured, false - no signal, frequency is 0. */
+    uint32_t frequncy;          /**< Measured sinusoidal signal frequency, see @ref SIN_DETECT_FREQ_BITS. */
+    bool state;                 /**< Flag that show if frequency is in configured band. true - yes, false - no. */
+    uint32_t missed;            /**< Hardware zero crossings seen in same direction twice, one between was missed. */
+} sin_detect_data_t;
+
+/**
+ * @brief   Sinusoidal signal frequency detection output, consistent snapshot of detection data.
+ */
+typedef struct
+{
+    bool valid;                 //!< Flag that shows if frequency is measured, false - no signal.
+    bool state;                 //!< Flag that shows if frequency is in configured band.
+    uint32_t frequency;         //!< Measured frequency, see @ref SIN_DETECT_FREQ_BITS, 0 if not valid.
+    uint32_t divider;           //!< Sample rate divider, see @ref sin_detect_get_divider.
+} sin_detect_output_t;
+
+/**
+ * @brief   Sinusoidal signal frequency detection context, one per detected signal.
+ */
+typedef struct
+{
+    sin_detect_config_t config;                     //!< Configuration.
+    uint32_t period_scale;                          //!< Frequency reciprocal numerator, time units per s * cycles / 2.
+    uint32_t unit;                                  //!< Time counter units per second.
+    uint32_t zero_window;                           //!< Min. zero level tracking window, in time counter units.
+    uint32_t zero_timeout;                          //!< Max. zero level tracking window, in time counter units.
+    uint32_t timeout;                               //!< Signal loss timeout, in time counter units.
+    uint32_t rate_freq;                             //!< Frequency sampled by target samples per period at full rate.
+    uint32_t divider_target;                        //!< Sample rate divider that keeps target samples per period.
+    uint32_t divider_max;                           //!< Max. sample rate divider, band high frequency limits it.
+    sin_detect_data_t data;                         //!< Detection data. See @ref sin_detect_data_t.
+    filters_low_pass_t lp_filter;                   //!< Frequency low pass filter data.
+#if SIN_DETECT_ENGINE == SIN_DETECT_ENGINE_GOERTZEL
+    goertzel_t goertzel;                            //!< Goertzel filter bank data.
+#elif SIN_DETECT_ENGINE == SIN_DETECT_ENGINE_PLL
+    pll_t pll;                                      //!< Phase locked loop data.
+#elif SIN_DETECT_ENGINE == SIN_DETECT_ENGINE_YIN
+    yin_t yin;                                      //!< YIN period estimator data.
+#elif SIN_DETECT_ENGINE == SIN_DETECT_ENGINE_FFT
+    spectrum_t spectrum;                            //!< Spectral estimator data.
+    uint16_t block[2][SIN_DETECT_FFT_SIZE];         //!< Sample blocks, one is filled while other is processed.
+    int16_t fft_work[SIN_DETECT_FFT_SIZE];          //!< FFT work buffer.
+    volatile uint32_t block_active;                 //!< Index of block being filled.
+    volatile uint32_t block_fill;                   //!< Samples count in block being filled.
+#endif // SIN_DETECT_ENGINE
+#if SIN_DETECT_THREAD
+    sin_detect_hal_work_t work;                     //!< Block processing out of sampling interrupt.
+    volatile uint32_t block_cycles;                 //!< Time base counts spent on last block, see @ref sin_detect_hal_get_time.
+#endif // SIN_DETECT_THREAD
+} sin_detect_t;
 
 /**********************************************************************************************************************
  * Prototypes of exported constants
  *********************************************************************************************************************/
+/** Sinusoidal signal frequency detection configuration of ADC channel, band from 100 to 300 Hz on blue LED. */
+extern const sin_detect_config_t sin_detect_config_main;
 
 /**********************************************************************************************************************
  * Prototypes of exported variables
  *********************************************************************************************************************/
+/** Sinusoidal signal frequency detection of ADC channel. */
+extern sin_detect_t sin_detect_main;
 
 /**********************************************************************************************************************
  * Prototypes of exported functions
@@ -53,27 +181,131 @@ extern "C" {
 /**
  * @brief   Initialize sinusoidal signal frequency detection.
  *
+ * @note    Uses floating point math, do not call it from interrupt. Sampling has to be started by caller.
+ *          YIN engine buffers are sized at build time, it fails above @ref SIN_DETECT_RATE_MAX.
+ *
+ * @param   ctx     Pointer to detection context. See @ref sin_detect_t.
+ * @param   config  Pointer to detection configuration, it is copied to context. See @ref sin_detect_config_t.
+ *
  * @return  State of initialization
  * @retval  0   failed
  * @retval  1   success.
  */
-bool sin_detect_init(void);
+bool sin_detect_init(sin_detect_t *ctx, const sin_detect_config_t *config);
 
 /**
  * @brief   Process sinusoidal signal frequency detection.
  *
- * @note    This function must be called frequently. Frequency is defined by @ref SIN_DETECT_RATE.
+ * @note    This function must be called frequently. Frequency is defined by configured rate.
  *
+ * @param   ctx     Pointer to detection context. See @ref sin_detect_t.
  * @param   signal  Signal to process.
  */
-void sin_detect_process(uint32_t signal);
+void sin_detect_process(sin_detect_t *ctx, uint32_t signal);
+
+/**
+ * @brief   Process block of sinusoidal signal samples.
+ *
+ * @note    Same as calling @ref sin_detect_process for every sample, but LED is updated once per block.
+ *
+ * @param   ctx     Pointer to detection context. See @ref sin_detect_t.
+ * @param   samples Pointer to samples.
+ * @param   count   Samples count.
+ */
+void sin_detect_process_block(sin_detect_t *ctx, const uint16_t *samples, uint32_t count);
+
+/**
+ * @brief   Process sinusoidal signal sample taken at given time.
+ *
+ * @note    Period is measured from real time between samples, so sample rate may differ from configured one or
+ *          change at any time. Only zero crossing engine uses timestamps.
+ *
+ * @param   ctx     Pointer to detection context, configured with clock. See @ref sin_detect_t.
+ * @param   signal  Signal to process.
+ * @param   time    Sample timestamp, in configured clock ticks, free-running.
+ */
+void sin_detect_process_timed(sin_detect_t *ctx, uint32_t signal, uint32_t time);
+
+/**
+ * @brief   Process block of evenly spaced sinusoidal signal samples taken at given time.
+ *
+ * @param   ctx     Pointer to detection context, configured with clock. See @ref sin_detect_t.
+ * @param   samples Pointer to samples.
+ * @param   count   Samples count.
+ * @param   time    First sample timestamp, in configured clock ticks, free-running.
+ * @param   period  Time between samples, in configured clock ticks.
+ */
+void sin_detect_process_block_timed(sin_detect_t *ctx, const uint16_t *samples, uint32_t count, uint32_t time,
+                                    uint32_t period);
+
+/**
+ * @brief   Process zero crossing detected by hardware.
+ *
+ * @note    Used instead of samples. Zero level and hysteresis are set by hardware, so signal amplitude is not
+ *          checked. Rising and falling crossings alternate, crossing in the same direction as previous one means
+ *          that crossing between was missed, its half periods are dropped and measurement starts again from it.
+ *
+ * @param   ctx     Pointer to detection context, configured with clock. See @ref sin_detect_t.
+ * @param   time    Zero crossing timestamp, in configured clock ticks, free-running.
+ * @param   rising  Flag that shows if signal crossed zero level rising, true - rising, false - falling.
+ */
+void sin_detect_process_crossing(sin_detect_t *ctx, uint32_t time, bool rising);
+
+/**
+ * @brief   Check for signal loss when zero crossings are detected by hardware.
+ *
+ * @note    Must be called periodically, reaction time is configured timeout plus call period.
+ *
+ * @param   ctx     Pointer to detection context, configured with clock. See @ref sin_detect_t.
+ * @param   time    Current time, in configured clock ticks.
+ */
+void sin_detect_process_timeout(sin_detect_t *ctx, uint32_t time);
+
+/**
+ * @brief   Get sample rate divider that keeps configured samples per signal period.
+ *
+ * @note    Rate is full while there is no signal, so any frequency in band can be caught, and it is reduced only
+ *          with margin, so measured frequency noise does not toggle it.
+ *
+ * @param   ctx     Pointer to detection context. See @ref sin_detect_t.
+ *
+ * @return  Divider of configured rate, 1 - full rate.
+ */
+uint32_t sin_detect_get_divider(sin_detect_t *ctx);
+
+/**
+ * @brief   Get sinusoidal signal frequency.
+ *
+ * @note    Valid flag and frequency are read together in critical section, see @ref sin_detect_hal_lock.
+ *
+ * @param   ctx     Pointer to detection context. See @ref sin_detect_t.
+ * @param   freq    Pointer to frequency, see @ref SIN_DETECT_FREQ_BITS, 0 if there is no signal.
+ *
+ * @return  State of frequency.
+ * @retval  0   there is no signal, it was lost, is too weak or is not measured yet.
+ * @retval  1   frequency is valid.
+ */
+bool sin_detect_get_frequency(sin_detect_t *ctx, uint32_t *freq);
+
+/**
+ * @brief   Get sinusoidal signal frequency detection output.
+ *
+ * @note    Detection data is written by sampling interrupt or thread, output is copied in critical section, see
+ *          @ref sin_detect_hal_lock, so its fields are of the same sample. Call it from thread.
+ *
+ * @param   ctx     Pointer to detection context. See @ref sin_detect_t.
+ * @param   output  Pointer to output to fill. See @ref sin_detect_output_t.
+ */
+void sin_detect_get_output(sin_detect_t *ctx, sin_detect_output_t *output);
 
 /**
  * @brief   Debug sinusoidal signal frequency.
  *
  * @note Call it from the thread.
+ *
+ * @param   ctx     Pointer to detection context. See @ref sin_detect_t.
  */
-void sin_detect_debug(void);
+void sin_detect_debug(sin_detect_t *ctx);
 
 #ifdef __cplusplus
 }
@@ -0,0 +1,117 @@
+/**
+ **********************************************************************************************************************
+ * @file        sin_detect_hal.h
+ * @author      Diamond Sparrow
+ * @version     1.0.0.0
+ * @date        2026-10-16
+ * @brief       Sinusoidal signal frequency detection hardware abstraction C header file.
+ **********************************************************************************************************************
+ * @warning     THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR \n
+ *              IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND\n
+ *              FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR\n
+ *              CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL\n
+ *              DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,\n
+ *              DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN\n
+ *              CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF\n
+ *              THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ **********************************************************************************************************************
+ */
+
+#ifndef SIN_DETECT_HAL_H_
+#define SIN_DETECT_HAL_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**********************************************************************************************************************
+ * Includes
+ *********************************************************************************************************************/
+#include <stdint.h>
+#include <stdbool.h>
+
+/**********************************************************************************************************************
+ * Exported definitions and macros
+ *********************************************************************************************************************/
+#define SIN_DETECT_HAL_LED_NONE     UINT32_MAX  //!< No LED.
+
+/**********************************************************************************************************************
+ * Exported types
+ *********************************************************************************************************************/
+/**
+ * @brief   Deferred work, heavy processing out of sampling interrupt.
+ */
+typedef struct
+{
+    void (*func)(void *argument);   //!< Work function, runs once per signal.
+    void *argument;                 //!< Work function argument.
+    void *id;                       //!< Work runner id, thread on target.
+} sin_detect_hal_work_t;
+
+/**********************************************************************************************************************
+ * Prototypes of exported constants
+ *********************************************************************************************************************/
+
+/**********************************************************************************************************************
+ * Prototypes of exported variables
+ *********************************************************************************************************************/
+
+/**********************************************************************************************************************
+ * Prototypes of exported functions
+ *********************************************************************************************************************/
+/**
+ * @brief   Set detection LED.
+ *
+ * @param   led LED id, on target it is @ref gpio_id_t, ids out of range are ignored.
+ * @param   on  Flag that shows if LED is on.
+ */
+void sin_detect_hal_led(uint32_t led, bool on);
+
+/**
+ * @brief   Get time base count for profiling.
+ *
+ * @return  Free-running count, system timer cycles on target, ns on host.
+ */
+uint32_t sin_detect_hal_get_time(void);
+
+/**
+ * @brief   Enter critical section, detection data is not changed by sampling path till it is left.
+ *
+ * @note    Can be nested. On target interrupts are disabled, so threads are not switched either.
+ *
+ * @return  State to restore by @ref sin_detect_hal_unlock.
+ */
+uint32_t sin_detect_hal_lock(void);
+
+/**
+ * @brief   Leave critical section.
+ *
+ * @param   state   State returned by @ref sin_detect_hal_lock.
+ */
+void sin_detect_hal_unlock(uint32_t state);
+
+/**
+ * @brief   Start deferred work runner.
+ *
+ * @param   work    Pointer to work with function and argument set. See @ref sin_detect_hal_work_t.
+ *
+ * @return  State of start.
+ * @retval  0   failed.
+ * @retval  1   success.
+ */
+bool sin_detect_hal_work_start(sin_detect_hal_work_t *work);
+
+/**
+ * @brief   Signal deferred work to run.
+ *
+ * @note    Can be called from interrupt. On target work runs in thread later, on host it runs before return.
+ *
+ * @param   work    Pointer to started work. See @ref sin_detect_hal_work_t.
+ */
+void sin_detect_hal_work_signal(sin_detect_hal_work_t *work);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SIN_DETECT_HAL_H_ */
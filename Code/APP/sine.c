@@ -0,0 +1,101 @@
+/**
+ **********************************************************************************************************************
+ * @file        sine.c
+ * @author      Diamond Sparrow
+ * @version     1.0.0.0
+ * @date        2026-10-16
+ * @brief       Sine lookup table C source file.
+ **********************************************************************************************************************
+ * @warning     THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR \n
+ *              IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND\n
+ *              FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR\n
+ *              CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL\n
+ *              DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,\n
+ *              DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN\n
+ *              CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF\n
+ *              THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ **********************************************************************************************************************
+ */
+
+/**********************************************************************************************************************
+ * Includes
+ *********************************************************************************************************************/
+#include <stdint.h>
+
+#include "sine.h"
+
+/**********************************************************************************************************************
+ * Private constants
+ *********************************************************************************************************************/
+/** Quarter wave sine table in Q15, sin(2 * pi * i / 2^SINE_TABLE_BITS) for i = [0:2^SINE_TABLE_BITS / 4]. */
+static const int16_t sine_table[(1 << (SINE_TABLE_BITS - 2)) + 1] =
+{
+         0,    402,    804,   1206,   1608,   2009,   2411,   2811,
+      3212,   3612,   4011,   4410,   4808,   5205,   5602,   5998,
+      6393,   6787,   7180,   7571,   7962,   8351,   8740,   9127,
+      9512,   9896,  10279,  10660,  11039,  11417,  11793,  12167,
+     12540,  12910,  13279,  13646,  14010,  14373,  14733,  15091,
+     15447,  15800,  16151,  16500,  16846,  17190,  17531,  17869,
+     18205,  18538,  18868,  19195,  19520,  19841,  20160,  20475,
+     20788,  21097,  21403,  21706,  22006,  22302,  22595,  22884,
+     23170,  23453,  23732,  24008,  24279,  24548,  24812,  25073,
+     25330,  25583,  25833,  26078,  26320,  26557,  26791,  27020,
+     27246,  27467,  27684,  27897,  28106,  28311,  28511,  28707,
+     28899,  29086,  29269,  29448,  29622,  29792,  29957,  30118,
+     30274,  30425,  30572,  30715,  30853,  30986,  31114,  31238,
+     31357,  31471,  31581,  31686,  31786,  31881,  31972,  32058,
+     32138,  32214,  32286,  32352,  32413,  32470,  32522,  32568,
+     32610,  32647,  32679,  32706,  32729,  32746,  32758,  32766,
+     32767,
+};
+
+/**********************************************************************************************************************
+ * Private definitions and macros
+ *********************************************************************************************************************/
+#define SINE_QUARTER_SIZE   (1UL << (SINE_TABLE_BITS - 2))  //!< Points in quarter of turn.
+
+/**********************************************************************************************************************
+ * Private typedef
+ *********************************************************************************************************************/
+
+/**********************************************************************************************************************
+ * Private variables
+ *********************************************************************************************************************/
+
+/**********************************************************************************************************************
+ * Exported variables
+ *********************************************************************************************************************/
+
+/**********************************************************************************************************************
+ * Prototypes of local functions
+ *********************************************************************************************************************/
+
+/**********************************************************************************************************************
+ * Exported functions
+ *********************************************************************************************************************/
+int16_t sine_q15(uint32_t phase)
+{
+    uint32_t index = phase >> (32 - SINE_TABLE_BITS);
+    uint32_t i = index & (SINE_QUARTER_SIZE - 1);
+
+    switch(index >> (SINE_TABLE_BITS - 2))
+    {
+        case 0:
+            return sine_table[i];
+        case 1:
+            return sine_table[SINE_QUARTER_SIZE - i];
+        case 2:
+            return -sine_table[i];
+        default:
+            return -sine_table[SINE_QUARTER_SIZE - i];
+    }
+}
+
+int16_t sine_cos_q15(uint32_t phase)
+{
+    return sine_q15(phase + SINE_PHASE_QUARTER);
+}
+
+/**********************************************************************************************************************
+ * Private functions
+ *********************************************************************************************************************/
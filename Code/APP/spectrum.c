@@ -0,0 +1,209 @@
+/**
+ **********************************************************************************************************************
+ * @file        spectrum.c
+ * @author      Diamond Sparrow
+ * @version     1.0.0.0
+ * @date        2026-10-16
+ * @brief       Spectral frequency estimator C source file.
+ **********************************************************************************************************************
+ * @warning     THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR \n
+ *              IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND\n
+ *              FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR\n
+ *              CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL\n
+ *              DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,\n
+ *              DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN\n
+ *              CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF\n
+ *              THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ **********************************************************************************************************************
+ */
+
+/**********************************************************************************************************************
+ * Includes
+ *********************************************************************************************************************/
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "spectrum.h"
+#include "fft.h"
+#include "sine.h"
+
+/**********************************************************************************************************************
+ * Private constants
+ *********************************************************************************************************************/
+
+/**********************************************************************************************************************
+ * Private definitions and macros
+ *********************************************************************************************************************/
+#define SPECTRUM_INPUT_MAX      16384   //!< Maximal windowed input amplitude, leaves headroom for FFT.
+#define SPECTRUM_JACOBSEN_HANN  348     //!< Jacobsen interpolation factor for Hann window (1.36) in Q8.
+
+/**********************************************************************************************************************
+ * Private typedef
+ *********************************************************************************************************************/
+
+/**********************************************************************************************************************
+ * Private variables
+ *********************************************************************************************************************/
+
+/**********************************************************************************************************************
+ * Exported variables
+ *********************************************************************************************************************/
+
+/**********************************************************************************************************************
+ * Prototypes of local functions
+ *********************************************************************************************************************/
+/**
+ * @brief   Integer square root.
+ *
+ * @param   value   Value.
+ *
+ * @return  Square root of value, rounded down.
+ */
+static uint32_t spectrum_sqrt(uint32_t value);
+
+/**
+ * @brief   Power of complex FFT bin.
+ *
+ * @param   re  Real part in Q15.
+ * @param   im  Imaginary part in Q15.
+ *
+ * @return  Sum of squares, up to 2^31 for -32768 parts.
+ */
+static uint32_t spectrum_power(int16_t re, int16_t im);
+
+/**********************************************************************************************************************
+ * Exported functions
+ *********************************************************************************************************************/
+bool spectrum_init(spectrum_t *data, uint32_t size, float rate, float freq_low, uint32_t snr)
+{
+    if(size < 16 || size > SPECTRUM_SIZE_MAX || (size & (size - 1)) != 0)
+    {
+        return false;
+    }
+
+    data->size = size;
+    data->bin_width = (uint32_t)((rate * 65536.0F) / (float)size);
+    data->snr = snr;
+    // Hann window leaks DC into first two bins, skip them.
+    data->bin_low = (uint32_t)(freq_low * size / rate);
+    if(data->bin_low < 2)
+    {
+        data->bin_low = 2;
+    }
+
+    return true;
+}
+
+uint32_t spectrum_estimate(spectrum_t *data, const uint16_t *samples, int16_t *work)
+{
+    uint32_t i = 0;
+    uint32_t sum = 0;
+    uint32_t shift = 0;
+    uint32_t step = 0;
+    uint32_t peak = 0;
+    uint32_t power = 0;
+    uint32_t peak_power = 0;
+    uint32_t total = 0;
+    uint32_t bins = 0;
+    uint32_t mag[3] = {0};
+    int32_t mean = 0;
+    int32_t x = 0;
+    int32_t max = 0;
+    int32_t window = 0;
+    int32_t delta = 0;
+
+    // Remove DC and scale block up to use full Q15 range.
+    for(i = 0; i < data->size; i++)
+    {
+        sum += samples[i];
+    }
+    mean = (int32_t)(sum / data->size);
+    for(i = 0; i < data->size; i++)
+    {
+        x = (int32_t)samples[i] - mean;
+        x = (x < 0) ? -x : x;
+        if(x > max)
+        {
+            max = x;
+        }
+    }
+    while(max > 0 && (max << (shift + 1)) < SPECTRUM_INPUT_MAX)
+    {
+        shift++;
+    }
+
+    // Apply Hann window, 0.5 - 0.5 * cos(2 * pi * i / size).
+    step = 0x80000000UL / (data->size >> 1);
+    for(i = 0; i < data->size; i++)
+    {
+        window = (32768 - sine_cos_q15(i * step)) >> 1;
+        work[i] = (int16_t)(((((int32_t)samples[i] - mean) * (1L << shift)) * window) >> 15);
+    }
+
+    fft_rfft_q15(work, data->size);
+
+    // Find strongest bin.
+    for(i = data->bin_low; i < ((data->size >> 1) - 1); i++)
+    {
+        power = spectrum_power(work[2 * i], work[(2 * i) + 1]);
+        total += power >> 8;
+        bins++;
+        if(power > peak_power)
+        {
+            peak_power = power;
+            peak = i;
+        }
+    }
+
+    // Compare peak with mean power of bins, no tone - no frequency.
+    if(peak == 0 || ((peak_power >> 8) * bins) < (total * data->snr))
+    {
+        return 0;
+    }
+
+    // Jacobsen interpolation of magnitudes: delta = 1.36 * (|X[k+1]| - |X[k-1]|) / (|X[k-1]| + |X[k]| + |X[k+1]|).
+    for(i = 0; i < 3; i++)
+    {
+        x = 2 * (peak + i - 1);
+        mag[i] = spectrum_sqrt(spectrum_power(work[x], work[x + 1]));
+    }
+    delta = (SPECTRUM_JACOBSEN_HANN * ((int32_t)mag[2] - (int32_t)mag[0])) / (int32_t)(mag[0] + mag[1] + mag[2]);
+
+    return (uint32_t)(((uint64_t)(((int32_t)peak << 8) + delta) * data->bin_width) >> 8);
+}
+
+/**********************************************************************************************************************
+ * Private functions
+ *********************************************************************************************************************/
+static uint32_t spectrum_power(int16_t re, int16_t im)
+{
+    // Each square fits int32, but sum of two -32768 squares is 2^31, so it is summed unsigned.
+    return (uint32_t)((int32_t)re * re) + (uint32_t)((int32_t)im * im);
+}
+
+static uint32_t spectrum_sqrt(uint32_t value)
+{
+    uint32_t root = 0;
+    uint32_t bit = 1UL << 30;
+
+    while(bit > value)
+    {
+        bit >>= 2;
+    }
+
+    while(bit != 0)
+    {
+        if(value >= root + bit)
+        {
+            value -= root + bit;
+            root = (root >> 1) + bit;
+        }
+        else
+        {
+            root >>= 1;
+        }
+        bit >>= 2;
+    }
+
+    return root;
+}
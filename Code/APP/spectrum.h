@@ -0,0 +1,96 @@
+/**
+ **********************************************************************************************************************
+ * @file        spectrum.h
+ * @author      Diamond Sparrow
+ * @version     1.0.0.0
+ * @date        2026-10-16
+ * @brief       Spectral frequency estimator C header file.
+ **********************************************************************************************************************
+ * @warning     THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR \n
+ *              IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND\n
+ *              FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR\n
+ *              CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL\n
+ *              DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,\n
+ *              DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN\n
+ *              CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF\n
+ *              THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ **********************************************************************************************************************
+ */
+
+#ifndef SPECTRUM_H_
+#define SPECTRUM_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**********************************************************************************************************************
+ * Includes
+ *********************************************************************************************************************/
+#include <stdint.h>
+#include <stdbool.h>
+
+/**********************************************************************************************************************
+ * Exported constants
+ *********************************************************************************************************************/
+
+/**********************************************************************************************************************
+ * Exported definitions and macros
+ *********************************************************************************************************************/
+#define SPECTRUM_SIZE_MAX       512     //!< Maximum block size in samples.
+
+/**********************************************************************************************************************
+ * Exported types
+ *********************************************************************************************************************/
+/**
+ * @brief   Spectral frequency estimator data.
+ */
+typedef struct
+{
+    uint32_t size;      //!< Block size in samples, power of 2.
+    uint32_t bin_width; //!< Bin width in Hz, Q16.16.
+    uint32_t bin_low;   //!< First bin searched for peak.
+    uint32_t snr;       //!< Minimal ratio of peak bin power to mean bin power.
+} spectrum_t;
+
+/**********************************************************************************************************************
+ * Prototypes of exported variables
+ *********************************************************************************************************************/
+
+/**********************************************************************************************************************
+ * Prototypes of exported functions
+ *********************************************************************************************************************/
+/**
+ * @brief   Initialize spectral frequency estimator.
+ *
+ * @param   data        Pointer to spectral frequency estimator data. See @ref spectrum_t.
+ * @param   size        Block size in samples, power of 2, up to @ref SPECTRUM_SIZE_MAX.
+ * @param   rate        Sample rate in Hz.
+ * @param   freq_low    Lowest frequency searched for peak in Hz.
+ * @param   snr         Minimal ratio of peak bin power to mean bin power.
+ *
+ * @return  State of initialization.
+ * @retval  0   failed.
+ * @retval  1   success.
+ */
+bool spectrum_init(spectrum_t *data, uint32_t size, float rate, float freq_low, uint32_t snr);
+
+/**
+ * @brief   Estimate frequency of strongest tone in block of samples.
+ *
+ * @note    Block is Hann windowed and transformed by real FFT, peak bin is refined by Jacobsen interpolation of
+ *          neighbour bins magnitude. Call it from the thread, it takes whole FFT time.
+ *
+ * @param   data    Pointer to spectral frequency estimator data. See @ref spectrum_t.
+ * @param   samples Pointer to block of ADC samples.
+ * @param   work    Pointer to work buffer of block size.
+ *
+ * @return  Frequency in Hz, Q16.16, 0 if peak is below snr.
+ */
+uint32_t spectrum_estimate(spectrum_t *data, const uint16_t *samples, int16_t *work);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SPECTRUM_H_ */
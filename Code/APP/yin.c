@@ -0,0 +1,242 @@
+/**
+ **********************************************************************************************************************
+ * @file        yin.c
+ * @author      Diamond Sparrow
+ * @version     1.0.0.0
+ * @date        2026-10-16
+ * @brief       YIN period estimator C source file.
+ **********************************************************************************************************************
+ * @warning     THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR \n
+ *              IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND\n
+ *              FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR\n
+ *              CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL\n
+ *              DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,\n
+ *              DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN\n
+ *              CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF\n
+ *              THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ **********************************************************************************************************************
+ */
+
+
+/**********************************************************************************************************************
+ * Includes
+ *********************************************************************************************************************/
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+
+#include "yin.h"
+
+/**********************************************************************************************************************
+ * Private constants
+ *********************************************************************************************************************/
+
+/**********************************************************************************************************************
+ * Private definitions and macros
+ *********************************************************************************************************************/
+#define YIN_RING_MASK       (YIN_RING_SIZE - 1)     //!< Samples ring index mask.
+#define YIN_ONE             (1UL << YIN_FRAC_BITS)  //!< One of normalized difference.
+#define YIN_THRESHOLD       (YIN_ONE / 10)          //!< Dip threshold above deepest normalized difference (0.1).
+#define YIN_SUM_BITS        14                      //!< Significant bits of difference sum for normalization.
+
+/**********************************************************************************************************************
+ * Private typedef
+ *********************************************************************************************************************/
+
+/**********************************************************************************************************************
+ * Private variables
+ *********************************************************************************************************************/
+
+/**********************************************************************************************************************
+ * Exported variables
+ *********************************************************************************************************************/
+
+/**********************************************************************************************************************
+ * Prototypes of local functions
+ *********************************************************************************************************************/
+/**
+ * @brief   Accumulate samples to difference function of window.
+ *
+ * @param   data    Pointer to YIN period estimator data. See @ref yin_t.
+ * @param   head    Samples pushed to ring, accumulation stops before it.
+ * @param   slide   Flag that shows if samples leaving window should be removed.
+ */
+static void yin_update(yin_t *data, uint32_t head, bool slide);
+
+/**********************************************************************************************************************
+ * Exported functions
+ *********************************************************************************************************************/
+bool yin_init(yin_t *data, float rate, float freq_low, float freq_high, uint32_t window, uint32_t hop,
+              float confidence)
+{
+    memset(data, 0, sizeof(yin_t));
+
+    data->rate = (uint32_t)(rate * 65536.0F);
+    data->window = window;
+    data->hop = hop;
+    data->lag_min = (uint32_t)(rate / freq_high);
+    data->lag_max = (uint32_t)(rate / freq_low) + 1;
+    data->confidence_min = (uint32_t)(confidence * YIN_ONE);
+
+    // Interpolation needs neighbour lags, ring keeps window with its lags and two hops for interrupt to fill.
+    if(data->lag_min < 2 || data->lag_max > YIN_LAG_MAX || data->lag_min >= data->lag_max
+       || window == 0 || window > YIN_WINDOW_MAX || hop == 0
+       || (window + data->lag_max + 1 + (2 * hop)) > YIN_RING_SIZE)
+    {
+        return false;
+    }
+
+    return true;
+}
+
+bool yin_push(yin_t *data, uint32_t sample)
+{
+    data->ring[data->head & YIN_RING_MASK] = (uint16_t)sample;
+    data->head++;
+
+    if(++data->count >= data->hop)
+    {
+        data->count = 0;
+        return true;
+    }
+
+    return false;
+}
+
+uint32_t yin_estimate(yin_t *data)
+{
+    uint32_t head = data->head;
+    uint32_t lag = 0;
+    uint32_t best = 0;
+    uint32_t shift = 0;
+    uint32_t min = UINT32_MAX;
+    uint64_t sum = 0;
+    int64_t a = 0;
+    int64_t b = 0;
+    int64_t c = 0;
+    int32_t delta = 0;
+
+    if(head < (data->window + data->lag_max + 1))
+    {
+        // Not enough samples since start.
+        return 0;
+    }
+
+    if(data->tail == 0 || (head - data->tail) > (YIN_RING_SIZE - data->window - data->lag_max - 1 - data->hop))
+    {
+        // First run or samples were overwritten, recalculate whole window.
+        memset(data->diff, 0, sizeof(data->diff));
+        data->tail = head - data->window;
+        yin_update(data, head, false);
+    }
+    else
+    {
+        yin_update(data, head, true);
+    }
+
+    // Cumulative mean normalized difference, d'[k] = d[k] * k / (d[1] + ... + d[k]).
+    // Sums are scaled down to keep division in 32 bits.
+    for(lag = 1; lag <= (data->lag_max + 1); lag++)
+    {
+        sum += data->diff[lag];
+        while((sum >> shift) >= (1UL << YIN_SUM_BITS))
+        {
+            shift++;
+        }
+        if(lag >= (data->lag_min - 1))
+        {
+            data->cmnd[lag] = (sum == 0) ? YIN_ONE
+                              : (((data->diff[lag] >> shift) * lag) << YIN_FRAC_BITS) / (uint32_t)(sum >> shift);
+        }
+    }
+
+    // First dip close to the deepest one is the period, later ones are its multiples.
+    for(lag = data->lag_min; lag <= data->lag_max; lag++)
+    {
+        if(data->cmnd[lag] < min)
+        {
+            min = data->cmnd[lag];
+        }
+    }
+    for(lag = data->lag_min; lag <= data->lag_max; lag++)
+    {
+        if(data->cmnd[lag] <= (min + YIN_THRESHOLD))
+        {
+            // Normalized difference is coarse near zero, raw one finds bottom of dip.
+            while(lag < data->lag_max && data->diff[lag + 1] < data->diff[lag])
+            {
+                lag++;
+            }
+            best = lag;
+            break;
+        }
+    }
+
+    data->confidence = (data->cmnd[best] < YIN_ONE) ? (YIN_ONE - data->cmnd[best]) : 0;
+    if(best == 0 || data->confidence < data->confidence_min)
+    {
+        return 0;
+    }
+
+    // Parabolic interpolation of difference around dip: delta = (d[k-1] - d[k+1]) / (2 * (d[k-1] - 2 * d[k] + d[k+1])).
+    a = data->diff[best - 1];
+    b = data->diff[best];
+    c = data->diff[best + 1];
+    if((a + c - (2 * b)) > 0)
+    {
+        delta = (int32_t)(((a - c) * 128) / (a + c - (2 * b)));
+        if(delta > 128)
+        {
+            delta = 128;
+        }
+        else if(delta < -128)
+        {
+            delta = -128;
+        }
+    }
+
+    return (uint32_t)(((uint64_t)data->rate << 8) / (uint32_t)((int32_t)(best << 8) + delta));
+}
+
+/**********************************************************************************************************************
+ * Private functions
+ *********************************************************************************************************************/
+static void yin_update(yin_t *data, uint32_t head, bool slide)
+{
+    uint32_t lag = 0;
+    uint32_t lags = data->lag_max + 1;
+    uint32_t i = 0;
+    uint32_t j = 0;
+    int32_t x = 0;
+    int32_t y = 0;
+    int32_t dx = 0;
+    int32_t dy = 0;
+
+    // Sums are modulo 2^32, intermediate overflow cancels out as window sum itself always fits.
+    for(; data->tail != head; data->tail++)
+    {
+        i = data->tail;
+        x = data->ring[i & YIN_RING_MASK];
+        if(slide)
+        {
+            j = i - data->window;
+            y = data->ring[j & YIN_RING_MASK];
+            for(lag = 1; lag <= lags; lag++)
+            {
+                dx = x - data->ring[(i - lag) & YIN_RING_MASK];
+                dy = y - data->ring[(j - lag) & YIN_RING_MASK];
+                data->diff[lag] += (uint32_t)(dx * dx) - (uint32_t)(dy * dy);
+            }
+        }
+        else
+        {
+            for(lag = 1; lag <= lags; lag++)
+            {
+                dx = x - data->ring[(i - lag) & YIN_RING_MASK];
+                data->diff[lag] += (uint32_t)(dx * dx);
+            }
+        }
+    }
+
+    return;
+}
@@ -0,0 +1,123 @@
+/**
+ **********************************************************************************************************************
+ * @file        yin.h
+ * @author      Diamond Sparrow
+ * @version     1.0.0.0
+ * @date        2026-10-16
+ * @brief       YIN period estimator C header file.
+ **********************************************************************************************************************
+ * @warning     THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR \n
+ *              IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND\n
+ *              FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR\n
+ *              CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL\n
+ *              DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,\n
+ *              DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN\n
+ *              CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF\n
+ *              THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ **********************************************************************************************************************
+ */
+
+#ifndef YIN_H_
+#define YIN_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**********************************************************************************************************************
+ * Includes
+ *********************************************************************************************************************/
+#include <stdint.h>
+#include <stdbool.h>
+
+/**********************************************************************************************************************
+ * Exported constants
+ *********************************************************************************************************************/
+
+/**********************************************************************************************************************
+ * Exported definitions and macros
+ *********************************************************************************************************************/
+#define YIN_RING_SIZE       1024    //!< Samples ring size, power of two.
+#define YIN_WINDOW_MAX      256     //!< Maximal integration window, keeps 12 bit difference sums in 32 bits.
+#define YIN_LAG_MAX         208     //!< Maximal lag (signal period) in samples, 50 Hz at 10 kHz.
+#define YIN_FRAC_BITS       10      //!< Fractional bits of normalized difference and confidence.
+
+/**********************************************************************************************************************
+ * Exported types
+ *********************************************************************************************************************/
+/**
+ * @brief   YIN period estimator data.
+ */
+typedef struct
+{
+    uint32_t rate;                      //!< Sample rate in Hz, Q16.16.
+    uint32_t window;                    //!< Integration window in samples.
+    uint32_t hop;                       //!< Samples between estimates.
+    uint32_t lag_min;                   //!< Shortest period in samples.
+    uint32_t lag_max;                   //!< Longest period in samples.
+    uint32_t confidence_min;            //!< Minimal confidence, @ref YIN_FRAC_BITS fractional bits.
+    uint32_t confidence;                //!< Confidence of last estimate, 1 - aperiodicity, @ref YIN_FRAC_BITS.
+    uint32_t count;                     //!< Samples pushed since last hop.
+    volatile uint32_t head;             //!< Samples pushed to ring.
+    uint32_t tail;                      //!< Samples accumulated to difference function.
+    uint16_t ring[YIN_RING_SIZE];       //!< Samples ring.
+    uint32_t diff[YIN_LAG_MAX + 2];     //!< Difference function of window, index is lag.
+    uint32_t cmnd[YIN_LAG_MAX + 2];     //!< Cumulative mean normalized difference, @ref YIN_FRAC_BITS.
+} yin_t;
+
+/**********************************************************************************************************************
+ * Prototypes of exported variables
+ *********************************************************************************************************************/
+
+/**********************************************************************************************************************
+ * Prototypes of exported functions
+ *********************************************************************************************************************/
+/**
+ * @brief   Initialize YIN period estimator.
+ *
+ * @note    Uses floating point math, do not call it from interrupt.
+ *
+ * @param   data        Pointer to YIN period estimator data. See @ref yin_t.
+ * @param   rate        Sample rate in Hz.
+ * @param   freq_low    Lowest frequency in Hz.
+ * @param   freq_high   Highest frequency in Hz.
+ * @param   window      Integration window in samples, up to @ref YIN_WINDOW_MAX.
+ * @param   hop         Samples between estimates.
+ * @param   confidence  Minimal confidence of periodic signal, from 0 to 1.
+ *
+ * @return  State of initialization.
+ * @retval  0   failed.
+ * @retval  1   success.
+ */
+bool yin_init(yin_t *data, float rate, float freq_low, float freq_high, uint32_t window, uint32_t hop,
+              float confidence);
+
+/**
+ * @brief   Push one sample to YIN period estimator ring.
+ *
+ * @param   data    Pointer to YIN period estimator data. See @ref yin_t.
+ * @param   sample  ADC sample, up to 12 bits.
+ *
+ * @return  State of hop.
+ * @retval  0   hop is not finished yet.
+ * @retval  1   hop is finished, @ref yin_estimate should be called.
+ */
+bool yin_push(yin_t *data, uint32_t sample);
+
+/**
+ * @brief   Estimate signal frequency from samples pushed to ring.
+ *
+ * @note    Difference function is updated incrementally by samples pushed since last call, so cost is bounded by
+ *          samples count times lags count. If estimator lags behind too far, window is recalculated from scratch.
+ *
+ * @param   data    Pointer to YIN period estimator data. See @ref yin_t.
+ *
+ * @return  Frequency in Hz, Q16.16, 0 if signal is not periodic enough.
+ */
+uint32_t yin_estimate(yin_t *data);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* YIN_H_ */
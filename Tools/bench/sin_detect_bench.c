@@ -0,0 +1,639 @@
+/**
+ **********************************************************************************************************************
+ * @file        sin_detect_bench.c
+ * @author      Diamond Sparrow
+ * @version     1.0.0.0
+ * @date        2026-10-16
+ * @brief       Sinusoidal signal frequency detection engines and filters benchmark C source file.
+ **********************************************************************************************************************
+ * @warning     THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR \n
+ *              IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND\n
+ *              FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR\n
+ *              CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL\n
+ *              DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,\n
+ *              DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN\n
+ *              CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF\n
+ *              THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ **********************************************************************************************************************
+ */
+
+
+/**********************************************************************************************************************
+ * Includes
+ *********************************************************************************************************************/
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <getopt.h>
+
+#include "sin_detect.h"
+#include "filters.h"
+#include "goertzel.h"
+#include "pll.h"
+#include "spectrum.h"
+#include "yin.h"
+#include "waveform.h"
+
+/**********************************************************************************************************************
+ * Private definitions and macros
+ *********************************************************************************************************************/
+#define BENCH_TIME          10.0        //!< Default capture length in s.
+#define BENCH_REPEAT        5           //!< Default runs per benchmark, fastest is reported.
+#define BENCH_REPEAT_MAX    64          //!< Max. runs per benchmark.
+#define BENCH_THRESHOLD     20.0        //!< Default allowed slowdown against baseline in %, spread is added.
+#define BENCH_BASELINE_MAX  32          //!< Max. benchmarks in baseline.
+#define BENCH_NAME_MAX      32          //!< Max. benchmark name length.
+// Engine parameters mirror detection engine configuration in sin_detect.c.
+#define BENCH_GOERTZEL_BINS     16      //!< Goertzel bins count.
+#define BENCH_GOERTZEL_BLOCK    214     //!< Goertzel block size in samples, bins overlap at 5 kHz.
+#define BENCH_YIN_WINDOW        256     //!< YIN integration window in samples.
+#define BENCH_YIN_HOP           64      //!< YIN samples between estimates.
+
+/**********************************************************************************************************************
+ * Private typedef
+ *********************************************************************************************************************/
+/**
+ * @brief   Benchmark.
+ */
+typedef struct
+{
+    const char *name;                                       //!< Benchmark name.
+    size_t state;                                           //!< State size in bytes.
+    bool (*init)(void);                                     //!< Prepare state, NULL - none.
+    uint32_t (*run)(const uint16_t *samples, uint32_t count);   //!< Process capture, returns result to keep.
+} bench_t;
+
+/**
+ * @brief   Benchmark result.
+ */
+typedef struct
+{
+    const char *name;           //!< Benchmark name.
+    double ns_per_sample;       //!< Fastest run time per sample in ns.
+    double samples_per_s;       //!< Throughput of fastest run in samples per s.
+    double median;              //!< Median run time per sample in ns.
+    double spread;              //!< Median over fastest run in %, noise of measurement.
+    uint32_t allocations;       //!< Heap allocations during all runs.
+    size_t state;               //!< State size in bytes.
+} bench_result_t;
+
+/**
+ * @brief   Baseline entry.
+ */
+typedef struct
+{
+    char name[BENCH_NAME_MAX];  //!< Benchmark name.
+    double ns_per_sample;       //!< Time per sample in ns.
+    double spread;              //!< Median over fastest run in %, 0 if baseline has none.
+} bench_baseline_t;
+
+/**********************************************************************************************************************
+ * Private variables
+ *********************************************************************************************************************/
+/** Heap allocations count, detector code must not allocate. */
+static volatile uint32_t bench_allocations = 0;
+/** Results are summed here, so compiler can not drop the work. */
+static volatile uint32_t bench_sink = 0;
+/** Run times of benchmark in ns. */
+static uint64_t bench_times[BENCH_REPEAT_MAX];
+
+static sin_detect_t bench_detect;
+static filters_low_pass_t bench_low_pass;
+static goertzel_t bench_goertzel;
+static pll_t bench_pll;
+static spectrum_t bench_spectrum;
+static int16_t bench_spectrum_work[SIN_DETECT_FFT_SIZE];
+static yin_t bench_yin;
+
+/**********************************************************************************************************************
+ * Prototypes of local functions
+ *********************************************************************************************************************/
+static bool bench_detect_init(void);
+static uint32_t bench_detect_run(const uint16_t *samples, uint32_t count);
+static uint32_t bench_detect_block_run(const uint16_t *samples, uint32_t count);
+static bool bench_low_pass_init(void);
+static uint32_t bench_low_pass_run(const uint16_t *samples, uint32_t count);
+static bool bench_goertzel_init(void);
+static uint32_t bench_goertzel_run(const uint16_t *samples, uint32_t count);
+static bool bench_pll_init(void);
+static uint32_t bench_pll_run(const uint16_t *samples, uint32_t count);
+static bool bench_spectrum_init(void);
+static uint32_t bench_spectrum_run(const uint16_t *samples, uint32_t count);
+static bool bench_yin_init(void);
+static uint32_t bench_yin_run(const uint16_t *samples, uint32_t count);
+
+/**
+ * @brief   Get monotonic time.
+ *
+ * @return  Time in ns.
+ */
+static uint64_t bench_now(void);
+
+/**
+ * @brief   Run benchmark, fastest of repeated runs over capture is taken, median gives spread of runs.
+ *
+ * @param   bench   Pointer to benchmark. See @ref bench_t.
+ * @param   samples Capture.
+ * @param   count   Capture length in samples.
+ * @param   repeat  Runs count.
+ * @param   result  Pointer to result. See @ref bench_result_t.
+ *
+ * @return  State of run.
+ * @retval  0   benchmark init failed.
+ * @retval  1   success.
+ */
+static bool bench_run(const bench_t *bench, const uint16_t *samples, uint32_t count, uint32_t repeat,
+                      bench_result_t *result);
+
+/**
+ * @brief   Compare run times, for qsort.
+ *
+ * @param   a   Pointer to first time.
+ * @param   b   Pointer to second time.
+ *
+ * @return  Negative, 0 or positive as first time is less, equal or greater.
+ */
+static int bench_time_compare(const void *a, const void *b);
+
+/**
+ * @brief   Read baseline saved by earlier run, JSON or CSV.
+ *
+ * @param   path        Baseline file path.
+ * @param   baseline    Baseline entries.
+ *
+ * @return  Entries count, 0 if file can not be read.
+ */
+static uint32_t bench_baseline_read(const char *path, bench_baseline_t *baseline);
+
+/**
+ * @brief   Print usage.
+ *
+ * @param   name    Program name.
+ */
+static void bench_usage(const char *name);
+
+/**********************************************************************************************************************
+ * Private constants
+ *********************************************************************************************************************/
+/** Benchmarks, add new engines and filters here. */
+static const bench_t bench_list[] =
+{
+    {"sin_detect_process",       sizeof(bench_detect),   bench_detect_init,      bench_detect_run},
+    {"sin_detect_process_block", sizeof(bench_detect),   bench_detect_init,      bench_detect_block_run},
+    {"filters_low_pass",         sizeof(bench_low_pass), bench_low_pass_init,    bench_low_pass_run},
+    {"goertzel_process",         sizeof(bench_goertzel), bench_goertzel_init,    bench_goertzel_run},
+    {"pll_process",              sizeof(bench_pll),      bench_pll_init,         bench_pll_run},
+    {"spectrum_estimate",        sizeof(bench_spectrum) + sizeof(bench_spectrum_work),
+                                                         bench_spectrum_init,    bench_spectrum_run},
+    {"yin",                      sizeof(bench_yin),      bench_yin_init,         bench_yin_run},
+};
+
+/**********************************************************************************************************************
+ * Exported functions
+ *********************************************************************************************************************/
+/** Heap allocation wrappers, linked with --wrap, count every allocation made while benchmarks run. */
+void *__real_malloc(size_t size);
+void *__real_calloc(size_t n, size_t size);
+void *__real_realloc(void *ptr, size_t size);
+
+void *__wrap_malloc(size_t size)
+{
+    bench_allocations++;
+    return __real_malloc(size);
+}
+
+void *__wrap_calloc(size_t n, size_t size)
+{
+    bench_allocations++;
+    return __real_calloc(n, size);
+}
+
+void *__wrap_realloc(void *ptr, size_t size)
+{
+    bench_allocations++;
+    return __real_realloc(ptr, size);
+}
+
+int main(int argc, char **argv)
+{
+    static const struct option options[] =
+    {
+        {"time",        required_argument,  NULL, 't'},
+        {"repeat",      required_argument,  NULL, 'r'},
+        {"format",      required_argument,  NULL, 'f'},
+        {"output",      required_argument,  NULL, 'o'},
+        {"baseline",    required_argument,  NULL, 'b'},
+        {"threshold",   required_argument,  NULL, 'T'},
+        {"filter",      required_argument,  NULL, 'F'},
+        {"help",        no_argument,        NULL, 'h'},
+        {NULL,          0,                  NULL, 0},
+    };
+    const uint32_t benches = sizeof(bench_list) / sizeof(bench_list[0]);
+    waveform_config_t config =
+    {
+        .rate = SIN_DETECT_RATE,
+        .freq = 100.0,
+        .freq_end = 300.0,
+        .amplitude = 800.0,
+        .offset = 2048.0,
+        .noise = 2.0,
+    };
+    bench_result_t results[sizeof(bench_list) / sizeof(bench_list[0])];
+    bench_baseline_t baseline[BENCH_BASELINE_MAX];
+    uint32_t baseline_count = 0;
+    const char *format = "json";
+    const char *output = NULL;
+    const char *baseline_path = NULL;
+    const char *filter = NULL;
+    double threshold = BENCH_THRESHOLD;
+    double time = BENCH_TIME;
+    uint32_t repeat = BENCH_REPEAT;
+    uint32_t regressions = 0;
+    uint32_t done = 0;
+    uint16_t *samples = NULL;
+    uint32_t count = 0;
+    waveform_t wave;
+    FILE *out = stdout;
+    double change = 0;
+    double limit = 0;
+    uint32_t i = 0;
+    uint32_t j = 0;
+    int opt = 0;
+
+    while((opt = getopt_long(argc, argv, "t:r:f:o:b:T:F:h", options, NULL)) != -1)
+    {
+        switch(opt)
+        {
+            case 't': time = atof(optarg); break;
+            case 'r': repeat = (uint32_t)atoi(optarg); break;
+            case 'f': format = optarg; break;
+            case 'o': output = optarg; break;
+            case 'b': baseline_path = optarg; break;
+            case 'T': threshold = atof(optarg); break;
+            case 'F': filter = optarg; break;
+            case 'h':
+                bench_usage(argv[0]);
+                return 0;
+            default:
+                bench_usage(argv[0]);
+                return 1;
+        }
+    }
+    if(time <= 0 || repeat == 0 || repeat > BENCH_REPEAT_MAX || (strcmp(format, "json") != 0 && strcmp(format, "csv") != 0))
+    {
+        bench_usage(argv[0]);
+        return 1;
+    }
+    if(baseline_path != NULL && (baseline_count = bench_baseline_read(baseline_path, baseline)) == 0)
+    {
+        fprintf(stderr, "Can not read baseline %s.\n", baseline_path);
+        return 1;
+    }
+
+    // Capture sweeps over band, so every branch of detector runs.
+    count = (uint32_t)(time * config.rate);
+    config.sweep_time = time;
+    samples = malloc(count * sizeof(uint16_t));
+    if(samples == NULL || !waveform_init(&wave, &config))
+    {
+        fprintf(stderr, "Can not generate capture.\n");
+        return 1;
+    }
+    for(i = 0; i < count; i++)
+    {
+        samples[i] = (uint16_t)waveform_next(&wave);
+    }
+
+    for(i = 0; i < benches; i++)
+    {
+        if(filter != NULL && strstr(bench_list[i].name, filter) == NULL)
+        {
+            continue;
+        }
+        if(!bench_run(&bench_list[i], samples, count, repeat, &results[done]))
+        {
+            fprintf(stderr, "Benchmark %s init failed.\n", bench_list[i].name);
+            return 1;
+        }
+        done++;
+    }
+    free(samples);
+
+    if(output != NULL && (out = fopen(output, "w")) == NULL)
+    {
+        fprintf(stderr, "Can not write %s.\n", output);
+        return 1;
+    }
+    if(strcmp(format, "json") == 0)
+    {
+        // One benchmark per line, so results diff well and baseline is read back without JSON library.
+        fprintf(out, "[\n");
+        for(i = 0; i < done; i++)
+        {
+            fprintf(out, "  {\"name\": \"%s\", \"ns_per_sample\": %.3f, \"samples_per_s\": %.0f, \"allocations\": %lu, "
+                    "\"state_bytes\": %lu, \"median_ns\": %.3f, \"spread_pct\": %.1f}%s\n", results[i].name,
+                    results[i].ns_per_sample, results[i].samples_per_s, (unsigned long)results[i].allocations,
+                    (unsigned long)results[i].state, results[i].median, results[i].spread, (i + 1 < done) ? "," : "");
+        }
+        fprintf(out, "]\n");
+    }
+    else
+    {
+        fprintf(out, "name,ns_per_sample,samples_per_s,allocations,state_bytes,median_ns,spread_pct\n");
+        for(i = 0; i < done; i++)
+        {
+            fprintf(out, "%s,%.3f,%.0f,%lu,%lu,%.3f,%.1f\n", results[i].name, results[i].ns_per_sample,
+                    results[i].samples_per_s, (unsigned long)results[i].allocations, (unsigned long)results[i].state,
+                    results[i].median, results[i].spread);
+        }
+    }
+    if(out != stdout)
+    {
+        fclose(out);
+    }
+
+    // Comparison goes to stderr, so stdout stays machine-readable. Fastest runs are compared, as scheduler and cache
+    // noise only slows run down, and limit grows by spread of both runs, so noisy host does not report regression.
+    for(i = 0; i < done && baseline_count > 0; i++)
+    {
+        for(j = 0; j < baseline_count; j++)
+        {
+            if(strcmp(results[i].name, baseline[j].name) == 0)
+            {
+                break;
+            }
+        }
+        if(j == baseline_count || baseline[j].ns_per_sample <= 0)
+        {
+            fprintf(stderr, "%-26s %10.3f ns/sample, no baseline\n", results[i].name, results[i].ns_per_sample);
+            continue;
+        }
+        change = ((results[i].ns_per_sample / baseline[j].ns_per_sample) - 1.0) * 100.0;
+        limit = threshold + results[i].spread + baseline[j].spread;
+        fprintf(stderr, "%-26s %10.3f ns/sample, baseline %10.3f, %+6.1f%% (limit %.1f%%)%s\n", results[i].name,
+                results[i].ns_per_sample, baseline[j].ns_per_sample, change, limit, (change > limit) ? " SLOWER" : "");
+        if(change > limit)
+        {
+            regressions++;
+        }
+    }
+    for(i = 0; i < done; i++)
+    {
+        if(results[i].allocations > 0)
+        {
+            fprintf(stderr, "%s allocates on heap.\n", results[i].name);
+            regressions++;
+        }
+    }
+
+    return (regressions == 0) ? 0 : 2;
+}
+
+/**********************************************************************************************************************
+ * Private functions
+ *********************************************************************************************************************/
+static bool bench_detect_init(void)
+{
+    return sin_detect_init(&bench_detect, &sin_detect_config_main);
+}
+
+static uint32_t bench_detect_run(const uint16_t *samples, uint32_t count)
+{
+    uint32_t i = 0;
+
+    for(i = 0; i < count; i++)
+    {
+        sin_detect_process(&bench_detect, samples[i]);
+    }
+
+    return bench_detect.data.frequncy;
+}
+
+static uint32_t bench_detect_block_run(const uint16_t *samples, uint32_t count)
+{
+    // Block size of ADC DMA.
+    const uint32_t block = 64;
+    uint32_t i = 0;
+
+    for(i = 0; (i + block) <= count; i += block)
+    {
+        sin_detect_process_block(&bench_detect, &samples[i], block);
+    }
+    sin_detect_process_block(&bench_detect, &samples[i], count - i);
+
+    return bench_detect.data.frequncy;
+}
+
+static bool bench_low_pass_init(void)
+{
+    memset(&bench_low_pass, 0, sizeof(bench_low_pass));
+
+    return true;
+}
+
+static uint32_t bench_low_pass_run(const uint16_t *samples, uint32_t count)
+{
+    uint32_t i = 0;
+
+    for(i = 0; i < count; i++)
+    {
+        filters_low_pass(&bench_low_pass, (int32_t)samples[i] << 16, (uint32_t)(0.75F * FILTERS_CUT_OFF_ONE));
+    }
+
+    return (uint32_t)bench_low_pass.output;
+}
+
+static bool bench_goertzel_init(void)
+{
+    return goertzel_init(&bench_goertzel, SIN_DETECT_RATE, 50.0F, 400.0F, BENCH_GOERTZEL_BINS, BENCH_GOERTZEL_BLOCK);
+}
+
+static uint32_t bench_goertzel_run(const uint16_t *samples, uint32_t count)
+{
+    uint32_t freq = 0;
+    uint32_t i = 0;
+
+    for(i = 0; i < count; i++)
+    {
+        if(goertzel_process(&bench_goertzel, samples[i]))
+        {
+            freq += goertzel_peak(&bench_goertzel, 4, 50);
+        }
+    }
+
+    return freq;
+}
+
+static bool bench_pll_init(void)
+{
+    return pll_init(&bench_pll, SIN_DETECT_RATE, 20.0F, 600.0F, 5.0F);
+}
+
+static uint32_t bench_pll_run(const uint16_t *samples, uint32_t count)
+{
+    uint32_t locked = 0;
+    uint32_t i = 0;
+
+    for(i = 0; i < count; i++)
+    {
+        locked += pll_process(&bench_pll, samples[i]);
+    }
+
+    return locked + pll_frequency(&bench_pll);
+}
+
+static bool bench_spectrum_init(void)
+{
+    return spectrum_init(&bench_spectrum, SIN_DETECT_FFT_SIZE, SIN_DETECT_RATE, 20.0F, 12);
+}
+
+static uint32_t bench_spectrum_run(const uint16_t *samples, uint32_t count)
+{
+    uint32_t freq = 0;
+    uint32_t i = 0;
+
+    // Estimate cost is spread over block samples, as thread processes one block per block time.
+    for(i = 0; (i + SIN_DETECT_FFT_SIZE) <= count; i += SIN_DETECT_FFT_SIZE)
+    {
+        freq += spectrum_estimate(&bench_spectrum, &samples[i], bench_spectrum_work);
+    }
+
+    return freq;
+}
+
+static bool bench_yin_init(void)
+{
+    return yin_init(&bench_yin, SIN_DETECT_RATE, 50.0F, 500.0F, BENCH_YIN_WINDOW, BENCH_YIN_HOP, 0.5F);
+}
+
+static uint32_t bench_yin_run(const uint16_t *samples, uint32_t count)
+{
+    uint32_t freq = 0;
+    uint32_t i = 0;
+
+    for(i = 0; i < count; i++)
+    {
+        if(yin_push(&bench_yin, samples[i]))
+        {
+            freq += yin_estimate(&bench_yin);
+        }
+    }
+
+    return freq;
+}
+
+static uint64_t bench_now(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+
+    return ((uint64_t)ts.tv_sec * 1000000000ULL) + (uint64_t)ts.tv_nsec;
+}
+
+static bool bench_run(const bench_t *bench, const uint16_t *samples, uint32_t count, uint32_t repeat,
+                      bench_result_t *result)
+{
+    uint64_t best = 0;
+    uint64_t median = 0;
+    uint64_t start = 0;
+    uint32_t allocations = 0;
+    uint32_t i = 0;
+
+    allocations = bench_allocations;
+    for(i = 0; i < repeat; i++)
+    {
+        // Every run starts from same state, so runs are equal.
+        if(bench->init != NULL && !bench->init())
+        {
+            return false;
+        }
+        start = bench_now();
+        bench_sink += bench->run(samples, count);
+        bench_times[i] = bench_now() - start;
+    }
+    qsort(bench_times, repeat, sizeof(bench_times[0]), bench_time_compare);
+    best = bench_times[0];
+    median = bench_times[repeat / 2];
+
+    result->name = bench->name;
+    result->ns_per_sample = (double)best / count;
+    result->samples_per_s = (best > 0) ? ((double)count * 1e9 / (double)best) : 0;
+    result->median = (double)median / count;
+    result->spread = (best > 0) ? (((double)median / (double)best) - 1.0) * 100.0 : 0;
+    result->allocations = bench_allocations - allocations;
+    result->state = bench->state;
+
+    return true;
+}
+
+static int bench_time_compare(const void *a, const void *b)
+{
+    const uint64_t x = *(const uint64_t *)a;
+    const uint64_t y = *(const uint64_t *)b;
+
+    return (x > y) - (x < y);
+}
+
+static uint32_t bench_baseline_read(const char *path, bench_baseline_t *baseline)
+{
+    char line[256];
+    char *name = NULL;
+    char *value = NULL;
+    char *spread = NULL;
+    uint32_t count = 0;
+    FILE *in = NULL;
+
+    if((in = fopen(path, "r")) == NULL)
+    {
+        return 0;
+    }
+    while(count < BENCH_BASELINE_MAX && fgets(line, sizeof(line), in) != NULL)
+    {
+        if((name = strstr(line, "\"name\": \"")) != NULL && (value = strstr(line, "\"ns_per_sample\": ")) != NULL)
+        {
+            // JSON line written by this tool.
+            if(sscanf(name + 9, "%31[^\"]", baseline[count].name) == 1
+               && sscanf(value + 17, "%lf", &baseline[count].ns_per_sample) == 1)
+            {
+                // Baseline saved before spread was reported has none.
+                baseline[count].spread = 0;
+                if((spread = strstr(line, "\"spread_pct\": ")) != NULL)
+                {
+                    sscanf(spread + 14, "%lf", &baseline[count].spread);
+                }
+                count++;
+            }
+        }
+        else if(strchr(line, '{') == NULL && strchr(line, '[') == NULL
+                && sscanf(line, "%31[^,],%lf", baseline[count].name, &baseline[count].ns_per_sample) == 2)
+        {
+            // CSV line, header does not parse as number. Spread is last column, if present.
+            baseline[count].spread = 0;
+            sscanf(line, "%*[^,],%*f,%*f,%*u,%*u,%*f,%lf", &baseline[count].spread);
+            count++;
+        }
+    }
+    fclose(in);
+
+    return count;
+}
+
+static void bench_usage(const char *name)
+{
+    printf("Usage: %s [options], benchmarks detection engines and filters over synthetic capture.\n"
+           "  -t, --time S             capture length at %.0f Hz, default %.0f\n"
+           "  -r, --repeat N           runs per benchmark, fastest is reported, default %u, max. %u\n"
+           "  -f, --format json|csv    output format, default json\n"
+           "  -o, --output FILE        write results to file, e.g. to save baseline\n"
+           "  -b, --baseline FILE      compare with saved results, exit 2 on regression\n"
+           "  -T, --threshold PCT      allowed slowdown against baseline, spread of runs is added, default %.0f\n"
+           "  -F, --filter TEXT        run only benchmarks with name containing text\n",
+           name, (double)SIN_DETECT_RATE, BENCH_TIME, BENCH_REPEAT, BENCH_REPEAT_MAX,
+           BENCH_THRESHOLD);
+
+    return;
+}
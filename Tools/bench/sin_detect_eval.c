@@ -0,0 +1,1267 @@
+/**
+ **********************************************************************************************************************
+ * @file        sin_detect_eval.c
+ * @author      Diamond Sparrow
+ * @version     1.0.0.0
+ * @date        2026-10-16
+ * @brief       Sinusoidal signal frequency detection evaluation harness C source file.
+ **********************************************************************************************************************
+ * @warning     THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR \n
+ *              IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND\n
+ *              FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR\n
+ *              CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL\n
+ *              DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,\n
+ *              DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN\n
+ *              CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF\n
+ *              THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ **********************************************************************************************************************
+ */
+
+/**********************************************************************************************************************
+ * Includes
+ *********************************************************************************************************************/
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <string.h>
+#include <math.h>
+#include <getopt.h>
+
+#include "bsp/periph/adc.h"
+#include "sin_detect.h"
+#include "sin_detect_hal.h"
+#include "pll.h"
+#include "waveform.h"
+
+/**********************************************************************************************************************
+ * Private definitions and macros
+ *********************************************************************************************************************/
+// Crossing case, interpolated zero crossing settling and accuracy.
+#define EVAL_CROSSING_TIME      1.0     //!< Signal length in s.
+#define EVAL_CROSSING_STEADY    0.5     //!< Steady error is taken after this time in s.
+#define EVAL_CROSSING_AMPLITUDE 1500.0  //!< Signal amplitude in ADC counts.
+#define EVAL_CROSSING_NOISE     8.0     //!< Noise RMS in ADC counts.
+#define EVAL_CROSSING_LIMIT     2.0     //!< Error limit of settling in Hz, LED hysteresis.
+#define EVAL_CROSSING_SETTLE    0.05    //!< Max. settling time in s.
+#define EVAL_CROSSING_RMS       0.5     //!< Max. steady RMS error in Hz.
+// Baseline model, integer crossing counter detector the repository started with.
+#define EVAL_BASELINE_CYCLES    32      //!< Half periods accumulated before frequency is computed, one more counted.
+#define EVAL_BASELINE_CUTOFF    0.5     //!< Low pass filter coefficient.
+#define EVAL_BASELINE_ZERO      2048    //!< Fixed zero level, half of ADC range.
+// PLL case, frequency steps tracked by PLL and zero crossing engines, PLL parameters mirror sin_detect.c.
+#define EVAL_PLL_FREQ_MIN       20.0F   //!< PLL lowest tracked frequency in Hz.
+#define EVAL_PLL_FREQ_MAX       600.0F  //!< PLL highest tracked frequency in Hz.
+#define EVAL_PLL_BANDWIDTH      5.0F    //!< PLL loop bandwidth in Hz when locked.
+#define EVAL_PLL_STEP           1.0     //!< Frequency step time in s.
+#define EVAL_PLL_TIME           3.0     //!< Signal length in s.
+#define EVAL_PLL_STEADY         2.5     //!< Jitter is taken after this time in s.
+#define EVAL_PLL_LIMIT          2.0     //!< Error limit of settling in Hz, LED hysteresis.
+#define EVAL_PLL_SETTLE         0.2     //!< Max. settling time of clean signal in s.
+#define EVAL_PLL_SETTLE_NOISY   1.0     //!< Max. PLL settling time of noisy signal in s.
+#define EVAL_PLL_JITTER         0.3     //!< Max. PLL jitter, RMS error, in Hz.
+// DMA case, interrupts and CPU time of sampling chain with blocks moved by DMA against interrupt per sample.
+#define EVAL_DMA_TIME           3.0     //!< Signal length in s.
+#define EVAL_DMA_STEADY         2.0     //!< Interrupts are counted after this time in s.
+/** Samples of path comparison, whole blocks of signal length. */
+#define EVAL_DMA_SAMPLES        (((uint32_t)EVAL_DMA_TIME * (uint32_t)SIN_DETECT_RATE / ADC_DMA_BLOCK) * ADC_DMA_BLOCK)
+#define EVAL_DMA_REPEAT         5       //!< Timed runs of each path, fastest one is taken.
+#define EVAL_DMA_LOAD           1.25    //!< Max. CPU time of block path relative to sample path.
+/** Interrupt entry and return in core clock cycles, as m0_cost with 1 flash wait state. */
+#define EVAL_DMA_IRQ_CYCLES     31
+// Oversample case, boxcar decimation of oversampled conversions.
+#define EVAL_OVERSAMPLE_TIME    4.0     //!< Signal length in s.
+#define EVAL_OVERSAMPLE_STEADY  1.0     //!< Error is taken after this time in s.
+#define EVAL_OVERSAMPLE_GAIN    2.0     //!< Min. RMS error improvement at ADC_OVERSAMPLE, sqrt(8) expected.
+#define EVAL_OVERSAMPLE_BIAS    0.05    //!< Max. mean error in Hz.
+// Adaptive case, sample rate follows measured frequency.
+#define EVAL_ADAPTIVE_TIME      3.0     //!< Signal length in s.
+#define EVAL_ADAPTIVE_LOCK      0.5     //!< Invalid outputs are counted after this time in s.
+#define EVAL_ADAPTIVE_STEP      1.5     //!< Frequency step time in s.
+#define EVAL_ADAPTIVE_STEADY    2.5     //!< Error is taken after this time in s.
+#define EVAL_ADAPTIVE_SETTLE    0.2     //!< Max. settling time after step in s.
+#define EVAL_ADAPTIVE_RMS       0.2     //!< Max. RMS error at adaptive rate in Hz.
+#define EVAL_ADAPTIVE_TOGGLE    37      //!< Samples between forced rate changes.
+#define EVAL_ADAPTIVE_TOGGLE_RMS 1.0    //!< Max. RMS error with forced rate changes in Hz.
+// Layout case, per channel detector state against structure of arrays over channels.
+#define EVAL_LAYOUT_CHANNELS    4       //!< Channels scanned, most that fit at 5 kHz with oversampling.
+#define EVAL_LAYOUT_BLOCKS      78      //!< DMA blocks, 1 s at 5 kHz.
+#define EVAL_LAYOUT_REPEAT      20      //!< Passes over blocks per timed run.
+#define EVAL_LAYOUT_WINDOW      16      //!< Min. samples of zero level window, it ends on rising crossing.
+#define EVAL_LAYOUT_TIMEOUT     1000    //!< Max. samples of zero level window.
+
+/**********************************************************************************************************************
+ * Private typedef
+ *********************************************************************************************************************/
+/**
+ * @brief   Evaluation case.
+ */
+typedef struct
+{
+    const char *name;           //!< Case name.
+    const char *brief;          //!< What case reproduces.
+    void (*run)(void);          //!< Run case, prints table and records checks.
+} eval_t;
+
+/**
+ * @brief   Detection engine run by evaluation.
+ */
+typedef enum
+{
+    EVAL_ENGINE_ZERO_CROSS = 0,     //!< Zero crossing detector, sin_detect_process().
+    EVAL_ENGINE_PLL,                //!< Phase locked loop, pll_process().
+    EVAL_ENGINE_BASELINE,           //!< Baseline integer crossing counter. See @ref eval_baseline_t.
+} eval_engine_t;
+
+/**
+ * @brief   Baseline integer crossing counter, reference model of first sin_detect_frquency().
+ *
+ * @note    Crossings of fixed zero level are counted in whole samples, after more than
+ *          @ref EVAL_BASELINE_CYCLES half periods their mean gives frequency, that is low pass filtered from zero.
+ */
+typedef struct
+{
+    uint32_t last;              //!< Last sample.
+    uint32_t counter;           //!< Samples since last crossing.
+    uint32_t cycles;            //!< Half periods accumulated.
+    uint32_t accumulator;       //!< Samples of accumulated half periods.
+    double frequency;           //!< Filtered frequency in Hz, 0 till first computed.
+} eval_baseline_t;
+
+/**
+ * @brief   Frequency output tracking against known signal frequency.
+ */
+typedef struct
+{
+    double start;               //!< Time when signal frequency was set in s.
+    double steady;              //!< Time from which error is summed in s.
+    double limit;               //!< Error limit of settling in Hz.
+    double bad;                 //!< Time of last output outside of limit or not valid in s.
+    double sum;                 //!< Sum of squared steady errors.
+    uint32_t count;             //!< Steady outputs count.
+    uint32_t invalid;           //!< Steady outputs that are not valid.
+    double bias;                //!< Sum of steady errors.
+} eval_track_t;
+
+/**
+ * @brief   Hot zero crossing state of one channel, fields read and written on every sample as in sin_detect.c.
+ */
+typedef struct
+{
+    uint32_t last;              //!< Last sample.
+    uint32_t older;             //!< Sample before last.
+    uint32_t zero;              //!< Zero level.
+    uint32_t noise;             //!< Noise estimate, scaled by 16.
+    uint32_t min;               //!< Window minimum.
+    uint32_t max;               //!< Window maximum.
+    uint32_t window;            //!< Window samples.
+    uint32_t crossings;         //!< Half cycles seen.
+    uint32_t positive;          //!< Signal is above zero level, 1 - yes, 0 - no.
+} eval_layout_t;
+
+/**
+ * @brief   Hot zero crossing state of all channels as structure of arrays, one pass over sample updates channels
+ *          from adjacent words.
+ */
+typedef struct
+{
+    uint32_t last[EVAL_LAYOUT_CHANNELS];        //!< Last sample.
+    uint32_t older[EVAL_LAYOUT_CHANNELS];       //!< Sample before last.
+    uint32_t zero[EVAL_LAYOUT_CHANNELS];        //!< Zero level.
+    uint32_t noise[EVAL_LAYOUT_CHANNELS];       //!< Noise estimate, scaled by 16.
+    uint32_t min[EVAL_LAYOUT_CHANNELS];         //!< Window minimum.
+    uint32_t max[EVAL_LAYOUT_CHANNELS];         //!< Window maximum.
+    uint32_t window[EVAL_LAYOUT_CHANNELS];      //!< Window samples.
+    uint32_t crossings[EVAL_LAYOUT_CHANNELS];   //!< Half cycles seen.
+    uint32_t positive[EVAL_LAYOUT_CHANNELS];    //!< Signal is above zero level, 1 - yes, 0 - no.
+} eval_layout_soa_t;
+
+/**
+ * @brief   Sampling chain counters, DMA thread processes blocks, sample rate follows detector between blocks.
+ */
+typedef struct
+{
+    uint32_t blocks;            //!< Blocks processed from steady time.
+    uint32_t samples;           //!< Samples processed from steady time.
+    uint32_t divider;           //!< Sample rate divider at end.
+    uint32_t changes;           //!< Sample rate changes.
+} eval_chain_t;
+
+/**********************************************************************************************************************
+ * Private variables
+ *********************************************************************************************************************/
+/** Failed checks count. */
+static uint32_t eval_failed = 0;
+/** Block of sampling chain. */
+static uint16_t eval_block[ADC_DMA_BLOCK];
+/** Samples of DMA case, same for both paths. */
+static uint16_t eval_dma_samples[EVAL_DMA_SAMPLES];
+/** Interleaved conversions of layout case, in order of DMA buffer. */
+static uint16_t eval_layout_buffer[EVAL_LAYOUT_BLOCKS * ADC_DMA_BLOCK * EVAL_LAYOUT_CHANNELS];
+/** Output at end of each block of DMA case, per path. */
+static sin_detect_output_t eval_dma_output[2][EVAL_DMA_SAMPLES / ADC_DMA_BLOCK];
+
+/**********************************************************************************************************************
+ * Prototypes of local functions
+ *********************************************************************************************************************/
+/**
+ * @brief   Record check result.
+ *
+ * @param   ok      Check result.
+ * @param   name    Check name.
+ * @param   value   Value to print.
+ */
+static void eval_check(bool ok, const char *name, double value);
+
+/**
+ * @brief   Start tracking of frequency output.
+ *
+ * @param   track   Pointer to tracking. See @ref eval_track_t.
+ * @param   start   Time when signal frequency was set in s.
+ * @param   steady  Time from which error is summed in s.
+ * @param   limit   Error limit of settling in Hz.
+ */
+static void eval_track_init(eval_track_t *track, double start, double steady, double limit);
+
+/**
+ * @brief   Track frequency output.
+ *
+ * @param   track       Pointer to tracking. See @ref eval_track_t.
+ * @param   time        Output time in s.
+ * @param   valid       Flag that shows if output is valid.
+ * @param   measured    Measured frequency in Hz.
+ * @param   expected    Signal frequency in Hz.
+ */
+static void eval_track_update(eval_track_t *track, double time, bool valid, double measured, double expected);
+
+/**
+ * @brief   Get settling time, after it output stays valid and within limit.
+ *
+ * @param   track   Pointer to tracking. See @ref eval_track_t.
+ * @param   step    Time between outputs in s.
+ *
+ * @return  Settling time in s, negative if output did not settle before steady window.
+ */
+static double eval_track_settle(const eval_track_t *track, double step);
+
+/**
+ * @brief   Get RMS error of steady outputs.
+ *
+ * @param   track   Pointer to tracking. See @ref eval_track_t.
+ *
+ * @return  RMS error in Hz, infinite if any steady output is not valid.
+ */
+static double eval_track_rms(const eval_track_t *track);
+
+/**
+ * @brief   Process sample by baseline model.
+ *
+ * @param   base    Pointer to baseline model. See @ref eval_baseline_t.
+ * @param   sample  Sample in ADC counts.
+ * @param   rate    Sample rate in Hz.
+ */
+static void eval_baseline_process(eval_baseline_t *base, uint32_t sample, double rate);
+
+/**
+ * @brief   Feed signal sample by sample to detection engine and track its output against signal frequency.
+ *
+ * @param   engine  Detection engine. See @ref eval_engine_t.
+ * @param   config  Pointer to signal configuration, its rate is conversion rate. See @ref waveform_config_t.
+ * @param   count   Conversions averaged into one sample, as adc_decimate().
+ * @param   time    Signal length in s.
+ * @param   track   Pointer to tracking of output, started by caller. See @ref eval_track_t.
+ *
+ * @return  State of run.
+ * @retval  0   engine or signal init failed.
+ * @retval  1   success.
+ */
+static bool eval_run(eval_engine_t engine, const waveform_config_t *config, uint32_t count, double time,
+                     eval_track_t *track);
+
+/**
+ * @brief   Crossing case, settling time and steady error of interpolated zero crossing detector and baseline.
+ */
+static void eval_crossing(void);
+
+/**
+ * @brief   PLL case, settling time and jitter of PLL and zero crossing engines after frequency steps.
+ */
+static void eval_pll(void);
+
+/**
+ * @brief   Feed signal in blocks to detector, as DMA thread of adc.c does, and track its output.
+ *
+ * @note    Generator runs at full rate, divided rate takes every divider-th sample, as sampling timer would. Samples
+ *          are timestamped, rate changes between blocks only, as in DMA interrupt.
+ *
+ * @param   config      Pointer to signal configuration. See @ref waveform_config_t.
+ * @param   time        Signal length in s.
+ * @param   adaptive    Flag that shows if sample rate follows detector divider, false - full rate.
+ * @param   track       Pointer to tracking of output, once per block. See @ref eval_track_t.
+ * @param   chain       Pointer to chain counters. See @ref eval_chain_t.
+ *
+ * @return  State of run.
+ * @retval  0   detector or signal init failed.
+ * @retval  1   success.
+ */
+static bool eval_chain(const waveform_config_t *config, double time, bool adaptive, eval_track_t *track,
+                       eval_chain_t *chain);
+
+/**
+ * @brief   Run DMA case samples through sampling path once, output is saved at end of each block.
+ *
+ * @param   block   Flag that shows if samples are processed in blocks as DMA thread, false - one by one as ADC
+ *                  interrupt.
+ * @param   output  Pointer to outputs, one per block.
+ *
+ * @return  Run time in ns of host HAL time base, 0 if detector init failed.
+ */
+static uint32_t eval_dma_run(bool block, sin_detect_output_t *output);
+
+/**
+ * @brief   DMA case, sampling interrupts per second and CPU time of block path against interrupt per sample.
+ */
+static void eval_dma(void);
+
+/**
+ * @brief   Oversample case, frequency error with boxcar decimation of oversampled conversions, as in adc.c.
+ */
+static void eval_oversample(void);
+
+/**
+ * @brief   Adaptive case, sample rate chosen for frequency, frequency steps and forced rate changes.
+ */
+static void eval_adaptive(void);
+
+/**
+ * @brief   Run layout case buffer through per channel state, block by block after de-interleave, as DMA thread.
+ *
+ * @param   state   Pointer to channels state, one per channel. See @ref eval_layout_t.
+ *
+ * @return  Run time in ns of host HAL time base.
+ */
+static uint32_t eval_layout_aos(eval_layout_t *state);
+
+/**
+ * @brief   Run layout case buffer through structure of arrays state, one pass over each sample of all channels.
+ *
+ * @param   state   Pointer to channels state. See @ref eval_layout_soa_t.
+ *
+ * @return  Run time in ns of host HAL time base.
+ */
+static uint32_t eval_layout_soa(eval_layout_soa_t *state);
+
+/**
+ * @brief   Layout case, CPU time of per channel detector state against structure of arrays over channels.
+ */
+static void eval_layout(void);
+
+/**
+ * @brief   Print usage.
+ *
+ * @param   name    Program name.
+ */
+static void eval_usage(const char *name);
+
+/**********************************************************************************************************************
+ * Private constants
+ *********************************************************************************************************************/
+/** Evaluation cases, each one reproduces figures quoted for change it is named after. */
+static const eval_t eval_list[] =
+{
+    {"crossing",    "zero crossing vs baseline settling and error, 60 - 450 Hz", eval_crossing},
+    {"pll",         "PLL and zero crossing frequency steps, clean and noisy",   eval_pll},
+    {"dma",         "interrupts and CPU time of DMA blocks vs sample interrupt", eval_dma},
+    {"oversample",  "frequency error with boxcar decimation, 1 - 8 conversions", eval_oversample},
+    {"adaptive",    "sample rate following frequency, steps and rate changes",  eval_adaptive},
+    {"layout",      "per channel state vs structure of arrays, 4 channels",     eval_layout},
+};
+
+/**********************************************************************************************************************
+ * Exported functions
+ *********************************************************************************************************************/
+int main(int argc, char **argv)
+{
+    static const struct option options[] =
+    {
+        {"case",        required_argument,  NULL, 'c'},
+        {"list",        no_argument,        NULL, 'l'},
+        {"help",        no_argument,        NULL, 'h'},
+        {NULL,          0,                  NULL, 0},
+    };
+    const uint32_t cases = sizeof(eval_list) / sizeof(eval_list[0]);
+    const char *name = NULL;
+    uint32_t done = 0;
+    uint32_t i = 0;
+    int opt = 0;
+
+    while((opt = getopt_long(argc, argv, "c:lh", options, NULL)) != -1)
+    {
+        switch(opt)
+        {
+            case 'c': name = optarg; break;
+            case 'l':
+                for(i = 0; i < cases; i++)
+                {
+                    printf("%-12s %s\n", eval_list[i].name, eval_list[i].brief);
+                }
+                return 0;
+            case 'h':
+                eval_usage(argv[0]);
+                return 0;
+            default:
+                eval_usage(argv[0]);
+                return 1;
+        }
+    }
+
+    for(i = 0; i < cases; i++)
+    {
+        if(name != NULL && strcmp(eval_list[i].name, name) != 0)
+        {
+            continue;
+        }
+        printf("== %s: %s\n", eval_list[i].name, eval_list[i].brief);
+        eval_list[i].run();
+        done++;
+    }
+    if(done == 0)
+    {
+        fprintf(stderr, "No case %s.\n", name);
+        return 1;
+    }
+    printf("%s: %lu failed.\n", (eval_failed == 0) ? "PASS" : "FAIL", (unsigned long)eval_failed);
+
+    return (eval_failed == 0) ? 0 : 1;
+}
+
+/**********************************************************************************************************************
+ * Private functions
+ *********************************************************************************************************************/
+static void eval_check(bool ok, const char *name, double value)
+{
+    printf("%-4s %-36s %.4f\n", ok ? "ok" : "FAIL", name, value);
+    if(!ok)
+    {
+        eval_failed++;
+    }
+
+    return;
+}
+
+static void eval_track_init(eval_track_t *track, double start, double steady, double limit)
+{
+    memset(track, 0, sizeof(eval_track_t));
+    track->start = start;
+    track->steady = steady;
+    track->limit = limit;
+    track->bad = start;
+
+    return;
+}
+
+static void eval_track_update(eval_track_t *track, double time, bool valid, double measured, double expected)
+{
+    const double error = measured - expected;
+
+    if(time < track->start)
+    {
+        return;
+    }
+    if(!valid || fabs(error) > track->limit)
+    {
+        track->bad = time;
+    }
+    if(time >= track->steady)
+    {
+        if(valid)
+        {
+            track->sum += error * error;
+            track->bias += error;
+            track->count++;
+        }
+        else
+        {
+            track->invalid++;
+        }
+    }
+
+    return;
+}
+
+static double eval_track_settle(const eval_track_t *track, double step)
+{
+    if(track->bad >= track->steady)
+    {
+        return -1.0;
+    }
+
+    return (track->bad + step) - track->start;
+}
+
+static double eval_track_rms(const eval_track_t *track)
+{
+    if(track->invalid > 0 || track->count == 0)
+    {
+        return INFINITY;
+    }
+
+    return sqrt(track->sum / track->count);
+}
+
+static bool eval_run(eval_engine_t engine, const waveform_config_t *config, uint32_t count, double time,
+                     eval_track_t *track)
+{
+    const uint32_t samples = (uint32_t)((time * config->rate) / count);
+    sin_detect_output_t output = {0};
+    eval_baseline_t base = {0};
+    sin_detect_t detect;
+    pll_t pll;
+    waveform_t wave;
+    uint32_t sample = 0;
+    uint32_t i = 0;
+    uint32_t n = 0;
+    bool valid = false;
+    double freq = 0;
+
+    if(!waveform_init(&wave, config)
+       || (engine == EVAL_ENGINE_ZERO_CROSS && !sin_detect_init(&detect, &sin_detect_config_main))
+       || (engine == EVAL_ENGINE_PLL
+           && !pll_init(&pll, config->rate / count, EVAL_PLL_FREQ_MIN, EVAL_PLL_FREQ_MAX, EVAL_PLL_BANDWIDTH)))
+    {
+        return false;
+    }
+    for(i = 0; i < samples; i++)
+    {
+        // Rounded boxcar average of distinct conversions, as adc_decimate().
+        sample = 0;
+        for(n = 0; n < count; n++)
+        {
+            sample += waveform_next(&wave);
+        }
+        sample = (sample + (count / 2)) / count;
+        if(engine == EVAL_ENGINE_PLL)
+        {
+            // PLL reports frequency only while locked, as in sin_detect.c.
+            valid = pll_process(&pll, sample);
+            freq = (double)pll_frequency(&pll) / SIN_DETECT_FREQ_ONE;
+        }
+        else if(engine == EVAL_ENGINE_BASELINE)
+        {
+            // Baseline has no valid flag, LED followed any computed frequency.
+            eval_baseline_process(&base, sample, config->rate / count);
+            valid = (base.frequency != 0);
+            freq = base.frequency;
+        }
+        else
+        {
+            sin_detect_process(&detect, sample);
+            sin_detect_get_output(&detect, &output);
+            valid = output.valid;
+            freq = (double)output.frequency / SIN_DETECT_FREQ_ONE;
+        }
+        eval_track_update(track, waveform_time(&wave), valid, freq, waveform_frequency(&wave));
+    }
+
+    return true;
+}
+
+static void eval_baseline_process(eval_baseline_t *base, uint32_t sample, double rate)
+{
+    base->counter++;
+    if((base->last > EVAL_BASELINE_ZERO && sample <= EVAL_BASELINE_ZERO)
+       || (base->last < EVAL_BASELINE_ZERO && sample >= EVAL_BASELINE_ZERO))
+    {
+        base->cycles++;
+        base->accumulator += base->counter;
+        if(base->cycles > EVAL_BASELINE_CYCLES)
+        {
+            base->frequency += EVAL_BASELINE_CUTOFF
+                               * ((rate / (2.0 * ((double)base->accumulator / base->cycles))) - base->frequency);
+            base->cycles = 0;
+            base->accumulator = 0;
+        }
+        base->counter = 0;
+    }
+    base->last = sample;
+
+    return;
+}
+
+static void eval_crossing(void)
+{
+    static const double freq[] = {60.0, 100.0, 200.0, 333.0, 450.0};
+    waveform_config_t config =
+    {
+        .rate = SIN_DETECT_RATE,
+        .amplitude = EVAL_CROSSING_AMPLITUDE,
+        .offset = 2048.0,
+        .noise = EVAL_CROSSING_NOISE,
+    };
+    const double step = 1.0 / SIN_DETECT_RATE;
+    eval_track_t track[2];
+    double settle[2];
+    double rms[2];
+    char name[64];
+    uint32_t i = 0;
+    uint32_t e = 0;
+
+    // Not settled is printed as -1000 ms, error of output that is not valid as inf.
+    printf("%8s %10s %12s %14s %16s\n", "freq Hz", "settle ms", "rms err Hz", "base settle ms", "base rms err Hz");
+    for(i = 0; i < sizeof(freq) / sizeof(freq[0]); i++)
+    {
+        config.freq = freq[i];
+        for(e = 0; e < 2; e++)
+        {
+            eval_track_init(&track[e], 0, EVAL_CROSSING_STEADY, EVAL_CROSSING_LIMIT);
+            if(!eval_run((e == 0) ? EVAL_ENGINE_ZERO_CROSS : EVAL_ENGINE_BASELINE, &config, 1, EVAL_CROSSING_TIME,
+                         &track[e]))
+            {
+                eval_check(false, "init", freq[i]);
+                return;
+            }
+            settle[e] = eval_track_settle(&track[e], step);
+            rms[e] = eval_track_rms(&track[e]);
+        }
+        printf("%8.0f %10.1f %12.3f %14.1f %16.3f\n", freq[i], settle[0] * 1000.0, rms[0], settle[1] * 1000.0,
+               rms[1]);
+        snprintf(name, sizeof(name), "%.0f Hz settles", freq[i]);
+        eval_check(settle[0] >= 0 && settle[0] <= EVAL_CROSSING_SETTLE, name, settle[0] * 1000.0);
+        snprintf(name, sizeof(name), "%.0f Hz steady rms", freq[i]);
+        eval_check(rms[0] <= EVAL_CROSSING_RMS, name, rms[0]);
+        // Baseline that did not settle lost already, its steady error is only reported, at high frequency long
+        // average of baseline is quieter.
+        snprintf(name, sizeof(name), "%.0f Hz settles before baseline", freq[i]);
+        eval_check(settle[1] < 0 || settle[0] < settle[1], name, settle[1] * 1000.0);
+    }
+
+    return;
+}
+
+static void eval_pll(void)
+{
+    static const double steps[][2] =
+    {
+        {100.0, 300.0}, {300.0, 100.0}, {60.0, 200.0}, {200.0, 60.0}, {150.0, 250.0}, {250.0, 150.0}, {400.0, 120.0},
+    };
+    // Clean strong signal, and weak signal in heavy noise, SNR 11 dB.
+    static const double amplitude[] = {1000.0, 300.0};
+    static const double noise[] = {0, 60.0};
+    waveform_config_t config =
+    {
+        .rate = SIN_DETECT_RATE,
+        .sweep_start = EVAL_PLL_STEP,
+        .offset = 2048.0,
+        .seed = 1,
+    };
+    const double step = 1.0 / SIN_DETECT_RATE;
+    eval_track_t track[2];
+    double settle[2];
+    double jitter[2];
+    double pll_jitter_max = 0;
+    double cross_jitter_max = 0;
+    bool ok = true;
+    char name[64];
+    uint32_t i = 0;
+    uint32_t k = 0;
+    uint32_t e = 0;
+
+    for(k = 0; k < sizeof(amplitude) / sizeof(amplitude[0]); k++)
+    {
+        config.amplitude = amplitude[k];
+        config.noise = noise[k];
+        pll_jitter_max = 0;
+        cross_jitter_max = 0;
+        printf("amplitude %.0f, noise %.0f RMS\n%14s %12s %12s %14s %14s\n", amplitude[k], noise[k], "step Hz",
+               "PLL settle", "PLL jitter", "cross settle", "cross jitter");
+        for(i = 0; i < sizeof(steps) / sizeof(steps[0]); i++)
+        {
+            config.freq = steps[i][0];
+            config.freq_end = steps[i][1];
+            for(e = 0; e < 2; e++)
+            {
+                eval_track_init(&track[e], EVAL_PLL_STEP, EVAL_PLL_STEADY, EVAL_PLL_LIMIT);
+                ok = eval_run((e == 0) ? EVAL_ENGINE_PLL : EVAL_ENGINE_ZERO_CROSS, &config, 1, EVAL_PLL_TIME,
+                              &track[e]);
+                settle[e] = eval_track_settle(&track[e], step);
+                jitter[e] = eval_track_rms(&track[e]);
+            }
+            if(!ok)
+            {
+                eval_check(false, "init", steps[i][0]);
+                return;
+            }
+            // Not settled is printed as -1000 ms, jitter of output that is not valid as inf.
+            printf("%6.0f -> %5.0f %9.0f ms %9.2f Hz %11.0f ms %11.2f Hz\n", steps[i][0], steps[i][1],
+                   settle[0] * 1000.0, jitter[0], settle[1] * 1000.0, jitter[1]);
+            snprintf(name, sizeof(name), "%s PLL %.0f -> %.0f Hz settles", (k == 0) ? "clean" : "noisy", steps[i][0],
+                     steps[i][1]);
+            eval_check(settle[0] >= 0 && settle[0] <= ((k == 0) ? EVAL_PLL_SETTLE : EVAL_PLL_SETTLE_NOISY), name,
+                       settle[0] * 1000.0);
+            if(k == 0)
+            {
+                snprintf(name, sizeof(name), "clean cross %.0f -> %.0f Hz settles", steps[i][0], steps[i][1]);
+                eval_check(settle[1] >= 0 && settle[1] <= EVAL_PLL_SETTLE, name, settle[1] * 1000.0);
+            }
+            pll_jitter_max = fmax(pll_jitter_max, jitter[0]);
+            cross_jitter_max = fmax(cross_jitter_max, jitter[1]);
+        }
+        snprintf(name, sizeof(name), "%s PLL jitter max", (k == 0) ? "clean" : "noisy");
+        eval_check(pll_jitter_max <= EVAL_PLL_JITTER, name, pll_jitter_max);
+    }
+    // In noise PLL must beat zero crossing, which is the reason to have it.
+    eval_check(pll_jitter_max < cross_jitter_max, "noisy PLL jitter below cross", cross_jitter_max);
+
+    return;
+}
+
+static bool eval_chain(const waveform_config_t *config, double time, bool adaptive, eval_track_t *track,
+                       eval_chain_t *chain)
+{
+    const uint32_t step = (uint32_t)(SIN_DETECT_CLOCK / SIN_DETECT_RATE);
+    const uint64_t samples = (uint64_t)(time * SIN_DETECT_RATE);
+    sin_detect_output_t output = {0};
+    sin_detect_t detect;
+    waveform_t wave;
+    uint64_t n = 0;
+    uint32_t divider = 1;
+    uint32_t i = 0;
+    uint32_t j = 0;
+
+    memset(chain, 0, sizeof(eval_chain_t));
+    if(!waveform_init(&wave, config) || !sin_detect_init(&detect, &sin_detect_config_main))
+    {
+        return false;
+    }
+    while(n + (ADC_DMA_BLOCK * divider) <= samples)
+    {
+        for(i = 0; i < ADC_DMA_BLOCK; i++)
+        {
+            eval_block[i] = (uint16_t)waveform_next(&wave);
+            for(j = 1; j < divider; j++)
+            {
+                waveform_next(&wave);
+            }
+        }
+        sin_detect_process_block_timed(&detect, eval_block, ADC_DMA_BLOCK, (uint32_t)(n * step), step * divider);
+        n += ADC_DMA_BLOCK * divider;
+        sin_detect_get_output(&detect, &output);
+        eval_track_update(track, waveform_time(&wave), output.valid, (double)output.frequency / SIN_DETECT_FREQ_ONE,
+                          waveform_frequency(&wave));
+        if(waveform_time(&wave) >= track->steady)
+        {
+            chain->blocks++;
+            chain->samples += ADC_DMA_BLOCK;
+        }
+        if(adaptive && output.divider != 0 && output.divider != divider)
+        {
+            divider = output.divider;
+            chain->changes++;
+        }
+    }
+    chain->divider = divider;
+
+    return true;
+}
+
+static uint32_t eval_dma_run(bool block, sin_detect_output_t *output)
+{
+    const uint32_t step = (uint32_t)(SIN_DETECT_CLOCK / SIN_DETECT_RATE);
+    sin_detect_t detect;
+    uint32_t start = 0;
+    uint32_t n = 0;
+    uint32_t i = 0;
+
+    if(!sin_detect_init(&detect, &sin_detect_config_main))
+    {
+        return 0;
+    }
+    start = sin_detect_hal_get_time();
+    for(n = 0; n < EVAL_DMA_SAMPLES; n += ADC_DMA_BLOCK)
+    {
+        if(block)
+        {
+            sin_detect_process_block_timed(&detect, &eval_dma_samples[n], ADC_DMA_BLOCK, n * step, step);
+        }
+        else
+        {
+            for(i = n; i < (n + ADC_DMA_BLOCK); i++)
+            {
+                sin_detect_process_timed(&detect, eval_dma_samples[i], i * step);
+            }
+        }
+        sin_detect_get_output(&detect, &output[n / ADC_DMA_BLOCK]);
+    }
+
+    return sin_detect_hal_get_time() - start;
+}
+
+static void eval_dma(void)
+{
+    static const double freq[] = {100.0, 150.0, 300.0};
+    waveform_config_t config =
+    {
+        .rate = SIN_DETECT_RATE,
+        .amplitude = 800.0,
+        .offset = 2048.0,
+        .noise = 2.0,
+    };
+    const double window = EVAL_DMA_TIME - EVAL_DMA_STEADY;
+    eval_track_t track;
+    eval_chain_t chain;
+    waveform_t wave;
+    double time[2];
+    double irq[2];
+    uint32_t run = 0;
+    uint32_t differ = 0;
+    char name[64];
+    uint32_t i = 0;
+    uint32_t k = 0;
+    uint32_t e = 0;
+
+    // Same samples through interrupt per sample and DMA blocks, at full rate, fastest of runs is taken.
+    printf("block %u samples, host time per second of signal, interrupt entry and return %u cycles\n"
+           "%8s %12s %12s %14s %14s %12s %12s\n", ADC_DMA_BLOCK, EVAL_DMA_IRQ_CYCLES, "freq Hz", "sample IRQ/s",
+           "DMA IRQ/s", "sample us/s", "DMA us/s", "sample IRQ%", "DMA IRQ%");
+    for(i = 0; i < sizeof(freq) / sizeof(freq[0]); i++)
+    {
+        config.freq = freq[i];
+        if(!waveform_init(&wave, &config))
+        {
+            eval_check(false, "init", freq[i]);
+            return;
+        }
+        for(k = 0; k < EVAL_DMA_SAMPLES; k++)
+        {
+            eval_dma_samples[k] = (uint16_t)waveform_next(&wave);
+        }
+        for(e = 0; e < 2; e++)
+        {
+            time[e] = INFINITY;
+            for(k = 0; k < EVAL_DMA_REPEAT; k++)
+            {
+                run = eval_dma_run(e == 1, eval_dma_output[e]);
+                if(run == 0)
+                {
+                    eval_check(false, "init", freq[i]);
+                    return;
+                }
+                time[e] = fmin(time[e], (run * SIN_DETECT_RATE) / (EVAL_DMA_SAMPLES * 1000.0));
+            }
+        }
+        // Interrupt per sample without DMA, oversampling needs DMA.
+        irq[0] = SIN_DETECT_RATE;
+        irq[1] = SIN_DETECT_RATE / ADC_DMA_BLOCK;
+        differ = 0;
+        for(k = 0; k < (EVAL_DMA_SAMPLES / ADC_DMA_BLOCK); k++)
+        {
+            if(eval_dma_output[0][k].frequency != eval_dma_output[1][k].frequency
+               || eval_dma_output[0][k].valid != eval_dma_output[1][k].valid)
+            {
+                differ++;
+            }
+        }
+        printf("%8.0f %12.0f %12.1f %14.1f %14.1f %12.3f %12.3f\n", freq[i], irq[0], irq[1], time[0], time[1],
+               100.0 * irq[0] * EVAL_DMA_IRQ_CYCLES / SIN_DETECT_CLOCK,
+               100.0 * irq[1] * EVAL_DMA_IRQ_CYCLES / SIN_DETECT_CLOCK);
+        snprintf(name, sizeof(name), "%.0f Hz block output as sample", freq[i]);
+        eval_check(differ == 0, name, differ);
+        snprintf(name, sizeof(name), "%.0f Hz block time / sample", freq[i]);
+        eval_check(time[1] <= (EVAL_DMA_LOAD * time[0]), name, time[1] / time[0]);
+    }
+
+    // Adaptive rate divides sample rate, so blocks and their interrupts come less often at low frequency.
+    printf("oversample %u, adaptive rate\n%8s %8s %10s %14s %14s\n", ADC_OVERSAMPLE, "freq Hz", "divider", "rate Hz",
+           "DMA IRQ/s", "block time ms");
+    for(i = 0; i < sizeof(freq) / sizeof(freq[0]); i++)
+    {
+        config.freq = freq[i];
+        eval_track_init(&track, 0, EVAL_DMA_STEADY, EVAL_CROSSING_LIMIT);
+        if(!eval_chain(&config, EVAL_DMA_TIME, true, &track, &chain))
+        {
+            eval_check(false, "init", freq[i]);
+            return;
+        }
+        printf("%8.0f %8lu %10.0f %14.1f %14.1f\n", freq[i], (unsigned long)chain.divider, chain.samples / window,
+               chain.blocks / window, 1000.0 * window / chain.blocks);
+        snprintf(name, sizeof(name), "%.0f Hz adaptive valid", freq[i]);
+        eval_check(track.invalid == 0, name, track.invalid);
+    }
+
+    return;
+}
+
+static void eval_oversample(void)
+{
+    static const double freq[] = {100.0, 150.0, 250.0};
+    static const uint32_t count[] = {1, 2, 4, ADC_OVERSAMPLE};
+    const uint32_t counts = sizeof(count) / sizeof(count[0]);
+    // Weak signal, so ADC noise dominates error, timer runs at oversample times sample rate.
+    waveform_config_t config =
+    {
+        .amplitude = 200.0,
+        .offset = 2048.0,
+        .noise = 3.0,
+    };
+    eval_track_t track;
+    double rms[sizeof(count) / sizeof(count[0])];
+    double bias = 0;
+    char name[64];
+    uint32_t i = 0;
+    uint32_t k = 0;
+
+    printf("amplitude %.0f, noise %.0f RMS, RMS error in Hz\n%8s", config.amplitude, config.noise, "freq Hz");
+    for(k = 0; k < counts; k++)
+    {
+        printf(" %7s%-2lu", "N=", (unsigned long)count[k]);
+    }
+    printf(" %8s\n", "gain");
+    for(i = 0; i < sizeof(freq) / sizeof(freq[0]); i++)
+    {
+        printf("%8.0f", freq[i]);
+        for(k = 0; k < counts; k++)
+        {
+            config.freq = freq[i];
+            config.rate = SIN_DETECT_RATE * count[k];
+            eval_track_init(&track, 0, EVAL_OVERSAMPLE_STEADY, EVAL_CROSSING_LIMIT);
+            if(!eval_run(EVAL_ENGINE_ZERO_CROSS, &config, count[k], EVAL_OVERSAMPLE_TIME, &track))
+            {
+                eval_check(false, "init", freq[i]);
+                return;
+            }
+            rms[k] = eval_track_rms(&track);
+            printf(" %9.3f", rms[k]);
+            if(k == (counts - 1))
+            {
+                bias = (track.count > 0) ? (track.bias / track.count) : INFINITY;
+            }
+        }
+        printf(" %8.2f\n", rms[0] / rms[counts - 1]);
+        snprintf(name, sizeof(name), "%.0f Hz gain at N=%u", freq[i], ADC_OVERSAMPLE);
+        eval_check(rms[0] >= (EVAL_OVERSAMPLE_GAIN * rms[counts - 1]), name, rms[0] / rms[counts - 1]);
+        snprintf(name, sizeof(name), "%.0f Hz bias at N=%u", freq[i], ADC_OVERSAMPLE);
+        eval_check(fabs(bias) <= EVAL_OVERSAMPLE_BIAS, name, bias);
+    }
+
+    return;
+}
+
+static void eval_adaptive(void)
+{
+    static const double freq[] = {100.0, 150.0, 200.0, 250.0, 300.0};
+    // Divider keeps about 12 samples per period with 12.5% margin.
+    static const uint32_t divider[] = {3, 2, 1, 1, 1};
+    static const double steps[][2] = {{100.0, 300.0}, {300.0, 100.0}};
+    static const double toggle[] = {100.0, 200.0, 300.0};
+    const uint32_t step = (uint32_t)(SIN_DETECT_CLOCK / SIN_DETECT_RATE);
+    const uint32_t samples = (uint32_t)(EVAL_ADAPTIVE_TIME * SIN_DETECT_RATE);
+    waveform_config_t config =
+    {
+        .rate = SIN_DETECT_RATE,
+        .amplitude = 800.0,
+        .offset = 2048.0,
+        .noise = 2.0,
+    };
+    sin_detect_output_t output = {0};
+    eval_track_t track;
+    eval_track_t lock;
+    eval_chain_t chain;
+    sin_detect_t detect;
+    waveform_t wave;
+    double fixed = 0;
+    double rms = 0;
+    uint32_t rate_divider = 1;
+    uint32_t sample = 0;
+    uint32_t n = 0;
+    char name[64];
+    uint32_t i = 0;
+    uint32_t j = 0;
+
+    // Rate chosen for steady frequency.
+    printf("%8s %8s %10s\n", "freq Hz", "divider", "rate Hz");
+    for(i = 0; i < sizeof(freq) / sizeof(freq[0]); i++)
+    {
+        config.freq = freq[i];
+        eval_track_init(&track, 0, EVAL_ADAPTIVE_LOCK, EVAL_CROSSING_LIMIT);
+        if(!eval_chain(&config, EVAL_ADAPTIVE_TIME, true, &track, &chain))
+        {
+            eval_check(false, "init", freq[i]);
+            return;
+        }
+        printf("%8.0f %8lu %10.0f\n", freq[i], (unsigned long)chain.divider, SIN_DETECT_RATE / chain.divider);
+        snprintf(name, sizeof(name), "%.0f Hz divider", freq[i]);
+        eval_check(chain.divider == divider[i] && track.invalid == 0, name, chain.divider);
+    }
+
+    // Steps across rates, no output may be lost while rate changes.
+    config.sweep_start = EVAL_ADAPTIVE_STEP;
+    for(i = 0; i < sizeof(steps) / sizeof(steps[0]); i++)
+    {
+        config.freq = steps[i][0];
+        config.freq_end = steps[i][1];
+        eval_track_init(&lock, EVAL_ADAPTIVE_LOCK, EVAL_ADAPTIVE_LOCK, INFINITY);
+        eval_track_init(&track, EVAL_ADAPTIVE_STEP, EVAL_ADAPTIVE_STEADY, EVAL_CROSSING_LIMIT);
+        if(!eval_chain(&config, EVAL_ADAPTIVE_TIME, true, &lock, &chain)
+           || !eval_chain(&config, EVAL_ADAPTIVE_TIME, true, &track, &chain))
+        {
+            eval_check(false, "init", steps[i][0]);
+            return;
+        }
+        printf("step %.0f -> %.0f Hz: %lu rate changes, %lu invalid, settle %.1f ms, RMS error %.3f Hz\n",
+               steps[i][0], steps[i][1], (unsigned long)chain.changes, (unsigned long)lock.invalid,
+               eval_track_settle(&track, ADC_DMA_BLOCK / SIN_DETECT_RATE) * 1000.0, eval_track_rms(&track));
+        snprintf(name, sizeof(name), "step %.0f -> %.0f Hz no invalid", steps[i][0], steps[i][1]);
+        eval_check(lock.invalid == 0 && chain.changes > 0, name, lock.invalid);
+        snprintf(name, sizeof(name), "step %.0f -> %.0f Hz settles", steps[i][0], steps[i][1]);
+        eval_check(eval_track_settle(&track, ADC_DMA_BLOCK / SIN_DETECT_RATE) >= 0
+                   && eval_track_settle(&track, ADC_DMA_BLOCK / SIN_DETECT_RATE) <= EVAL_ADAPTIVE_SETTLE, name,
+                   eval_track_settle(&track, ADC_DMA_BLOCK / SIN_DETECT_RATE) * 1000.0);
+    }
+    config.sweep_start = 0;
+    config.freq_end = 0;
+
+    // Fewer samples per period at low rate cost some accuracy.
+    config.freq = 100.0;
+    eval_track_init(&track, 0, EVAL_ADAPTIVE_LOCK, EVAL_CROSSING_LIMIT);
+    if(!eval_chain(&config, EVAL_ADAPTIVE_TIME, false, &track, &chain))
+    {
+        eval_check(false, "init", config.freq);
+        return;
+    }
+    fixed = eval_track_rms(&track);
+    eval_track_init(&track, 0, EVAL_ADAPTIVE_LOCK, EVAL_CROSSING_LIMIT);
+    if(!eval_chain(&config, EVAL_ADAPTIVE_TIME, true, &track, &chain))
+    {
+        eval_check(false, "init", config.freq);
+        return;
+    }
+    rms = eval_track_rms(&track);
+    printf("100 Hz RMS error: fixed rate %.3f Hz, adaptive rate %.3f Hz\n", fixed, rms);
+    eval_check(rms <= EVAL_ADAPTIVE_RMS, "100 Hz adaptive rms", rms);
+
+    // Rate forced to change every few samples, timestamps must keep period exact across every change.
+    printf("%8s %18s\n", "freq Hz", "toggled RMS Hz");
+    for(i = 0; i < sizeof(toggle) / sizeof(toggle[0]); i++)
+    {
+        config.freq = toggle[i];
+        if(!waveform_init(&wave, &config) || !sin_detect_init(&detect, &sin_detect_config_main))
+        {
+            eval_check(false, "init", toggle[i]);
+            return;
+        }
+        eval_track_init(&track, 0, EVAL_ADAPTIVE_LOCK, EVAL_CROSSING_LIMIT);
+        rate_divider = 1;
+        n = 0;
+        for(j = 0; n < samples; j++)
+        {
+            if((j % EVAL_ADAPTIVE_TOGGLE) == 0)
+            {
+                rate_divider = 3 - rate_divider;
+            }
+            // Skipped conversions still advance the signal, timestamp is taken at the kept one.
+            sample = waveform_next(&wave);
+            sin_detect_process_timed(&detect, sample, n * step);
+            for(n++; (n % rate_divider) != 0; n++)
+            {
+                waveform_next(&wave);
+            }
+            sin_detect_get_output(&detect, &output);
+            eval_track_update(&track, (double)n / SIN_DETECT_RATE, output.valid,
+                              (double)output.frequency / SIN_DETECT_FREQ_ONE, toggle[i]);
+        }
+        rms = eval_track_rms(&track);
+        printf("%8.0f %18.3f\n", toggle[i], rms);
+        snprintf(name, sizeof(name), "%.0f Hz toggled rate rms", toggle[i]);
+        eval_check(rms <= EVAL_ADAPTIVE_TOGGLE_RMS, name, rms);
+    }
+
+    return;
+}
+
+static uint32_t eval_layout_aos(eval_layout_t *state)
+{
+    static uint16_t samples[EVAL_LAYOUT_CHANNELS][ADC_DMA_BLOCK];
+    const uint16_t *buffer = eval_layout_buffer;
+    eval_layout_t ch;
+    uint32_t start = sin_detect_hal_get_time();
+    uint32_t signal = 0;
+    uint32_t hys = 0;
+    uint32_t rising = 0;
+    int32_t diff = 0;
+    uint32_t n = 0;
+    uint32_t i = 0;
+    uint32_t k = 0;
+
+    for(n = 0; n < EVAL_LAYOUT_BLOCKS; n++)
+    {
+        for(i = 0; i < ADC_DMA_BLOCK; i++)
+        {
+            for(k = 0; k < EVAL_LAYOUT_CHANNELS; k++)
+            {
+                samples[k][i] = *buffer++;
+            }
+        }
+        // Each channel runs over its whole block, so its state stays in registers.
+        for(k = 0; k < EVAL_LAYOUT_CHANNELS; k++)
+        {
+            ch = state[k];
+            for(i = 0; i < ADC_DMA_BLOCK; i++)
+            {
+                signal = samples[k][i];
+                diff = (int32_t)signal + (int32_t)ch.older - (2 * (int32_t)ch.last);
+                ch.noise += (uint32_t)((diff < 0) ? -diff : diff) - (ch.noise >> 4);
+                hys = (3 * ch.noise) >> 5;
+                hys = (hys < 8) ? 8 : hys;
+                ch.min = (signal < ch.min) ? signal : ch.min;
+                ch.max = (signal > ch.max) ? signal : ch.max;
+                ch.window++;
+                rising = (!ch.positive && signal >= (ch.zero + hys));
+                if((ch.positive && (signal + hys) < ch.zero) || rising)
+                {
+                    ch.positive = rising;
+                    ch.crossings++;
+                }
+                if((rising && ch.window >= EVAL_LAYOUT_WINDOW) || ch.window >= EVAL_LAYOUT_TIMEOUT)
+                {
+                    ch.zero = (ch.min + ch.max) / 2;
+                    ch.min = signal;
+                    ch.max = signal;
+                    ch.window = 0;
+                }
+                ch.older = ch.last;
+                ch.last = signal;
+            }
+            state[k] = ch;
+        }
+    }
+
+    return sin_detect_hal_get_time() - start;
+}
+
+static uint32_t eval_layout_soa(eval_layout_soa_t *state)
+{
+    const uint16_t *buffer = eval_layout_buffer;
+    uint32_t start = sin_detect_hal_get_time();
+    uint32_t signal = 0;
+    uint32_t hys = 0;
+    uint32_t rising = 0;
+    int32_t diff = 0;
+    uint32_t n = 0;
+    uint32_t k = 0;
+
+    for(n = 0; n < (EVAL_LAYOUT_BLOCKS * ADC_DMA_BLOCK); n++)
+    {
+        // Conversions of one trigger update all channels in one pass.
+        for(k = 0; k < EVAL_LAYOUT_CHANNELS; k++)
+        {
+            signal = *buffer++;
+            diff = (int32_t)signal + (int32_t)state->older[k] - (2 * (int32_t)state->last[k]);
+            state->noise[k] += (uint32_t)((diff < 0) ? -diff : diff) - (state->noise[k] >> 4);
+            hys = (3 * state->noise[k]) >> 5;
+            hys = (hys < 8) ? 8 : hys;
+            state->min[k] = (signal < state->min[k]) ? signal : state->min[k];
+            state->max[k] = (signal > state->max[k]) ? signal : state->max[k];
+            state->window[k]++;
+            rising = (!state->positive[k] && signal >= (state->zero[k] + hys));
+            if((state->positive[k] && (signal + hys) < state->zero[k]) || rising)
+            {
+                state->positive[k] = rising;
+                state->crossings[k]++;
+            }
+            if((rising && state->window[k] >= EVAL_LAYOUT_WINDOW) || state->window[k] >= EVAL_LAYOUT_TIMEOUT)
+            {
+                state->zero[k] = (state->min[k] + state->max[k]) / 2;
+                state->min[k] = signal;
+                state->max[k] = signal;
+                state->window[k] = 0;
+            }
+            state->older[k] = state->last[k];
+            state->last[k] = signal;
+        }
+    }
+
+    return sin_detect_hal_get_time() - start;
+}
+
+static void eval_layout(void)
+{
+    static const double freq[EVAL_LAYOUT_CHANNELS] = {60.0, 150.0, 250.0, 450.0};
+    waveform_config_t config =
+    {
+        .rate = SIN_DETECT_RATE,
+        .amplitude = 800.0,
+        .offset = 2048.0,
+        .noise = 4.0,
+    };
+    eval_layout_t aos[EVAL_LAYOUT_CHANNELS];
+    eval_layout_soa_t soa;
+    waveform_t wave;
+    double time[2] = {INFINITY, INFINITY};
+    uint32_t differ = 0;
+    uint32_t n = 0;
+    uint32_t k = 0;
+    uint32_t r = 0;
+
+    for(k = 0; k < EVAL_LAYOUT_CHANNELS; k++)
+    {
+        config.freq = freq[k];
+        config.seed = k + 1;
+        if(!waveform_init(&wave, &config))
+        {
+            eval_check(false, "init", freq[k]);
+            return;
+        }
+        for(n = 0; n < (EVAL_LAYOUT_BLOCKS * ADC_DMA_BLOCK); n++)
+        {
+            eval_layout_buffer[(n * EVAL_LAYOUT_CHANNELS) + k] = (uint16_t)waveform_next(&wave);
+        }
+    }
+    // Fastest of runs is taken, each run passes buffer from the same start state.
+    for(n = 0; n < EVAL_DMA_REPEAT; n++)
+    {
+        for(k = 0; k < EVAL_LAYOUT_CHANNELS; k++)
+        {
+            aos[k] = (eval_layout_t){.last = 2048, .older = 2048, .zero = 2048, .min = 4095, .max = 0};
+            soa.last[k] = 2048;
+            soa.older[k] = 2048;
+            soa.zero[k] = 2048;
+            soa.noise[k] = 0;
+            soa.min[k] = 4095;
+            soa.max[k] = 0;
+            soa.window[k] = 0;
+            soa.crossings[k] = 0;
+            soa.positive[k] = 0;
+        }
+        for(r = 0; r < EVAL_LAYOUT_REPEAT; r++)
+        {
+            time[0] = fmin(time[0], eval_layout_aos(aos));
+            time[1] = fmin(time[1], eval_layout_soa(&soa));
+        }
+    }
+    printf("%u channels, %u samples each, half cycles seen\n%8s %12s %12s\n", EVAL_LAYOUT_CHANNELS,
+           EVAL_LAYOUT_BLOCKS * ADC_DMA_BLOCK, "freq Hz", "per channel", "SoA");
+    for(k = 0; k < EVAL_LAYOUT_CHANNELS; k++)
+    {
+        printf("%8.0f %12lu %12lu\n", freq[k], (unsigned long)aos[k].crossings, (unsigned long)soa.crossings[k]);
+        if(aos[k].crossings != soa.crossings[k] || aos[k].zero != soa.zero[k] || aos[k].noise != soa.noise[k])
+        {
+            differ++;
+        }
+    }
+    time[0] /= EVAL_LAYOUT_BLOCKS * ADC_DMA_BLOCK * EVAL_LAYOUT_CHANNELS;
+    time[1] /= EVAL_LAYOUT_BLOCKS * ADC_DMA_BLOCK * EVAL_LAYOUT_CHANNELS;
+    printf("host time per sample of one channel: per channel blocks %.2f ns, structure of arrays %.2f ns, ratio %.2f\n",
+           time[0], time[1], time[1] / time[0]);
+    eval_check(differ == 0, "layouts give same state", differ);
+
+    return;
+}
+
+static void eval_usage(const char *name)
+{
+    printf("Usage: %s [options], reproduces detector figures on synthetic signals, exit 1 if any check fails.\n"
+           "  -c, --case NAME          run only named case, default all\n"
+           "  -l, --list               list cases\n",
+           name);
+
+    return;
+}
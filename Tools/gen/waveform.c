@@ -0,0 +1,217 @@
+/**
+ **********************************************************************************************************************
+ * @file        waveform.c
+ * @author      Diamond Sparrow
+ * @version     1.0.0.0
+ * @date        2026-10-16
+ * @brief       Synthetic ADC sample stream generator C source file.
+ **********************************************************************************************************************
+ * @warning     THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR \n
+ *              IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND\n
+ *              FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR\n
+ *              CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL\n
+ *              DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,\n
+ *              DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN\n
+ *              CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF\n
+ *              THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ **********************************************************************************************************************
+ */
+
+
+/**********************************************************************************************************************
+ * Includes
+ *********************************************************************************************************************/
+#include <stdint.h>
+#include <stdbool.h>
+#include <math.h>
+
+#include "waveform.h"
+
+/**********************************************************************************************************************
+ * Private definitions and macros
+ *********************************************************************************************************************/
+#define WAVEFORM_SEED           0x12345678UL    //!< Default noise generator seed.
+
+/**********************************************************************************************************************
+ * Prototypes of local functions
+ *********************************************************************************************************************/
+/**
+ * @brief   Get frequency at given time by sweep configuration.
+ *
+ * @param   config  Pointer to configuration. See @ref waveform_config_t.
+ * @param   t       Time in s.
+ *
+ * @return  Frequency in Hz.
+ */
+static double waveform_sweep(const waveform_config_t *config, double t);
+
+/**
+ * @brief   Get uniform random number, xorshift32.
+ *
+ * @param   wave    Pointer to generator. See @ref waveform_t.
+ *
+ * @return  Random number in (0, 1].
+ */
+static double waveform_uniform(waveform_t *wave);
+
+/**
+ * @brief   Get normal random number, Box-Muller transform.
+ *
+ * @param   wave    Pointer to generator. See @ref waveform_t.
+ *
+ * @return  Normal deviate, zero mean, unit variance.
+ */
+static double waveform_gauss(waveform_t *wave);
+
+/**********************************************************************************************************************
+ * Exported functions
+ *********************************************************************************************************************/
+bool waveform_init(waveform_t *wave, const waveform_config_t *config)
+{
+    if(config->rate <= 0 || config->freq < 0 || config->freq_end < 0 || config->sweep_start < 0
+       || config->sweep_time < 0 || config->amplitude < 0 || config->noise < 0 || config->bits > WAVEFORM_BITS
+       || config->dropout_start < 0 || config->dropout_time < 0)
+    {
+        return false;
+    }
+
+    wave->config = *config;
+    if(wave->config.bits == 0)
+    {
+        wave->config.bits = WAVEFORM_BITS;
+    }
+    if(wave->config.freq_end == 0)
+    {
+        wave->config.freq_end = wave->config.freq;
+    }
+    wave->n = 0;
+    wave->phase = 0;
+    wave->freq = 0;
+    wave->random = (config->seed != 0) ? config->seed : WAVEFORM_SEED;
+    wave->spare_valid = false;
+    wave->spare = 0;
+
+    return true;
+}
+
+uint32_t waveform_next(waveform_t *wave)
+{
+    const waveform_config_t *config = &wave->config;
+    double t = (double)wave->n / config->rate;
+    double signal = 0;
+    double lsb = (double)(1UL << (WAVEFORM_BITS - config->bits));
+    uint32_t i = 0;
+
+    // Phase is integrated over frequency, so sweep and step are continuous.
+    wave->freq = waveform_sweep(config, t);
+    if(wave->n > 0)
+    {
+        wave->phase += wave->freq / config->rate;
+        wave->phase -= floor(wave->phase);
+    }
+    wave->n++;
+
+    if(config->dropout_time > 0 && t >= config->dropout_start && t < (config->dropout_start + config->dropout_time))
+    {
+        signal = 0;
+    }
+    else
+    {
+        signal = sin(2.0 * M_PI * wave->phase);
+        for(i = 0; i < WAVEFORM_HARMONICS_MAX; i++)
+        {
+            if(config->harmonic[i] != 0)
+            {
+                signal += config->harmonic[i] * sin(2.0 * M_PI * (i + 2) * wave->phase);
+            }
+        }
+        signal *= config->amplitude;
+    }
+    signal += config->offset;
+    if(config->noise > 0)
+    {
+        signal += config->noise * waveform_gauss(wave);
+    }
+
+    // Quantize to effective bits, keep ADC scale.
+    signal = floor((signal / lsb) + 0.5) * lsb;
+    if(signal < 0)
+    {
+        signal = 0;
+    }
+    if(signal > WAVEFORM_MAX)
+    {
+        signal = WAVEFORM_MAX;
+    }
+
+    return (uint32_t)signal;
+}
+
+double waveform_time(const waveform_t *wave)
+{
+    return (wave->n > 0) ? ((double)(wave->n - 1) / wave->config.rate) : 0;
+}
+
+double waveform_frequency(const waveform_t *wave)
+{
+    const waveform_config_t *config = &wave->config;
+    double t = waveform_time(wave);
+
+    if(config->dropout_time > 0 && t >= config->dropout_start && t < (config->dropout_start + config->dropout_time))
+    {
+        return 0;
+    }
+
+    return wave->freq;
+}
+
+double waveform_noise_from_snr(double amplitude, double snr)
+{
+    // Sine power is amplitude^2 / 2.
+    return (amplitude / sqrt(2.0)) / pow(10.0, snr / 20.0);
+}
+
+/**********************************************************************************************************************
+ * Private functions
+ *********************************************************************************************************************/
+static double waveform_sweep(const waveform_config_t *config, double t)
+{
+    if(t < config->sweep_start)
+    {
+        return config->freq;
+    }
+    if(t >= (config->sweep_start + config->sweep_time))
+    {
+        return config->freq_end;
+    }
+
+    return config->freq + ((config->freq_end - config->freq) * (t - config->sweep_start) / config->sweep_time);
+}
+
+static double waveform_uniform(waveform_t *wave)
+{
+    wave->random ^= wave->random << 13;
+    wave->random ^= wave->random >> 17;
+    wave->random ^= wave->random << 5;
+
+    return ((double)wave->random + 1.0) / 4294967296.0;
+}
+
+static double waveform_gauss(waveform_t *wave)
+{
+    double r = 0;
+    double a = 0;
+
+    if(wave->spare_valid)
+    {
+        wave->spare_valid = false;
+        return wave->spare;
+    }
+
+    r = sqrt(-2.0 * log(waveform_uniform(wave)));
+    a = 2.0 * M_PI * waveform_uniform(wave);
+    wave->spare = r * sin(a);
+    wave->spare_valid = true;
+
+    return r * cos(a);
+}
@@ -0,0 +1,138 @@
+/**
+ **********************************************************************************************************************
+ * @file        waveform.h
+ * @author      Diamond Sparrow
+ * @version     1.0.0.0
+ * @date        2026-10-16
+ * @brief       Synthetic ADC sample stream generator C header file.
+ **********************************************************************************************************************
+ * @warning     THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR \n
+ *              IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND\n
+ *              FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR\n
+ *              CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL\n
+ *              DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,\n
+ *              DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN\n
+ *              CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF\n
+ *              THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ **********************************************************************************************************************
+ */
+
+
+#ifndef WAVEFORM_H_
+#define WAVEFORM_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**********************************************************************************************************************
+ * Includes
+ *********************************************************************************************************************/
+#include <stdint.h>
+#include <stdbool.h>
+
+/**********************************************************************************************************************
+ * Exported definitions and macros
+ *********************************************************************************************************************/
+#define WAVEFORM_BITS           12      //!< ADC resolution in bits.
+#define WAVEFORM_MAX            ((1UL << WAVEFORM_BITS) - 1)    //!< Max. sample value.
+#define WAVEFORM_HARMONICS_MAX  8       //!< Max. harmonics count, 2nd to 9th.
+
+/**********************************************************************************************************************
+ * Exported types
+ *********************************************************************************************************************/
+/**
+ * @brief   Waveform configuration.
+ *
+ * @note    Frequency is constant till sweep start, then goes linearly to end frequency over sweep time, step if sweep
+ *          time is 0, and stays there. Signal is sine plus harmonics, noise is added after it, sum is quantized and
+ *          clipped to ADC range.
+ */
+typedef struct
+{
+    double rate;                                //!< Sample rate in Hz.
+    double freq;                                //!< Frequency in Hz.
+    double freq_end;                            //!< Frequency after sweep in Hz, 0 - no sweep.
+    double sweep_start;                         //!< Sweep start in s.
+    double sweep_time;                          //!< Sweep duration in s, 0 - step.
+    double amplitude;                           //!< Fundamental amplitude, peak, in ADC counts.
+    double offset;                              //!< DC offset in ADC counts.
+    double noise;                               //!< Gaussian noise RMS in ADC counts.
+    double harmonic[WAVEFORM_HARMONICS_MAX];    //!< Harmonic amplitudes, from 2nd, relative to fundamental.
+    uint32_t bits;                              //!< Effective bits of quantization, 0 - @ref WAVEFORM_BITS.
+    double dropout_start;                       //!< Dropout start in s, signal is gone, offset and noise stay.
+    double dropout_time;                        //!< Dropout duration in s, 0 - none.
+    uint32_t seed;                              //!< Noise generator seed, 0 - default.
+} waveform_config_t;
+
+/**
+ * @brief   Waveform generator state.
+ */
+typedef struct
+{
+    waveform_config_t config;   //!< Configuration. See @ref waveform_config_t.
+    uint64_t n;                 //!< Next sample index.
+    double phase;               //!< Fundamental phase in turns, 0 - 1.
+    double freq;                //!< Frequency of last sample in Hz.
+    uint32_t random;            //!< Noise generator state.
+    bool spare_valid;           //!< Flag that shows if spare normal deviate is valid.
+    double spare;               //!< Spare normal deviate.
+} waveform_t;
+
+/**********************************************************************************************************************
+ * Prototypes of exported functions
+ *********************************************************************************************************************/
+/**
+ * @brief   Initialize waveform generator.
+ *
+ * @param   wave    Pointer to generator. See @ref waveform_t.
+ * @param   config  Pointer to configuration. See @ref waveform_config_t.
+ *
+ * @return  State of initialization.
+ * @retval  0   failed, configuration is not valid.
+ * @retval  1   success.
+ */
+bool waveform_init(waveform_t *wave, const waveform_config_t *config);
+
+/**
+ * @brief   Generate next sample.
+ *
+ * @param   wave    Pointer to generator. See @ref waveform_t.
+ *
+ * @return  Sample, 0 - @ref WAVEFORM_MAX.
+ */
+uint32_t waveform_next(waveform_t *wave);
+
+/**
+ * @brief   Get time of last sample.
+ *
+ * @param   wave    Pointer to generator. See @ref waveform_t.
+ *
+ * @return  Time in s.
+ */
+double waveform_time(const waveform_t *wave);
+
+/**
+ * @brief   Get frequency of last sample.
+ *
+ * @param   wave    Pointer to generator. See @ref waveform_t.
+ *
+ * @return  Instantaneous frequency in Hz, 0 during dropout.
+ */
+double waveform_frequency(const waveform_t *wave);
+
+/**
+ * @brief   Convert signal to noise ratio to noise RMS.
+ *
+ * @param   amplitude   Sine amplitude, peak, in ADC counts.
+ * @param   snr         Signal to noise ratio in dB.
+ *
+ * @return  Noise RMS in ADC counts.
+ */
+double waveform_noise_from_snr(double amplitude, double snr);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* WAVEFORM_H_ */
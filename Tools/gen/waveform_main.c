@@ -0,0 +1,171 @@
+/**
+ **********************************************************************************************************************
+ * @file        waveform_main.c
+ * @author      Diamond Sparrow
+ * @version     1.0.0.0
+ * @date        2026-10-16
+ * @brief       Synthetic ADC sample stream generator command line tool C source file.
+ **********************************************************************************************************************
+ * @warning     THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR \n
+ *              IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND\n
+ *              FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR\n
+ *              CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL\n
+ *              DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,\n
+ *              DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN\n
+ *              CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF\n
+ *              THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ **********************************************************************************************************************
+ */
+
+
+/**********************************************************************************************************************
+ * Includes
+ *********************************************************************************************************************/
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <getopt.h>
+
+#include "waveform.h"
+
+/**********************************************************************************************************************
+ * Private definitions and macros
+ *********************************************************************************************************************/
+#define WAVEFORM_MAIN_RATE      5000.0  //!< Default sample rate in Hz, firmware rate.
+#define WAVEFORM_MAIN_TIME      1.0     //!< Default stream length in s.
+
+/**********************************************************************************************************************
+ * Prototypes of local functions
+ *********************************************************************************************************************/
+/**
+ * @brief   Print usage.
+ *
+ * @param   name    Program name.
+ */
+static void waveform_main_usage(const char *name);
+
+/**********************************************************************************************************************
+ * Exported functions
+ *********************************************************************************************************************/
+int main(int argc, char **argv)
+{
+    static const struct option options[] =
+    {
+        {"rate",        required_argument,  NULL, 'r'},
+        {"time",        required_argument,  NULL, 't'},
+        {"freq",        required_argument,  NULL, 'f'},
+        {"freq-end",    required_argument,  NULL, 'e'},
+        {"sweep-start", required_argument,  NULL, 's'},
+        {"sweep-time",  required_argument,  NULL, 'w'},
+        {"amplitude",   required_argument,  NULL, 'a'},
+        {"offset",      required_argument,  NULL, 'o'},
+        {"noise",       required_argument,  NULL, 'n'},
+        {"snr",         required_argument,  NULL, 'S'},
+        {"harmonic",    required_argument,  NULL, 'H'},
+        {"bits",        required_argument,  NULL, 'b'},
+        {"dropout",     required_argument,  NULL, 'd'},
+        {"seed",        required_argument,  NULL, 'x'},
+        {"help",        no_argument,        NULL, 'h'},
+        {NULL,          0,                  NULL, 0},
+    };
+    waveform_config_t config =
+    {
+        .rate = WAVEFORM_MAIN_RATE,
+        .freq = 200.0,
+        .amplitude = 800.0,
+        .offset = (WAVEFORM_MAX + 1) / 2.0,
+    };
+    waveform_t wave;
+    double time = WAVEFORM_MAIN_TIME;
+    double snr = -1;
+    uint32_t harmonic = 0;
+    double level = 0;
+    uint64_t samples = 0;
+    uint64_t i = 0;
+    int opt = 0;
+
+    while((opt = getopt_long(argc, argv, "r:t:f:e:s:w:a:o:n:S:H:b:d:x:h", options, NULL)) != -1)
+    {
+        switch(opt)
+        {
+            case 'r': config.rate = atof(optarg); break;
+            case 't': time = atof(optarg); break;
+            case 'f': config.freq = atof(optarg); break;
+            case 'e': config.freq_end = atof(optarg); break;
+            case 's': config.sweep_start = atof(optarg); break;
+            case 'w': config.sweep_time = atof(optarg); break;
+            case 'a': config.amplitude = atof(optarg); break;
+            case 'o': config.offset = atof(optarg); break;
+            case 'n': config.noise = atof(optarg); break;
+            case 'S': snr = atof(optarg); break;
+            case 'b': config.bits = (uint32_t)atoi(optarg); break;
+            case 'x': config.seed = (uint32_t)strtoul(optarg, NULL, 0); break;
+            case 'H':
+                // Harmonic number and relative amplitude, e.g. 3:0.1.
+                if(sscanf(optarg, "%u:%lf", &harmonic, &level) != 2 || harmonic < 2
+                   || harmonic > (WAVEFORM_HARMONICS_MAX + 1))
+                {
+                    fprintf(stderr, "Bad harmonic: %s\n", optarg);
+                    return 1;
+                }
+                config.harmonic[harmonic - 2] = level;
+                break;
+            case 'd':
+                if(sscanf(optarg, "%lf:%lf", &config.dropout_start, &config.dropout_time) != 2)
+                {
+                    fprintf(stderr, "Bad dropout: %s\n", optarg);
+                    return 1;
+                }
+                break;
+            case 'h':
+                waveform_main_usage(argv[0]);
+                return 0;
+            default:
+                waveform_main_usage(argv[0]);
+                return 1;
+        }
+    }
+    if(snr >= 0)
+    {
+        config.noise = waveform_noise_from_snr(config.amplitude, snr);
+    }
+    if(time <= 0 || !waveform_init(&wave, &config))
+    {
+        fprintf(stderr, "Bad configuration.\n");
+        return 1;
+    }
+
+    // One sample per line, so stream can be piped or saved as is.
+    samples = (uint64_t)(time * config.rate);
+    for(i = 0; i < samples; i++)
+    {
+        printf("%u\n", (unsigned)waveform_next(&wave));
+    }
+
+    return 0;
+}
+
+/**********************************************************************************************************************
+ * Private functions
+ *********************************************************************************************************************/
+static void waveform_main_usage(const char *name)
+{
+    printf("Usage: %s [options], prints 12-bit samples, one per line.\n"
+           "  -r, --rate HZ            sample rate, default 5000\n"
+           "  -t, --time S             stream length, default 1\n"
+           "  -f, --freq HZ            frequency, default 200\n"
+           "  -e, --freq-end HZ        frequency after sweep\n"
+           "  -s, --sweep-start S      sweep start\n"
+           "  -w, --sweep-time S       sweep duration, 0 - step\n"
+           "  -a, --amplitude COUNTS   peak amplitude, default 800\n"
+           "  -o, --offset COUNTS      DC offset, default 2048\n"
+           "  -n, --noise COUNTS       noise RMS\n"
+           "  -S, --snr DB             noise by signal to noise ratio\n"
+           "  -H, --harmonic N:LEVEL   harmonic 2 - 9 relative amplitude, repeatable\n"
+           "  -b, --bits N             effective bits, default 12\n"
+           "  -d, --dropout S:S        dropout start and duration\n"
+           "  -x, --seed N             noise seed\n", name);
+
+    return;
+}
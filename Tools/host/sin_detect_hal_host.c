@@ -0,0 +1,131 @@
+/**
+ **********************************************************************************************************************
+ * @file        sin_detect_hal_host.c
+ * @author      Diamond Sparrow
+ * @version     1.0.0.0
+ * @date        2026-10-16
+ * @brief       Sinusoidal signal frequency detection hardware abstraction of host C source file.
+ **********************************************************************************************************************
+ * @warning     THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR \n
+ *              IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND\n
+ *              FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR\n
+ *              CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL\n
+ *              DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,\n
+ *              DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN\n
+ *              CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF\n
+ *              THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ **********************************************************************************************************************
+ */
+
+/**********************************************************************************************************************
+ * Includes
+ *********************************************************************************************************************/
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdarg.h>
+#include <time.h>
+
+#include "debug.h"
+#include "sin_detect_hal_host.h"
+
+/**********************************************************************************************************************
+ * Private variables
+ *********************************************************************************************************************/
+/** LED states. */
+static bool sin_detect_hal_host_led[SIN_DETECT_HAL_HOST_LEDS] = {0};
+/** LED state changes count. */
+static uint32_t sin_detect_hal_host_led_change[SIN_DETECT_HAL_HOST_LEDS] = {0};
+/** Critical sections count. */
+static uint32_t sin_detect_hal_host_lock_count = 0;
+/** Critical section nesting depth. */
+static uint32_t sin_detect_hal_host_lock_nest = 0;
+
+/**********************************************************************************************************************
+ * Exported functions
+ *********************************************************************************************************************/
+void sin_detect_hal_led(uint32_t led, bool on)
+{
+    if(led >= SIN_DETECT_HAL_HOST_LEDS)
+    {
+        return;
+    }
+
+    if(sin_detect_hal_host_led[led] != on)
+    {
+        sin_detect_hal_host_led_change[led]++;
+    }
+    sin_detect_hal_host_led[led] = on;
+
+    return;
+}
+
+uint32_t sin_detect_hal_get_time(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+
+    return (uint32_t)(((uint64_t)ts.tv_sec * 1000000000ULL) + (uint64_t)ts.tv_nsec);
+}
+
+uint32_t sin_detect_hal_lock(void)
+{
+    // No interrupts on host, sections are only counted, so tests can check readers use them.
+    sin_detect_hal_host_lock_count++;
+
+    return sin_detect_hal_host_lock_nest++;
+}
+
+void sin_detect_hal_unlock(uint32_t state)
+{
+    sin_detect_hal_host_lock_nest = state;
+
+    return;
+}
+
+bool sin_detect_hal_work_start(sin_detect_hal_work_t *work)
+{
+    work->id = work;
+
+    return true;
+}
+
+void sin_detect_hal_work_signal(sin_detect_hal_work_t *work)
+{
+    // No threads on host, work runs right away, so results do not depend on scheduling.
+    work->func(work->argument);
+
+    return;
+}
+
+bool sin_detect_hal_host_led_get(uint32_t led)
+{
+    return (led < SIN_DETECT_HAL_HOST_LEDS) ? sin_detect_hal_host_led[led] : false;
+}
+
+uint32_t sin_detect_hal_host_led_changes(uint32_t led)
+{
+    return (led < SIN_DETECT_HAL_HOST_LEDS) ? sin_detect_hal_host_led_change[led] : 0;
+}
+
+uint32_t sin_detect_hal_host_locks(void)
+{
+    return sin_detect_hal_host_lock_count;
+}
+
+uint32_t sin_detect_hal_host_lock_depth(void)
+{
+    return sin_detect_hal_host_lock_nest;
+}
+
+void debug_send_os(const char *format, ...)
+{
+    va_list args;
+
+    va_start(args, format);
+    vprintf(format, args);
+    va_end(args);
+
+    return;
+}
@@ -0,0 +1,81 @@
+/**
+ **********************************************************************************************************************
+ * @file        sin_detect_hal_host.h
+ * @author      Diamond Sparrow
+ * @version     1.0.0.0
+ * @date        2026-10-16
+ * @brief       Sinusoidal signal frequency detection hardware abstraction of host C header file.
+ **********************************************************************************************************************
+ * @warning     THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR \n
+ *              IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND\n
+ *              FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR\n
+ *              CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL\n
+ *              DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,\n
+ *              DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN\n
+ *              CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF\n
+ *              THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ **********************************************************************************************************************
+ */
+
+#ifndef SIN_DETECT_HAL_HOST_H_
+#define SIN_DETECT_HAL_HOST_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**********************************************************************************************************************
+ * Includes
+ *********************************************************************************************************************/
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "sin_detect_hal.h"
+
+/**********************************************************************************************************************
+ * Exported definitions and macros
+ *********************************************************************************************************************/
+#define SIN_DETECT_HAL_HOST_LEDS    8   //!< LEDs count recorded by host.
+
+/**********************************************************************************************************************
+ * Prototypes of exported functions
+ *********************************************************************************************************************/
+/**
+ * @brief   Get LED state last set by detector.
+ *
+ * @param   led LED id, less than @ref SIN_DETECT_HAL_HOST_LEDS.
+ *
+ * @return  State of LED.
+ * @retval  0   LED is off or out of range.
+ * @retval  1   LED is on.
+ */
+bool sin_detect_hal_host_led_get(uint32_t led);
+
+/**
+ * @brief   Get LED state changes count since start.
+ *
+ * @param   led LED id, less than @ref SIN_DETECT_HAL_HOST_LEDS.
+ *
+ * @return  Changes count, 0 if LED is out of range.
+ */
+uint32_t sin_detect_hal_host_led_changes(uint32_t led);
+
+/**
+ * @brief   Get critical sections count since start.
+ *
+ * @return  Sections entered by @ref sin_detect_hal_lock.
+ */
+uint32_t sin_detect_hal_host_locks(void);
+
+/**
+ * @brief   Get critical section nesting depth.
+ *
+ * @return  Sections entered and not left yet, 0 outside of critical section.
+ */
+uint32_t sin_detect_hal_host_lock_depth(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SIN_DETECT_HAL_HOST_H_ */
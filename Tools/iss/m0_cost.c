@@ -0,0 +1,445 @@
+/**
+ **********************************************************************************************************************
+ * @file        m0_cost.c
+ * @author      Diamond Sparrow
+ * @version     1.0.0.0
+ * @date        2026-10-16
+ * @brief       Cortex-M0+ cycle cost estimator of detector hot functions C source file.
+ **********************************************************************************************************************
+ * @warning     THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR \n
+ *              IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND\n
+ *              FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR\n
+ *              CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL\n
+ *              DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,\n
+ *              DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN\n
+ *              CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF\n
+ *              THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ **********************************************************************************************************************
+ */
+
+/**********************************************************************************************************************
+ * Includes
+ *********************************************************************************************************************/
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <getopt.h>
+
+#include "sin_detect.h"
+#include "waveform.h"
+#include "m0_sim.h"
+#include "m0_elf.h"
+
+/**********************************************************************************************************************
+ * Private definitions and macros
+ *********************************************************************************************************************/
+#define M0_COST_TIME            1.0         //!< Default capture length in s.
+#define M0_COST_PREFIX          "m0_cost_run_"  //!< Prefix of hot function entries in target build.
+#define M0_COST_INIT            "m0_cost_init"  //!< Target build init entry.
+#define M0_COST_LIMIT_INIT      1000000000ULL   //!< Max. cycles of init.
+#define M0_COST_LIMIT_CALL      100000000ULL    //!< Max. cycles of one call.
+#define M0_COST_TOP             5           //!< Functions listed by self cycles per entry.
+// Interrupt entry and return with zero wait state memory (Cortex-M0+ TRM), vector, handler and return fetches add
+// flash wait states.
+#define M0_COST_IRQ_ENTRY       15          //!< Interrupt entry cycles.
+#define M0_COST_IRQ_EXIT        13          //!< Interrupt return cycles.
+#define M0_COST_IRQ_FETCHES     3           //!< Flash fetches of interrupt entry and return.
+
+/**********************************************************************************************************************
+ * Private typedef
+ *********************************************************************************************************************/
+/**
+ * @brief   Library function classes, costs software gives to M0+ missing FPU and divider.
+ */
+typedef enum
+{
+    M0_COST_CLASS_CODE = 0,     //!< Detector code.
+    M0_COST_CLASS_FLOAT,        //!< Soft-float library.
+    M0_COST_CLASS_DIV,          //!< Integer division library.
+    M0_COST_CLASS_LAST
+} m0_cost_class_t;
+
+/**
+ * @brief   Cost of one hot function entry.
+ */
+typedef struct
+{
+    const char *name;                           //!< Entry name without prefix.
+    uint64_t min;                               //!< Min. cycles of call.
+    uint64_t max;                               //!< Max. cycles of call.
+    uint64_t sum;                               //!< Cycles of all calls.
+    uint64_t class_cycles[M0_COST_CLASS_LAST];  //!< Cycles by function class. See @ref m0_cost_class_t.
+    uint64_t class_calls[M0_COST_CLASS_LAST];   //!< Calls into function class from other class.
+} m0_cost_result_t;
+
+/**********************************************************************************************************************
+ * Private variables
+ *********************************************************************************************************************/
+
+/**********************************************************************************************************************
+ * Prototypes of local functions
+ *********************************************************************************************************************/
+/**
+ * @brief   Classify function by name.
+ *
+ * @param   name    Function name.
+ *
+ * @return  Function class. See @ref m0_cost_class_t.
+ */
+static m0_cost_class_t m0_cost_classify(const char *name);
+
+/**
+ * @brief   Run entry once per sample and collect cycles.
+ *
+ * @param   sim     Pointer to simulator with program loaded. See @ref m0_sim_t.
+ * @param   elf     Pointer to program. See @ref m0_elf_t.
+ * @param   entry   Pointer to entry symbol. See @ref m0_elf_symbol_t.
+ * @param   samples Capture.
+ * @param   count   Capture length in samples.
+ * @param   self    Self cycles by symbol, elf->count entries.
+ * @param   result  Pointer to result. See @ref m0_cost_result_t.
+ *
+ * @return  State of run, simulation error is printed to stderr.
+ * @retval  0   simulation failed.
+ * @retval  1   success.
+ */
+static bool m0_cost_run(m0_sim_t *sim, const m0_elf_t *elf, const m0_elf_symbol_t *entry, const uint16_t *samples,
+                        uint32_t count, uint64_t *self, m0_cost_result_t *result);
+
+/**
+ * @brief   Print most expensive functions of last run.
+ *
+ * @param   elf     Pointer to program. See @ref m0_elf_t.
+ * @param   self    Self cycles by symbol, elf->count entries.
+ * @param   total   Cycles of all calls.
+ * @param   count   Calls count.
+ */
+static void m0_cost_print_top(const m0_elf_t *elf, const uint64_t *self, uint64_t total, uint32_t count);
+
+/**
+ * @brief   Print usage.
+ *
+ * @param   name    Program name.
+ */
+static void m0_cost_usage(const char *name);
+
+/**********************************************************************************************************************
+ * Exported functions
+ *********************************************************************************************************************/
+int main(int argc, char **argv)
+{
+    static const struct option options[] =
+    {
+        {"wait-states", required_argument,  NULL, 'w'},
+        {"mul-cycles",  required_argument,  NULL, 'm'},
+        {"clock",       required_argument,  NULL, 'c'},
+        {"rate",        required_argument,  NULL, 'r'},
+        {"time",        required_argument,  NULL, 't'},
+        {"format",      required_argument,  NULL, 'f'},
+        {"filter",      required_argument,  NULL, 'F'},
+        {"help",        no_argument,        NULL, 'h'},
+        {NULL,          0,                  NULL, 0},
+    };
+    m0_sim_config_t sim_config =
+    {
+        .wait_states = M0_SIM_WAIT_STATES,
+        .mul_cycles = 1,
+    };
+    waveform_config_t config =
+    {
+        .rate = SIN_DETECT_RATE,
+        .freq = 100.0,
+        .freq_end = 300.0,
+        .amplitude = 800.0,
+        .offset = 2048.0,
+        .noise = 2.0,
+    };
+    const char *format = "text";
+    const char *filter = NULL;
+    double clock = SIN_DETECT_CLOCK;
+    double time = M0_COST_TIME;
+    double budget = 0;
+    double mean = 0;
+    uint32_t irq = 0;
+    uint32_t ret = 0;
+    uint16_t *samples = NULL;
+    uint64_t *self = NULL;
+    uint32_t count = 0;
+    m0_cost_result_t result;
+    waveform_t wave;
+    m0_elf_t elf;
+    m0_sim_t sim;
+    uint32_t i = 0;
+    int opt = 0;
+
+    while((opt = getopt_long(argc, argv, "w:m:c:r:t:f:F:h", options, NULL)) != -1)
+    {
+        switch(opt)
+        {
+            case 'w': sim_config.wait_states = (uint32_t)atoi(optarg); break;
+            case 'm': sim_config.mul_cycles = (uint32_t)atoi(optarg); break;
+            case 'c': clock = atof(optarg); break;
+            case 'r': config.rate = atof(optarg); break;
+            case 't': time = atof(optarg); break;
+            case 'f': format = optarg; break;
+            case 'F': filter = optarg; break;
+            case 'h':
+                m0_cost_usage(argv[0]);
+                return 0;
+            default:
+                m0_cost_usage(argv[0]);
+                return 1;
+        }
+    }
+    if(optind != argc - 1 || time <= 0 || clock <= 0 || config.rate <= 0 || sim_config.mul_cycles == 0
+       || (strcmp(format, "text") != 0 && strcmp(format, "csv") != 0))
+    {
+        m0_cost_usage(argv[0]);
+        return 1;
+    }
+
+    // Capture sweeps over band, so every branch of detector runs.
+    count = (uint32_t)(time * config.rate);
+    config.sweep_time = time;
+    samples = malloc(count * sizeof(uint16_t));
+    if(count == 0 || samples == NULL || !waveform_init(&wave, &config))
+    {
+        fprintf(stderr, "Can not generate capture.\n");
+        return 1;
+    }
+    for(i = 0; i < count; i++)
+    {
+        samples[i] = (uint16_t)waveform_next(&wave);
+    }
+
+    if(!m0_sim_init(&sim, &sim_config))
+    {
+        fprintf(stderr, "Can not initialize simulator.\n");
+        return 1;
+    }
+    if(!m0_elf_load(&elf, &sim, argv[optind]) || (self = calloc(elf.count, sizeof(uint64_t))) == NULL)
+    {
+        return 1;
+    }
+    if(m0_elf_find(&elf, M0_COST_INIT) == NULL
+       || !m0_sim_call(&sim, m0_elf_find(&elf, M0_COST_INIT)->addr, NULL, 0, M0_COST_LIMIT_INIT, &ret) || ret == 0)
+    {
+        fprintf(stderr, "%s failed: %s.\n", M0_COST_INIT, (sim.error != M0_SIM_OK) ? m0_sim_error_text(sim.error)
+                : "missing or returned 0");
+        return 1;
+    }
+
+    budget = clock / config.rate;
+    irq = M0_COST_IRQ_ENTRY + M0_COST_IRQ_EXIT + (M0_COST_IRQ_FETCHES * sim_config.wait_states);
+    if(strcmp(format, "text") == 0)
+    {
+        printf("Cortex-M0+ at %.1f MHz, %lu flash wait states, %lu cycle multiply, %.0f Hz: %.0f cycles per sample, "
+               "interrupt entry and return %lu cycles.\n", clock / 1e6, (unsigned long)sim_config.wait_states,
+               (unsigned long)sim_config.mul_cycles, config.rate, budget, (unsigned long)irq);
+        printf("%-28s %8s %8s %8s %8s %7s %7s %8s %6s %6s %6s\n", "function", "min", "mean", "max", "us max",
+               "load %", "worst %", "channels", "float%", "fcalls", "div %");
+    }
+    else
+    {
+        printf("name,cycles_min,cycles_mean,cycles_max,us_max,load_pct,worst_pct,channels,float_pct,float_calls,"
+               "div_pct\n");
+    }
+
+    for(i = 0; i < elf.count; i++)
+    {
+        if(strncmp(elf.symbol[i].name, M0_COST_PREFIX, strlen(M0_COST_PREFIX)) != 0
+           || (filter != NULL && strstr(elf.symbol[i].name, filter) == NULL))
+        {
+            continue;
+        }
+        if(!m0_cost_run(&sim, &elf, &elf.symbol[i], samples, count, self, &result))
+        {
+            return 1;
+        }
+        // Load is mean cost of sample against its period, worst is longest call with interrupt overhead, channels
+        // is how many detectors fit into one sample period at mean cost.
+        mean = (double)result.sum / count;
+        printf((strcmp(format, "text") == 0) ? "%-28s %8lu %8.1f %8lu %8.2f %7.2f %7.1f %8lu %6.1f %6.2f %6.1f\n"
+               : "%s,%lu,%.1f,%lu,%.2f,%.2f,%.1f,%lu,%.1f,%.2f,%.1f\n", result.name, (unsigned long)result.min, mean,
+               (unsigned long)result.max, (double)result.max * 1e6 / clock, 100.0 * mean / budget,
+               100.0 * (double)(result.max + irq) / budget, (unsigned long)(budget / (mean + irq)),
+               100.0 * (double)result.class_cycles[M0_COST_CLASS_FLOAT] / (double)result.sum,
+               (double)result.class_calls[M0_COST_CLASS_FLOAT] / count,
+               100.0 * (double)result.class_cycles[M0_COST_CLASS_DIV] / (double)result.sum);
+        if(strcmp(format, "text") == 0)
+        {
+            m0_cost_print_top(&elf, self, result.sum, count);
+        }
+    }
+
+    free(self);
+    free(samples);
+    m0_elf_free(&elf);
+    m0_sim_free(&sim);
+
+    return 0;
+}
+
+/**********************************************************************************************************************
+ * Private functions
+ *********************************************************************************************************************/
+static m0_cost_class_t m0_cost_classify(const char *name)
+{
+    static const char * const division[] =
+    {
+        "__aeabi_uidiv", "__aeabi_idiv", "__aeabi_uldivmod", "__aeabi_ldivmod", "__udivsi3", "__divsi3",
+        "__udivmoddi4", "__divdi3", "__udivdi3", "__aeabi_idiv0", "__aeabi_ldiv0",
+    };
+    static const char * const soft_float[] =
+    {
+        "__aeabi_f", "__aeabi_d", "__aeabi_i2f", "__aeabi_ui2f", "__aeabi_l2f", "__aeabi_ul2f", "__aeabi_i2d",
+        "__aeabi_ui2d", "__aeabi_l2d", "__aeabi_ul2d", "__aeabi_cf", "__aeabi_cd",
+    };
+    uint32_t i = 0;
+
+    for(i = 0; i < sizeof(division) / sizeof(division[0]); i++)
+    {
+        if(strncmp(name, division[i], strlen(division[i])) == 0)
+        {
+            return M0_COST_CLASS_DIV;
+        }
+    }
+    for(i = 0; i < sizeof(soft_float) / sizeof(soft_float[0]); i++)
+    {
+        if(strncmp(name, soft_float[i], strlen(soft_float[i])) == 0)
+        {
+            return M0_COST_CLASS_FLOAT;
+        }
+    }
+    // libgcc names of float routines, __addsf3, __fixdfsi, __eqsf2, and newlib float math, sinf, __ieee754_sqrtf.
+    if(strncmp(name, "__", 2) == 0 && (strstr(name, "sf") != NULL || strstr(name, "df") != NULL))
+    {
+        return M0_COST_CLASS_FLOAT;
+    }
+    if(strstr(name, "754") != NULL || strncmp(name, "__kernel_", 9) == 0)
+    {
+        return M0_COST_CLASS_FLOAT;
+    }
+
+    return M0_COST_CLASS_CODE;
+}
+
+static bool m0_cost_run(m0_sim_t *sim, const m0_elf_t *elf, const m0_elf_symbol_t *entry, const uint16_t *samples,
+                        uint32_t count, uint64_t *self, m0_cost_result_t *result)
+{
+    const m0_elf_symbol_t *symbol = NULL;
+    m0_cost_class_t class = M0_COST_CLASS_CODE;
+    m0_cost_class_t last = M0_COST_CLASS_CODE;
+    uint32_t arg = 0;
+    uint64_t start = 0;
+    uint64_t cycles = 0;
+    uint32_t pc = 0;
+    uint32_t i = 0;
+
+    memset(result, 0, sizeof(m0_cost_result_t));
+    memset(self, 0, elf->count * sizeof(uint64_t));
+    result->name = entry->name + strlen(M0_COST_PREFIX);
+    result->min = UINT64_MAX;
+    for(i = 0; i < count; i++)
+    {
+        arg = samples[i];
+        m0_sim_enter(sim, entry->addr, &arg, 1);
+        start = sim->cycles;
+        last = M0_COST_CLASS_CODE;
+        while(sim->r[M0_SIM_PC] != M0_SIM_RETURN)
+        {
+            pc = sim->r[M0_SIM_PC];
+            cycles = sim->cycles;
+            if(symbol == NULL || pc < symbol->addr || (symbol + 1 < elf->symbol + elf->count && pc >= symbol[1].addr))
+            {
+                symbol = m0_elf_lookup(elf, pc);
+                class = (symbol != NULL) ? m0_cost_classify(symbol->name) : M0_COST_CLASS_CODE;
+            }
+            if(symbol != NULL && pc == symbol->addr && class != last)
+            {
+                result->class_calls[class]++;
+            }
+            last = class;
+            if(!m0_sim_step(sim) || (sim->cycles - start) > M0_COST_LIMIT_CALL)
+            {
+                fprintf(stderr, "%s: %s at 0x%08lX.\n", entry->name,
+                        (sim->error != M0_SIM_OK) ? m0_sim_error_text(sim->error) : "cycle limit reached",
+                        (unsigned long)((sim->error != M0_SIM_OK) ? sim->error_addr : pc));
+                return false;
+            }
+            cycles = sim->cycles - cycles;
+            result->class_cycles[class] += cycles;
+            if(symbol != NULL)
+            {
+                self[symbol - elf->symbol] += cycles;
+            }
+        }
+        // Return refills pipeline from caller code in flash.
+        cycles = sim->cycles - start + sim->config.wait_states;
+        result->sum += cycles;
+        result->min = (cycles < result->min) ? cycles : result->min;
+        result->max = (cycles > result->max) ? cycles : result->max;
+    }
+
+    return true;
+}
+
+static void m0_cost_print_top(const m0_elf_t *elf, const uint64_t *self, uint64_t total, uint32_t count)
+{
+    uint32_t top[M0_COST_TOP] = {0};
+    uint32_t found = 0;
+    uint32_t n = 0;
+    uint32_t i = 0;
+    uint32_t j = 0;
+
+    // Few largest, so insertion into short list is enough.
+    for(i = 0; i < elf->count; i++)
+    {
+        if(self[i] == 0)
+        {
+            continue;
+        }
+        n = 0;
+        while(n < found && self[top[n]] >= self[i])
+        {
+            n++;
+        }
+        if(n == M0_COST_TOP)
+        {
+            continue;
+        }
+        for(j = (found < M0_COST_TOP) ? found++ : (M0_COST_TOP - 1); j > n; j--)
+        {
+            top[j] = top[j - 1];
+        }
+        top[n] = i;
+    }
+    for(n = 0; n < found; n++)
+    {
+        printf("    %-32s %10.1f cycles/sample %5.1f%%%s\n", elf->symbol[top[n]].name, (double)self[top[n]] / count,
+               100.0 * (double)self[top[n]] / (double)total,
+               (m0_cost_classify(elf->symbol[top[n]].name) == M0_COST_CLASS_FLOAT) ? " soft-float"
+               : (m0_cost_classify(elf->symbol[top[n]].name) == M0_COST_CLASS_DIV) ? " division" : "");
+    }
+
+    return;
+}
+
+static void m0_cost_usage(const char *name)
+{
+    printf("Usage: %s [options] ELF, estimates Cortex-M0+ cycles of detector hot functions built for target.\n"
+           "Runs %s() once, then each %s*(sample) once per sample of synthetic capture.\n"
+           "  -w, --wait-states N      flash wait states, default %u (LPC11U68 at 48 MHz)\n"
+           "  -m, --mul-cycles N       MULS cycles, 1 with fast multiplier, 32 with small one, default 1\n"
+           "  -c, --clock HZ           core clock, default %.0f\n"
+           "  -r, --rate HZ            sample rate, budget is clock / rate cycles, default %.0f\n"
+           "  -t, --time S             capture length, default %.1f\n"
+           "  -f, --format text|csv    output format, default text\n"
+           "  -F, --filter TEXT        run only functions with name containing text\n",
+           name, M0_COST_INIT, M0_COST_PREFIX, M0_SIM_WAIT_STATES, (double)SIN_DETECT_CLOCK, (double)SIN_DETECT_RATE,
+           M0_COST_TIME);
+
+    return;
+}
@@ -0,0 +1,285 @@
+/**
+ **********************************************************************************************************************
+ * @file        m0_elf.c
+ * @author      Diamond Sparrow
+ * @version     1.0.0.0
+ * @date        2026-10-16
+ * @brief       Cortex-M0+ simulator ELF program loader and symbol table C source file.
+ **********************************************************************************************************************
+ * @warning     THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR \n
+ *              IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND\n
+ *              FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR\n
+ *              CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL\n
+ *              DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,\n
+ *              DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN\n
+ *              CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF\n
+ *              THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ **********************************************************************************************************************
+ */
+
+/**********************************************************************************************************************
+ * Includes
+ *********************************************************************************************************************/
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <elf.h>
+
+#include "m0_elf.h"
+
+/**********************************************************************************************************************
+ * Private definitions and macros
+ *********************************************************************************************************************/
+
+/**********************************************************************************************************************
+ * Private typedef
+ *********************************************************************************************************************/
+
+/**********************************************************************************************************************
+ * Private constants
+ *********************************************************************************************************************/
+
+/**********************************************************************************************************************
+ * Private variables
+ *********************************************************************************************************************/
+
+/**********************************************************************************************************************
+ * Exported variables
+ *********************************************************************************************************************/
+
+/**********************************************************************************************************************
+ * Prototypes of local functions
+ *********************************************************************************************************************/
+/**
+ * @brief   Read whole file.
+ *
+ * @param   path    File path.
+ * @param   size    Pointer to file size.
+ *
+ * @return  File contents, NULL on error.
+ */
+static uint8_t *m0_elf_read(const char *path, size_t *size);
+
+/**
+ * @brief   Load function symbols of symbol table.
+ *
+ * @param   elf     Pointer to program. See @ref m0_elf_t.
+ * @param   file    ELF file.
+ * @param   size    ELF file size.
+ *
+ * @return  State of loading.
+ */
+static bool m0_elf_symbols(m0_elf_t *elf, const uint8_t *file, size_t size);
+
+static int m0_elf_compare(const void *a, const void *b);
+
+/**********************************************************************************************************************
+ * Exported functions
+ *********************************************************************************************************************/
+bool m0_elf_load(m0_elf_t *elf, m0_sim_t *sim, const char *path)
+{
+    const Elf32_Ehdr *header = NULL;
+    const Elf32_Phdr *segment = NULL;
+    uint8_t *file = NULL;
+    size_t size = 0;
+    uint32_t i = 0;
+    bool ret = true;
+
+    memset(elf, 0, sizeof(m0_elf_t));
+    if((file = m0_elf_read(path, &size)) == NULL)
+    {
+        fprintf(stderr, "Can not read %s.\n", path);
+        return false;
+    }
+    header = (const Elf32_Ehdr *)file;
+    if(size < sizeof(Elf32_Ehdr) || memcmp(header->e_ident, ELFMAG, SELFMAG) != 0
+       || header->e_ident[EI_CLASS] != ELFCLASS32 || header->e_ident[EI_DATA] != ELFDATA2LSB
+       || header->e_machine != EM_ARM || header->e_type != ET_EXEC
+       || ((uint64_t)header->e_phoff + ((uint64_t)header->e_phnum * sizeof(Elf32_Phdr))) > size)
+    {
+        fprintf(stderr, "%s is not 32-bit little endian ARM executable.\n", path);
+        free(file);
+        return false;
+    }
+
+    for(i = 0; i < header->e_phnum && ret; i++)
+    {
+        segment = (const Elf32_Phdr *)&file[header->e_phoff + (i * sizeof(Elf32_Phdr))];
+        if(segment->p_type != PT_LOAD || segment->p_memsz == 0)
+        {
+            continue;
+        }
+        // Segments go to run address (VMA), .bss is the rest of memory size.
+        ret = ((uint64_t)segment->p_offset + segment->p_filesz) <= size && segment->p_filesz <= segment->p_memsz
+              && m0_sim_load(sim, segment->p_vaddr, &file[segment->p_offset], segment->p_filesz)
+              && m0_sim_load(sim, segment->p_vaddr + segment->p_filesz, NULL, segment->p_memsz - segment->p_filesz);
+        if(!ret)
+        {
+            fprintf(stderr, "%s segment 0x%08lX, %lu bytes is outside of memory.\n", path,
+                    (unsigned long)segment->p_vaddr, (unsigned long)segment->p_memsz);
+        }
+    }
+    if(ret && !m0_elf_symbols(elf, file, size))
+    {
+        fprintf(stderr, "%s has no function symbols.\n", path);
+        ret = false;
+    }
+    free(file);
+    if(!ret)
+    {
+        m0_elf_free(elf);
+    }
+
+    return ret;
+}
+
+void m0_elf_free(m0_elf_t *elf)
+{
+    free(elf->symbol);
+    free(elf->strings);
+    memset(elf, 0, sizeof(m0_elf_t));
+
+    return;
+}
+
+const m0_elf_symbol_t *m0_elf_find(const m0_elf_t *elf, const char *name)
+{
+    uint32_t i = 0;
+
+    for(i = 0; i < elf->count; i++)
+    {
+        if(strcmp(elf->symbol[i].name, name) == 0)
+        {
+            return &elf->symbol[i];
+        }
+    }
+
+    return NULL;
+}
+
+const m0_elf_symbol_t *m0_elf_lookup(const m0_elf_t *elf, uint32_t addr)
+{
+    uint32_t low = 0;
+    uint32_t high = elf->count;
+    uint32_t mid = 0;
+
+    // Last symbol starting at or before address.
+    while(low < high)
+    {
+        mid = (low + high) / 2;
+        if(elf->symbol[mid].addr <= addr)
+        {
+            low = mid + 1;
+        }
+        else
+        {
+            high = mid;
+        }
+    }
+    if(low == 0)
+    {
+        return NULL;
+    }
+    if(elf->symbol[low - 1].size != 0 && addr >= (elf->symbol[low - 1].addr + elf->symbol[low - 1].size))
+    {
+        return NULL;
+    }
+
+    return &elf->symbol[low - 1];
+}
+
+/**********************************************************************************************************************
+ * Private functions
+ *********************************************************************************************************************/
+static uint8_t *m0_elf_read(const char *path, size_t *size)
+{
+    FILE *f = fopen(path, "rb");
+    uint8_t *data = NULL;
+    long length = 0;
+
+    if(f == NULL)
+    {
+        return NULL;
+    }
+    if(fseek(f, 0, SEEK_END) == 0 && (length = ftell(f)) > 0 && fseek(f, 0, SEEK_SET) == 0
+       && (data = malloc((size_t)length)) != NULL && fread(data, 1, (size_t)length, f) != (size_t)length)
+    {
+        free(data);
+        data = NULL;
+    }
+    fclose(f);
+    *size = (size_t)length;
+
+    return data;
+}
+
+static bool m0_elf_symbols(m0_elf_t *elf, const uint8_t *file, size_t size)
+{
+    const Elf32_Ehdr *header = (const Elf32_Ehdr *)file;
+    const Elf32_Shdr *section = NULL;
+    const Elf32_Shdr *strings = NULL;
+    const Elf32_Sym *sym = NULL;
+    uint32_t count = 0;
+    uint32_t i = 0;
+    uint32_t j = 0;
+
+    if(((uint64_t)header->e_shoff + ((uint64_t)header->e_shnum * sizeof(Elf32_Shdr))) > size)
+    {
+        return false;
+    }
+    for(i = 0; i < header->e_shnum; i++)
+    {
+        section = (const Elf32_Shdr *)&file[header->e_shoff + (i * sizeof(Elf32_Shdr))];
+        if(section->sh_type == SHT_SYMTAB && section->sh_link < header->e_shnum)
+        {
+            break;
+        }
+    }
+    if(i == header->e_shnum)
+    {
+        return false;
+    }
+    strings = (const Elf32_Shdr *)&file[header->e_shoff + (section->sh_link * sizeof(Elf32_Shdr))];
+    count = section->sh_size / sizeof(Elf32_Sym);
+    if(((uint64_t)section->sh_offset + section->sh_size) > size
+       || ((uint64_t)strings->sh_offset + strings->sh_size) > size || strings->sh_size == 0)
+    {
+        return false;
+    }
+
+    // Names are copied, so file can be freed.
+    elf->strings = malloc(strings->sh_size + 1);
+    elf->symbol = malloc((count + 1) * sizeof(m0_elf_symbol_t));
+    if(elf->strings == NULL || elf->symbol == NULL)
+    {
+        return false;
+    }
+    memcpy(elf->strings, &file[strings->sh_offset], strings->sh_size);
+    elf->strings[strings->sh_size] = '\0';
+    for(i = 0; i < count; i++)
+    {
+        sym = (const Elf32_Sym *)&file[section->sh_offset + (i * sizeof(Elf32_Sym))];
+        if(ELF32_ST_TYPE(sym->st_info) != STT_FUNC || sym->st_name >= strings->sh_size)
+        {
+            continue;
+        }
+        elf->symbol[j].name = &elf->strings[sym->st_name];
+        elf->symbol[j].addr = sym->st_value & ~1UL;
+        elf->symbol[j].size = sym->st_size;
+        j++;
+    }
+    elf->count = j;
+    qsort(elf->symbol, elf->count, sizeof(m0_elf_symbol_t), m0_elf_compare);
+
+    return (elf->count > 0);
+}
+
+static int m0_elf_compare(const void *a, const void *b)
+{
+    const m0_elf_symbol_t *sa = (const m0_elf_symbol_t *)a;
+    const m0_elf_symbol_t *sb = (const m0_elf_symbol_t *)b;
+
+    return (sa->addr > sb->addr) - (sa->addr < sb->addr);
+}
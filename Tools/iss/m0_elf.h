@@ -0,0 +1,119 @@
+/**
+ **********************************************************************************************************************
+ * @file        m0_elf.h
+ * @author      Diamond Sparrow
+ * @version     1.0.0.0
+ * @date        2026-10-16
+ * @brief       Cortex-M0+ simulator ELF program loader and symbol table C header file.
+ **********************************************************************************************************************
+ * @warning     THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR \n
+ *              IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND\n
+ *              FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR\n
+ *              CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL\n
+ *              DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,\n
+ *              DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN\n
+ *              CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF\n
+ *              THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ **********************************************************************************************************************
+ */
+
+#ifndef M0_ELF_H_
+#define M0_ELF_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**********************************************************************************************************************
+ * Includes
+ *********************************************************************************************************************/
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "m0_sim.h"
+
+/**********************************************************************************************************************
+ * Exported definitions and macros
+ *********************************************************************************************************************/
+
+/**********************************************************************************************************************
+ * Exported types
+ *********************************************************************************************************************/
+/**
+ * @brief   Function symbol.
+ */
+typedef struct
+{
+    const char *name;           //!< Symbol name.
+    uint32_t addr;              //!< Start address, Thumb bit cleared.
+    uint32_t size;              //!< Size in bytes, 0 - up to next symbol.
+} m0_elf_symbol_t;
+
+/**
+ * @brief   Loaded program.
+ */
+typedef struct
+{
+    m0_elf_symbol_t *symbol;    //!< Function symbols sorted by address. See @ref m0_elf_symbol_t.
+    uint32_t count;             //!< Function symbols count.
+    char *strings;              //!< Symbol names.
+} m0_elf_t;
+
+/**********************************************************************************************************************
+ * Prototypes of exported constants
+ *********************************************************************************************************************/
+
+/**********************************************************************************************************************
+ * Prototypes of exported variables
+ *********************************************************************************************************************/
+
+/**********************************************************************************************************************
+ * Prototypes of exported functions
+ *********************************************************************************************************************/
+/**
+ * @brief   Load statically linked ARM ELF executable: segments at their run addresses, .bss zeroed.
+ *
+ * @note    Segments are placed where code runs, so no startup code is needed to copy .data.
+ *
+ * @param   elf     Pointer to program. See @ref m0_elf_t.
+ * @param   sim     Pointer to initialized simulator. See @ref m0_sim_t.
+ * @param   path    ELF file path.
+ *
+ * @return  State of loading, error is printed to stderr.
+ * @retval  0   failed.
+ * @retval  1   success.
+ */
+bool m0_elf_load(m0_elf_t *elf, m0_sim_t *sim, const char *path);
+
+/**
+ * @brief   Free program symbols.
+ *
+ * @param   elf Pointer to program. See @ref m0_elf_t.
+ */
+void m0_elf_free(m0_elf_t *elf);
+
+/**
+ * @brief   Find function by name.
+ *
+ * @param   elf     Pointer to program. See @ref m0_elf_t.
+ * @param   name    Function name.
+ *
+ * @return  Pointer to symbol, NULL if not found.
+ */
+const m0_elf_symbol_t *m0_elf_find(const m0_elf_t *elf, const char *name);
+
+/**
+ * @brief   Find function that holds address.
+ *
+ * @param   elf     Pointer to program. See @ref m0_elf_t.
+ * @param   addr    Code address.
+ *
+ * @return  Pointer to symbol, NULL if address is outside of functions.
+ */
+const m0_elf_symbol_t *m0_elf_lookup(const m0_elf_t *elf, uint32_t addr);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* M0_ELF_H_ */
@@ -0,0 +1,1074 @@
+/**
+ **********************************************************************************************************************
+ * @file        m0_sim.c
+ * @author      Diamond Sparrow
+ * @version     1.0.0.0
+ * @date        2026-10-16
+ * @brief       Cortex-M0+ Thumb instruction set simulator with cycle timing model C source file.
+ **********************************************************************************************************************
+ * @warning     THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR \n
+ *              IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND\n
+ *              FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR\n
+ *              CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL\n
+ *              DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,\n
+ *              DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN\n
+ *              CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF\n
+ *              THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ **********************************************************************************************************************
+ */
+
+/**********************************************************************************************************************
+ * Includes
+ *********************************************************************************************************************/
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "m0_sim.h"
+
+/**********************************************************************************************************************
+ * Private definitions and macros
+ *********************************************************************************************************************/
+// Cycles of ARMv6-M instructions on Cortex-M0+ with zero wait state memory (Cortex-M0+ TRM, instruction summary).
+#define M0_SIM_CYCLES_BRANCH    2           //!< Taken branch, BX, BLX and writes to PC.
+#define M0_SIM_CYCLES_BL        3           //!< BL.
+#define M0_SIM_CYCLES_LOAD      2           //!< Single load or store.
+#define M0_SIM_CYCLES_POP_PC    3           //!< POP with PC, added to count of other registers.
+#define M0_SIM_CYCLES_SYSTEM    3           //!< MRS, MSR and barriers.
+
+/**********************************************************************************************************************
+ * Private typedef
+ *********************************************************************************************************************/
+/**
+ * @brief   Shift types, encoded as in data processing instructions.
+ */
+typedef enum
+{
+    M0_SIM_SHIFT_LSL = 0,
+    M0_SIM_SHIFT_LSR,
+    M0_SIM_SHIFT_ASR,
+    M0_SIM_SHIFT_ROR,
+} m0_sim_shift_t;
+
+/**********************************************************************************************************************
+ * Private constants
+ *********************************************************************************************************************/
+
+/**********************************************************************************************************************
+ * Private variables
+ *********************************************************************************************************************/
+
+/**********************************************************************************************************************
+ * Exported variables
+ *********************************************************************************************************************/
+
+/**********************************************************************************************************************
+ * Prototypes of local functions
+ *********************************************************************************************************************/
+/**
+ * @brief   Find memory region that holds whole access.
+ *
+ * @param   sim     Pointer to simulator. See @ref m0_sim_t.
+ * @param   addr    Access address.
+ * @param   size    Access size in bytes.
+ *
+ * @return  Pointer to region, NULL - access is outside of memory.
+ */
+static m0_sim_region_t *m0_sim_region(m0_sim_t *sim, uint32_t addr, uint32_t size);
+
+/**
+ * @brief   Stop simulation with error.
+ *
+ * @param   sim     Pointer to simulator. See @ref m0_sim_t.
+ * @param   error   Error. See @ref m0_sim_error_t.
+ * @param   addr    Address of faulting access or instruction.
+ *
+ * @return  Always false, so caller can return it.
+ */
+static bool m0_sim_fault(m0_sim_t *sim, m0_sim_error_t error, uint32_t addr);
+
+/**
+ * @brief   Fetch instruction halfword and account flash wait states.
+ *
+ * Core fetches 32-bit words and prefetches next word as soon as current one starts to execute. Taken branches cost
+ * one fetch of target without wait states, so flash adds its wait states to them. Straight code stalls only when
+ * next word is not ready yet, so code of single cycle instructions runs 2 instructions per (1 + wait states) cycles.
+ *
+ * @param   sim     Pointer to simulator. See @ref m0_sim_t.
+ * @param   addr    Instruction address.
+ * @param   op      Pointer to instruction halfword.
+ *
+ * @return  State of fetch.
+ * @retval  0   fetch fault, see @ref m0_sim_fault.
+ * @retval  1   success.
+ */
+static bool m0_sim_fetch(m0_sim_t *sim, uint32_t addr, uint16_t *op);
+
+/**
+ * @brief   Read data and account region wait states, peripherals are read by configured callback.
+ *
+ * @param   sim     Pointer to simulator. See @ref m0_sim_t.
+ * @param   addr    Address, aligned to size.
+ * @param   size    Access size in bytes: 1, 2 or 4.
+ * @param   value   Pointer to read value, zero extended.
+ *
+ * @return  State of read.
+ * @retval  0   unaligned or outside of memory and peripherals, see @ref m0_sim_fault.
+ * @retval  1   success.
+ */
+static bool m0_sim_read(m0_sim_t *sim, uint32_t addr, uint32_t size, uint32_t *value);
+
+/**
+ * @brief   Write data and account region wait states, flash is read-only and peripheral writes are dropped.
+ *
+ * @param   sim     Pointer to simulator. See @ref m0_sim_t.
+ * @param   addr    Address, aligned to size.
+ * @param   size    Access size in bytes: 1, 2 or 4.
+ * @param   value   Value, low size bytes are written.
+ *
+ * @return  State of write.
+ * @retval  0   unaligned, flash or outside of memory and peripherals, see @ref m0_sim_fault.
+ * @retval  1   success.
+ */
+static bool m0_sim_write(m0_sim_t *sim, uint32_t addr, uint32_t size, uint32_t value);
+
+/**
+ * @brief   Jump to address, next fetch is not prefetched.
+ *
+ * @param   sim     Pointer to simulator. See @ref m0_sim_t.
+ * @param   addr    Target address, Thumb bit is dropped.
+ */
+static void m0_sim_branch(m0_sim_t *sim, uint32_t addr);
+
+/**
+ * @brief   Set negative and zero flags of result.
+ *
+ * @param   sim     Pointer to simulator. See @ref m0_sim_t.
+ * @param   value   Result.
+ */
+static void m0_sim_nz(m0_sim_t *sim, uint32_t value);
+
+/**
+ * @brief   Add with carry and set all flags, subtraction is addition of inverted operand with carry.
+ *
+ * @param   sim     Pointer to simulator. See @ref m0_sim_t.
+ * @param   a       First operand.
+ * @param   b       Second operand.
+ * @param   carry   Carry in.
+ *
+ * @return  Sum.
+ */
+static uint32_t m0_sim_add(m0_sim_t *sim, uint32_t a, uint32_t b, bool carry);
+
+/**
+ * @brief   Shift or rotate and set carry flag to last bit shifted out.
+ *
+ * @param   sim     Pointer to simulator. See @ref m0_sim_t.
+ * @param   type    Shift type. See @ref m0_sim_shift_t.
+ * @param   value   Value to shift.
+ * @param   amount  Shift amount, 0 keeps value and carry.
+ *
+ * @return  Shifted value.
+ */
+static uint32_t m0_sim_shift(m0_sim_t *sim, m0_sim_shift_t type, uint32_t value, uint32_t amount);
+
+/**
+ * @brief   Evaluate condition code of conditional branch.
+ *
+ * @param   sim     Pointer to simulator. See @ref m0_sim_t.
+ * @param   cond    Condition code, 0 - EQ ... 14 - AL.
+ *
+ * @return  State of condition.
+ * @retval  0   condition fails.
+ * @retval  1   condition passes.
+ */
+static bool m0_sim_condition(m0_sim_t *sim, uint32_t cond);
+
+/**
+ * @brief   Count registers in register list.
+ *
+ * @param   list    Register list bit mask.
+ *
+ * @return  Set bits count.
+ */
+static uint32_t m0_sim_count(uint32_t list);
+
+/**
+ * @brief   Execute 32-bit instruction: BL, MRS, MSR or barrier.
+ *
+ * @param   sim     Pointer to simulator. See @ref m0_sim_t.
+ * @param   op      First halfword.
+ * @param   cycles  Pointer to instruction cycles.
+ *
+ * @return  State of execution.
+ */
+static bool m0_sim_step_32(m0_sim_t *sim, uint16_t op, uint32_t *cycles);
+
+/**
+ * @brief   Execute data processing instruction, 010000 opcode group.
+ *
+ * @param   sim     Pointer to simulator. See @ref m0_sim_t.
+ * @param   op      Instruction.
+ * @param   cycles  Pointer to instruction cycles.
+ */
+static void m0_sim_step_alu(m0_sim_t *sim, uint16_t op, uint32_t *cycles);
+
+/**
+ * @brief   Execute miscellaneous instruction, 1011 opcode group.
+ *
+ * @param   sim     Pointer to simulator. See @ref m0_sim_t.
+ * @param   op      Instruction.
+ * @param   cycles  Pointer to instruction cycles.
+ *
+ * @return  State of execution.
+ */
+static bool m0_sim_step_misc(m0_sim_t *sim, uint16_t op, uint32_t *cycles);
+
+/**********************************************************************************************************************
+ * Exported functions
+ *********************************************************************************************************************/
+bool m0_sim_init(m0_sim_t *sim, const m0_sim_config_t *config)
+{
+    memset(sim, 0, sizeof(m0_sim_t));
+    if(config->mul_cycles == 0)
+    {
+        return false;
+    }
+    sim->config = *config;
+    sim->region[0].base = M0_SIM_FLASH_BASE;
+    sim->region[0].size = M0_SIM_FLASH_SIZE;
+    sim->region[0].wait_states = config->wait_states;
+    sim->region[0].data = calloc(M0_SIM_FLASH_SIZE, 1);
+    sim->region[1].base = M0_SIM_RAM_BASE;
+    sim->region[1].size = M0_SIM_RAM_SIZE;
+    sim->region[1].data = calloc(M0_SIM_RAM_SIZE, 1);
+    sim->fetch_flush = true;
+    if(sim->region[0].data == NULL || sim->region[1].data == NULL)
+    {
+        m0_sim_free(sim);
+        return false;
+    }
+
+    return true;
+}
+
+void m0_sim_free(m0_sim_t *sim)
+{
+    uint32_t i = 0;
+
+    for(i = 0; i < M0_SIM_REGIONS; i++)
+    {
+        free(sim->region[i].data);
+        sim->region[i].data = NULL;
+        sim->region[i].size = 0;
+    }
+
+    return;
+}
+
+bool m0_sim_load(m0_sim_t *sim, uint32_t addr, const void *data, uint32_t size)
+{
+    m0_sim_region_t *region = m0_sim_region(sim, addr, size);
+
+    if(region == NULL)
+    {
+        return false;
+    }
+    if(data != NULL)
+    {
+        memcpy(&region->data[addr - region->base], data, size);
+    }
+    else
+    {
+        memset(&region->data[addr - region->base], 0, size);
+    }
+
+    return true;
+}
+
+void m0_sim_enter(m0_sim_t *sim, uint32_t entry, const uint32_t *args, uint32_t count)
+{
+    uint32_t i = 0;
+
+    for(i = 0; i < 4; i++)
+    {
+        sim->r[i] = (i < count) ? args[i] : 0;
+    }
+    sim->r[M0_SIM_SP] = M0_SIM_RAM_BASE + M0_SIM_RAM_SIZE;
+    sim->r[M0_SIM_LR] = M0_SIM_RETURN | 1;
+    sim->r[M0_SIM_PC] = entry & ~1UL;
+    sim->fetch_flush = true;
+    sim->error = M0_SIM_OK;
+
+    return;
+}
+
+bool m0_sim_step(m0_sim_t *sim)
+{
+    uint32_t *r = sim->r;
+    const uint32_t pc = r[M0_SIM_PC];
+    // PC reads as address of instruction plus 4.
+    const uint32_t pc_read = pc + 4;
+    uint32_t cycles = 1;
+    uint32_t value = 0;
+    uint32_t addr = 0;
+    uint32_t size = 0;
+    uint16_t op = 0;
+    uint32_t rd = 0;
+    uint32_t rn = 0;
+    uint32_t i = 0;
+
+    sim->stall = 0;
+    if(!m0_sim_fetch(sim, pc, &op))
+    {
+        return false;
+    }
+    r[M0_SIM_PC] = pc + 2;
+
+    switch(op >> 12)
+    {
+        case 0x0:
+        case 0x1:
+            if((op & 0x1800) == 0x1800)
+            {
+                // ADDS/SUBS register or 3-bit immediate.
+                value = (op & 0x0400) ? ((op >> 6) & 0x7) : r[(op >> 6) & 0x7];
+                rn = r[(op >> 3) & 0x7];
+                r[op & 0x7] = (op & 0x0200) ? m0_sim_add(sim, rn, ~value, true) : m0_sim_add(sim, rn, value, false);
+            }
+            else
+            {
+                // LSLS/LSRS/ASRS immediate, shift by 0 of LSR and ASR means 32.
+                value = (op >> 6) & 0x1F;
+                if(value == 0 && (op & 0x1800) != 0)
+                {
+                    value = 32;
+                }
+                rd = m0_sim_shift(sim, (m0_sim_shift_t)((op >> 11) & 0x3), r[(op >> 3) & 0x7], value);
+                m0_sim_nz(sim, rd);
+                r[op & 0x7] = rd;
+            }
+            break;
+
+        case 0x2:
+        case 0x3:
+            // MOVS/CMP/ADDS/SUBS 8-bit immediate.
+            rd = (op >> 8) & 0x7;
+            value = op & 0xFF;
+            switch((op >> 11) & 0x3)
+            {
+                case 0: r[rd] = value; m0_sim_nz(sim, value); break;
+                case 1: m0_sim_add(sim, r[rd], ~value, true); break;
+                case 2: r[rd] = m0_sim_add(sim, r[rd], value, false); break;
+                default: r[rd] = m0_sim_add(sim, r[rd], ~value, true); break;
+            }
+            break;
+
+        case 0x4:
+            if((op & 0x0800) != 0)
+            {
+                // LDR literal.
+                cycles = M0_SIM_CYCLES_LOAD;
+                if(!m0_sim_read(sim, (pc_read & ~3UL) + ((op & 0xFF) << 2), 4, &r[(op >> 8) & 0x7]))
+                {
+                    return false;
+                }
+            }
+            else if((op & 0x0400) == 0)
+            {
+                m0_sim_step_alu(sim, op, &cycles);
+            }
+            else
+            {
+                // High register ADD/CMP/MOV, BX and BLX.
+                rd = (op & 0x7) | ((op >> 4) & 0x8);
+                value = ((op >> 3) & 0xF) == M0_SIM_PC ? pc_read : r[(op >> 3) & 0xF];
+                switch((op >> 8) & 0x3)
+                {
+                    case 0:
+                        rn = (rd == M0_SIM_PC) ? pc_read : r[rd];
+                        if(rd == M0_SIM_PC)
+                        {
+                            cycles = M0_SIM_CYCLES_BRANCH;
+                            m0_sim_branch(sim, rn + value);
+                        }
+                        else
+                        {
+                            r[rd] = rn + value;
+                        }
+                        break;
+                    case 1:
+                        m0_sim_add(sim, (rd == M0_SIM_PC) ? pc_read : r[rd], ~value, true);
+                        break;
+                    case 2:
+                        if(rd == M0_SIM_PC)
+                        {
+                            cycles = M0_SIM_CYCLES_BRANCH;
+                            m0_sim_branch(sim, value);
+                        }
+                        else
+                        {
+                            r[rd] = value;
+                        }
+                        break;
+                    default:
+                        cycles = M0_SIM_CYCLES_BRANCH;
+                        if((value & 1) == 0)
+                        {
+                            // Interworking to ARM state faults on M0+.
+                            return m0_sim_fault(sim, M0_SIM_ERROR_BREAKPOINT, pc);
+                        }
+                        if((op & 0x0080) != 0)
+                        {
+                            r[M0_SIM_LR] = (pc + 2) | 1;
+                        }
+                        m0_sim_branch(sim, value);
+                        break;
+                }
+            }
+            break;
+
+        case 0x5:
+            // Load and store with register offset: STR, STRH, STRB, LDRSB, LDR, LDRH, LDRB, LDRSH.
+            cycles = M0_SIM_CYCLES_LOAD;
+            addr = r[(op >> 3) & 0x7] + r[(op >> 6) & 0x7];
+            rd = op & 0x7;
+            i = (op >> 9) & 0x7;
+            if(i < 3)
+            {
+                // Store sizes are 4, 2, 1 bytes.
+                if(!m0_sim_write(sim, addr, 4 >> i, r[rd]))
+                {
+                    return false;
+                }
+                break;
+            }
+            size = (i == 4) ? 4 : (((i == 3) || (i == 6)) ? 1 : 2);
+            if(!m0_sim_read(sim, addr, size, &value))
+            {
+                return false;
+            }
+            if(i == 3)
+            {
+                value = (uint32_t)(int32_t)(int8_t)value;
+            }
+            else if(i == 7)
+            {
+                value = (uint32_t)(int32_t)(int16_t)value;
+            }
+            r[rd] = value;
+            break;
+
+        case 0x6:
+        case 0x7:
+        case 0x8:
+        case 0x9:
+            // Load and store with immediate offset: word, byte, halfword and SP relative word.
+            cycles = M0_SIM_CYCLES_LOAD;
+            if((op >> 12) == 0x9)
+            {
+                rd = (op >> 8) & 0x7;
+                addr = r[M0_SIM_SP] + ((op & 0xFF) << 2);
+                size = 4;
+            }
+            else
+            {
+                rd = op & 0x7;
+                size = ((op >> 12) == 0x8) ? 2 : ((op & 0x1000) ? 1 : 4);
+                addr = r[(op >> 3) & 0x7] + (((op >> 6) & 0x1F) * size);
+            }
+            if((op & 0x0800) != 0)
+            {
+                if(!m0_sim_read(sim, addr, size, &r[rd]))
+                {
+                    return false;
+                }
+            }
+            else if(!m0_sim_write(sim, addr, size, r[rd]))
+            {
+                return false;
+            }
+            break;
+
+        case 0xA:
+            // ADR and ADD SP immediate.
+            r[(op >> 8) & 0x7] = ((op & 0x0800) ? r[M0_SIM_SP] : (pc_read & ~3UL)) + ((op & 0xFF) << 2);
+            break;
+
+        case 0xB:
+            if(!m0_sim_step_misc(sim, op, &cycles))
+            {
+                return false;
+            }
+            break;
+
+        case 0xC:
+            // STMIA and LDMIA, base is written back unless it is loaded.
+            rn = (op >> 8) & 0x7;
+            addr = r[rn];
+            cycles = 1 + m0_sim_count(op & 0xFF);
+            for(i = 0; i < 8; i++)
+            {
+                if((op & (1U << i)) == 0)
+                {
+                    continue;
+                }
+                if((op & 0x0800) ? !m0_sim_read(sim, addr, 4, &r[i]) : !m0_sim_write(sim, addr, 4, r[i]))
+                {
+                    return false;
+                }
+                addr += 4;
+            }
+            if((op & 0x0800) == 0 || (op & (1U << rn)) == 0)
+            {
+                r[rn] = addr;
+            }
+            break;
+
+        case 0xD:
+            if((op & 0x0F00) == 0x0E00 || (op & 0x0F00) == 0x0F00)
+            {
+                // UDF and SVC, no supervisor in simulation.
+                return m0_sim_fault(sim, ((op & 0x0F00) == 0x0E00) ? M0_SIM_ERROR_UNDEFINED : M0_SIM_ERROR_BREAKPOINT,
+                                    pc);
+            }
+            if(m0_sim_condition(sim, (op >> 8) & 0xF))
+            {
+                cycles = M0_SIM_CYCLES_BRANCH;
+                m0_sim_branch(sim, pc_read + ((uint32_t)(int32_t)(int8_t)(op & 0xFF) << 1));
+            }
+            break;
+
+        case 0xE:
+            if((op & 0x0800) != 0)
+            {
+                if(!m0_sim_step_32(sim, op, &cycles))
+                {
+                    return false;
+                }
+                break;
+            }
+            // B unconditional, 11-bit offset.
+            cycles = M0_SIM_CYCLES_BRANCH;
+            value = op & 0x7FF;
+            m0_sim_branch(sim, pc_read + ((value & 0x400) ? ((value << 1) | 0xFFFFF000UL) : (value << 1)));
+            break;
+
+        default:
+            if(!m0_sim_step_32(sim, op, &cycles))
+            {
+                return false;
+            }
+            break;
+    }
+
+    sim->cycles += cycles + sim->stall;
+    sim->instructions++;
+
+    return true;
+}
+
+bool m0_sim_call(m0_sim_t *sim, uint32_t entry, const uint32_t *args, uint32_t count, uint64_t limit,
+                 uint32_t *result)
+{
+    const uint64_t start = sim->cycles;
+
+    m0_sim_enter(sim, entry, args, count);
+    while(sim->r[M0_SIM_PC] != M0_SIM_RETURN)
+    {
+        if((sim->cycles - start) >= limit)
+        {
+            return m0_sim_fault(sim, M0_SIM_ERROR_LIMIT, sim->r[M0_SIM_PC]);
+        }
+        if(!m0_sim_step(sim))
+        {
+            return false;
+        }
+    }
+    if(result != NULL)
+    {
+        *result = sim->r[0];
+    }
+
+    return true;
+}
+
+const char *m0_sim_error_text(m0_sim_error_t error)
+{
+    switch(error)
+    {
+        case M0_SIM_OK:                 return "ok";
+        case M0_SIM_ERROR_FETCH:        return "instruction fetch outside of memory";
+        case M0_SIM_ERROR_ACCESS:       return "data access outside of memory";
+        case M0_SIM_ERROR_ALIGN:        return "unaligned data access";
+        case M0_SIM_ERROR_UNDEFINED:    return "undefined instruction";
+        case M0_SIM_ERROR_BREAKPOINT:   return "breakpoint, supervisor call or ARM state";
+        case M0_SIM_ERROR_LIMIT:        return "cycle limit reached";
+        default:                        return "unknown error";
+    }
+}
+
+/**********************************************************************************************************************
+ * Private functions
+ *********************************************************************************************************************/
+static m0_sim_region_t *m0_sim_region(m0_sim_t *sim, uint32_t addr, uint32_t size)
+{
+    uint32_t i = 0;
+
+    for(i = 0; i < M0_SIM_REGIONS; i++)
+    {
+        if(sim->region[i].size != 0 && addr >= sim->region[i].base
+           && ((uint64_t)addr - sim->region[i].base + size) <= sim->region[i].size)
+        {
+            return &sim->region[i];
+        }
+    }
+
+    return NULL;
+}
+
+static bool m0_sim_fault(m0_sim_t *sim, m0_sim_error_t error, uint32_t addr)
+{
+    sim->error = error;
+    sim->error_addr = addr;
+
+    return false;
+}
+
+static bool m0_sim_fetch(m0_sim_t *sim, uint32_t addr, uint16_t *op)
+{
+    m0_sim_region_t *region = m0_sim_region(sim, addr, 2);
+    const uint32_t word = addr & ~3UL;
+    const uint64_t now = sim->cycles + sim->stall;
+    uint64_t ready = 0;
+
+    if(region == NULL || (addr & 1) != 0)
+    {
+        return m0_sim_fault(sim, M0_SIM_ERROR_FETCH, addr);
+    }
+    *op = (uint16_t)(region->data[addr - region->base] | (region->data[addr - region->base + 1] << 8));
+
+    if(region->wait_states == 0)
+    {
+        sim->fetch_flush = true;
+    }
+    else if(sim->fetch_flush || (word != sim->fetch_word && word != (sim->fetch_word + 4)))
+    {
+        sim->stall += region->wait_states;
+        sim->fetch_word = word;
+        sim->fetch_ready = now + region->wait_states;
+        sim->fetch_used = sim->fetch_ready;
+        sim->fetch_flush = false;
+    }
+    else if(word != sim->fetch_word)
+    {
+        ready = ((sim->fetch_ready > sim->fetch_used) ? sim->fetch_ready : sim->fetch_used) + 1 + region->wait_states;
+        if(ready > now)
+        {
+            sim->stall += (uint32_t)(ready - now);
+        }
+        sim->fetch_word = word;
+        sim->fetch_ready = ready;
+        sim->fetch_used = sim->cycles + sim->stall;
+    }
+
+    return true;
+}
+
+static bool m0_sim_read(m0_sim_t *sim, uint32_t addr, uint32_t size, uint32_t *value)
+{
+    m0_sim_region_t *region = NULL;
+    const uint8_t *p = NULL;
+
+    if((addr & (size - 1)) != 0)
+    {
+        return m0_sim_fault(sim, M0_SIM_ERROR_ALIGN, addr);
+    }
+    if((region = m0_sim_region(sim, addr, size)) != NULL)
+    {
+        p = &region->data[addr - region->base];
+        *value = (size == 4) ? (p[0] | (p[1] << 8) | (p[2] << 16) | ((uint32_t)p[3] << 24))
+               : (size == 2) ? (uint32_t)(p[0] | (p[1] << 8)) : p[0];
+        sim->stall += region->wait_states;
+        return true;
+    }
+    // APB and AHB peripherals, GPIO and private peripheral bus.
+    if((addr >= 0x40000000UL && addr < 0x60000000UL) || (addr >= 0xA0000000UL && addr < 0xB0000000UL)
+       || addr >= 0xE0000000UL)
+    {
+        *value = (sim->config.periph_read != NULL) ? sim->config.periph_read(sim->config.periph_argument, addr, size) : 0;
+        return true;
+    }
+
+    return m0_sim_fault(sim, M0_SIM_ERROR_ACCESS, addr);
+}
+
+static bool m0_sim_write(m0_sim_t *sim, uint32_t addr, uint32_t size, uint32_t value)
+{
+    m0_sim_region_t *region = NULL;
+    uint8_t *p = NULL;
+    uint32_t i = 0;
+
+    if((addr & (size - 1)) != 0)
+    {
+        return m0_sim_fault(sim, M0_SIM_ERROR_ALIGN, addr);
+    }
+    // Flash is read-only.
+    if((region = m0_sim_region(sim, addr, size)) != NULL && region->base != M0_SIM_FLASH_BASE)
+    {
+        p = &region->data[addr - region->base];
+        for(i = 0; i < size; i++)
+        {
+            p[i] = (uint8_t)(value >> (i * 8));
+        }
+        sim->stall += region->wait_states;
+        return true;
+    }
+    if((addr >= 0x40000000UL && addr < 0x60000000UL) || (addr >= 0xA0000000UL && addr < 0xB0000000UL)
+       || addr >= 0xE0000000UL)
+    {
+        return true;
+    }
+
+    return m0_sim_fault(sim, M0_SIM_ERROR_ACCESS, addr);
+}
+
+static void m0_sim_branch(m0_sim_t *sim, uint32_t addr)
+{
+    sim->r[M0_SIM_PC] = addr & ~1UL;
+    sim->fetch_flush = true;
+
+    return;
+}
+
+static void m0_sim_nz(m0_sim_t *sim, uint32_t value)
+{
+    sim->n = (value >> 31) != 0;
+    sim->z = (value == 0);
+
+    return;
+}
+
+static uint32_t m0_sim_add(m0_sim_t *sim, uint32_t a, uint32_t b, bool carry)
+{
+    const uint32_t result = a + b + (carry ? 1 : 0);
+
+    m0_sim_nz(sim, result);
+    sim->c = ((((uint64_t)a + b + (carry ? 1 : 0)) >> 32) != 0);
+    sim->v = (((~(a ^ b)) & (a ^ result)) >> 31) != 0;
+
+    return result;
+}
+
+static uint32_t m0_sim_shift(m0_sim_t *sim, m0_sim_shift_t type, uint32_t value, uint32_t amount)
+{
+    // Shift by 0 keeps carry.
+    if(amount == 0)
+    {
+        return value;
+    }
+
+    switch(type)
+    {
+        case M0_SIM_SHIFT_LSL:
+            if(amount < 32)
+            {
+                sim->c = ((value >> (32 - amount)) & 1) != 0;
+                return value << amount;
+            }
+            sim->c = (amount == 32) ? ((value & 1) != 0) : false;
+            return 0;
+
+        case M0_SIM_SHIFT_LSR:
+            if(amount < 32)
+            {
+                sim->c = ((value >> (amount - 1)) & 1) != 0;
+                return value >> amount;
+            }
+            sim->c = (amount == 32) ? ((value >> 31) != 0) : false;
+            return 0;
+
+        case M0_SIM_SHIFT_ASR:
+            if(amount < 32)
+            {
+                sim->c = (((int32_t)value >> (amount - 1)) & 1) != 0;
+                return (uint32_t)((int32_t)value >> amount);
+            }
+            sim->c = (value >> 31) != 0;
+            return sim->c ? 0xFFFFFFFFUL : 0;
+
+        default:
+            amount &= 31;
+            if(amount != 0)
+            {
+                value = (value >> amount) | (value << (32 - amount));
+            }
+            sim->c = (value >> 31) != 0;
+            return value;
+    }
+}
+
+static bool m0_sim_condition(m0_sim_t *sim, uint32_t cond)
+{
+    bool result = false;
+
+    switch(cond >> 1)
+    {
+        case 0: result = sim->z; break;                             // EQ
+        case 1: result = sim->c; break;                             // CS
+        case 2: result = sim->n; break;                             // MI
+        case 3: result = sim->v; break;                             // VS
+        case 4: result = sim->c && !sim->z; break;                  // HI
+        case 5: result = (sim->n == sim->v); break;                 // GE
+        case 6: result = (sim->n == sim->v) && !sim->z; break;      // GT
+        default: return true;                                       // AL
+    }
+
+    return ((cond & 1) != 0) ? !result : result;
+}
+
+static uint32_t m0_sim_count(uint32_t list)
+{
+    uint32_t count = 0;
+
+    for(; list != 0; list &= list - 1)
+    {
+        count++;
+    }
+
+    return count;
+}
+
+static bool m0_sim_step_32(m0_sim_t *sim, uint16_t op, uint32_t *cycles)
+{
+    const uint32_t pc = sim->r[M0_SIM_PC] - 2;
+    uint32_t offset = 0;
+    uint32_t sysm = 0;
+    uint16_t op2 = 0;
+    bool s = false;
+
+    if(!m0_sim_fetch(sim, pc + 2, &op2))
+    {
+        return false;
+    }
+    sim->r[M0_SIM_PC] = pc + 4;
+
+    if((op & 0xF800) == 0xF000 && (op2 & 0xD000) == 0xD000)
+    {
+        // BL, offset is S:I1:I2:imm10:imm11:0 with I = NOT(J EOR S).
+        s = (op & 0x0400) != 0;
+        offset = ((uint32_t)(op & 0x03FF) << 12) | ((uint32_t)(op2 & 0x07FF) << 1);
+        offset |= (((op2 >> 13) & 1) == s) ? (1UL << 23) : 0;
+        offset |= (((op2 >> 11) & 1) == s) ? (1UL << 22) : 0;
+        if(s)
+        {
+            offset |= 0xFF000000UL;
+        }
+        *cycles = M0_SIM_CYCLES_BL;
+        sim->r[M0_SIM_LR] = (pc + 4) | 1;
+        m0_sim_branch(sim, pc + 4 + offset);
+        return true;
+    }
+
+    *cycles = M0_SIM_CYCLES_SYSTEM;
+    sysm = op2 & 0xFF;
+    if(op == 0xF3BF && (op2 & 0xFFF0) >= 0x8F40 && (op2 & 0xFFF0) <= 0x8F60)
+    {
+        // DSB, DMB and ISB, memory is always coherent here.
+        return true;
+    }
+    if(op == 0xF3EF && (op2 & 0xF000) == 0x8000)
+    {
+        // MRS: xPSR flags, MSP/PSP, PRIMASK, CONTROL.
+        offset = 0;
+        if(sysm < 8)
+        {
+            offset = ((uint32_t)sim->n << 31) | ((uint32_t)sim->z << 30) | ((uint32_t)sim->c << 29)
+                   | ((uint32_t)sim->v << 28);
+        }
+        else if(sysm == 8 || sysm == 9)
+        {
+            offset = sim->r[M0_SIM_SP];
+        }
+        else if(sysm == 16)
+        {
+            offset = sim->primask ? 1 : 0;
+        }
+        sim->r[(op2 >> 8) & 0xF] = offset;
+        return true;
+    }
+    if((op & 0xFFF0) == 0xF380 && (op2 & 0xFF00) == 0x8800)
+    {
+        // MSR.
+        offset = sim->r[op & 0xF];
+        if(sysm < 8)
+        {
+            sim->n = (offset >> 31) & 1;
+            sim->z = (offset >> 30) & 1;
+            sim->c = (offset >> 29) & 1;
+            sim->v = (offset >> 28) & 1;
+        }
+        else if(sysm == 8 || sysm == 9)
+        {
+            sim->r[M0_SIM_SP] = offset & ~3UL;
+        }
+        else if(sysm == 16)
+        {
+            sim->primask = (offset & 1) != 0;
+        }
+        return true;
+    }
+
+    return m0_sim_fault(sim, M0_SIM_ERROR_UNDEFINED, pc);
+}
+
+static void m0_sim_step_alu(m0_sim_t *sim, uint16_t op, uint32_t *cycles)
+{
+    uint32_t *r = sim->r;
+    const uint32_t rd = op & 0x7;
+    const uint32_t rm = r[(op >> 3) & 0x7];
+    uint32_t result = 0;
+
+    switch((op >> 6) & 0xF)
+    {
+        case 0x0: result = r[rd] & rm; m0_sim_nz(sim, result); break;                                // ANDS
+        case 0x1: result = r[rd] ^ rm; m0_sim_nz(sim, result); break;                                // EORS
+        case 0x2: result = m0_sim_shift(sim, M0_SIM_SHIFT_LSL, r[rd], rm & 0xFF); m0_sim_nz(sim, result); break;
+        case 0x3: result = m0_sim_shift(sim, M0_SIM_SHIFT_LSR, r[rd], rm & 0xFF); m0_sim_nz(sim, result); break;
+        case 0x4: result = m0_sim_shift(sim, M0_SIM_SHIFT_ASR, r[rd], rm & 0xFF); m0_sim_nz(sim, result); break;
+        case 0x5: result = m0_sim_add(sim, r[rd], rm, sim->c); break;                               // ADCS
+        case 0x6: result = m0_sim_add(sim, r[rd], ~rm, sim->c); break;                              // SBCS
+        case 0x7: result = m0_sim_shift(sim, M0_SIM_SHIFT_ROR, r[rd], rm & 0xFF); m0_sim_nz(sim, result); break;
+        case 0x8: m0_sim_nz(sim, r[rd] & rm); return;                                               // TST
+        case 0x9: result = m0_sim_add(sim, 0, ~rm, true); break;                                    // RSBS #0
+        case 0xA: m0_sim_add(sim, r[rd], ~rm, true); return;                                        // CMP
+        case 0xB: m0_sim_add(sim, r[rd], rm, false); return;                                        // CMN
+        case 0xC: result = r[rd] | rm; m0_sim_nz(sim, result); break;                                // ORRS
+        case 0xD:                                                                                   // MULS
+            *cycles = sim->config.mul_cycles;
+            result = r[rd] * rm;
+            m0_sim_nz(sim, result);
+            break;
+        case 0xE: result = r[rd] & ~rm; m0_sim_nz(sim, result); break;                               // BICS
+        default: result = ~rm; m0_sim_nz(sim, result); break;                                       // MVNS
+    }
+    r[rd] = result;
+
+    return;
+}
+
+static bool m0_sim_step_misc(m0_sim_t *sim, uint16_t op, uint32_t *cycles)
+{
+    uint32_t *r = sim->r;
+    const uint32_t pc = r[M0_SIM_PC] - 2;
+    const uint32_t rm = r[(op >> 3) & 0x7];
+    uint32_t addr = 0;
+    uint32_t value = 0;
+    uint32_t i = 0;
+
+    if((op & 0x0F00) == 0x0000)
+    {
+        // ADD/SUB SP, 7-bit immediate.
+        value = (op & 0x7F) << 2;
+        r[M0_SIM_SP] = (op & 0x0080) ? (r[M0_SIM_SP] - value) : (r[M0_SIM_SP] + value);
+    }
+    else if((op & 0x0F00) == 0x0200)
+    {
+        // SXTH, SXTB, UXTH, UXTB.
+        switch((op >> 6) & 0x3)
+        {
+            case 0: value = (uint32_t)(int32_t)(int16_t)rm; break;
+            case 1: value = (uint32_t)(int32_t)(int8_t)rm; break;
+            case 2: value = rm & 0xFFFF; break;
+            default: value = rm & 0xFF; break;
+        }
+        r[op & 0x7] = value;
+    }
+    else if((op & 0x0E00) == 0x0400)
+    {
+        // PUSH, lowest register at lowest address.
+        *cycles = 1 + m0_sim_count(op & 0x1FF);
+        addr = r[M0_SIM_SP] - (m0_sim_count(op & 0x1FF) * 4);
+        r[M0_SIM_SP] = addr;
+        for(i = 0; i < 9; i++)
+        {
+            if((op & (1U << i)) != 0)
+            {
+                if(!m0_sim_write(sim, addr, 4, r[(i == 8) ? M0_SIM_LR : i]))
+                {
+                    return false;
+                }
+                addr += 4;
+            }
+        }
+    }
+    else if((op & 0x0FEF) == 0x0662)
+    {
+        // CPSIE i / CPSID i.
+        sim->primask = (op & 0x0010) != 0;
+    }
+    else if((op & 0x0F00) == 0x0A00 && (op & 0x00C0) != 0x0080)
+    {
+        // REV, REV16, REVSH.
+        switch((op >> 6) & 0x3)
+        {
+            case 0:
+                value = (rm >> 24) | ((rm >> 8) & 0xFF00) | ((rm << 8) & 0xFF0000) | (rm << 24);
+                break;
+            case 1:
+                value = ((rm >> 8) & 0x00FF00FFUL) | ((rm << 8) & 0xFF00FF00UL);
+                break;
+            default:
+                value = (uint32_t)(int32_t)(int16_t)(((rm >> 8) & 0xFF) | ((rm & 0xFF) << 8));
+                break;
+        }
+        r[op & 0x7] = value;
+    }
+    else if((op & 0x0E00) == 0x0C00)
+    {
+        // POP, PC pops as branch.
+        addr = r[M0_SIM_SP];
+        *cycles = 1 + m0_sim_count(op & 0x1FF);
+        for(i = 0; i < 8; i++)
+        {
+            if((op & (1U << i)) != 0)
+            {
+                if(!m0_sim_read(sim, addr, 4, &r[i]))
+                {
+                    return false;
+                }
+                addr += 4;
+            }
+        }
+        if((op & 0x0100) != 0)
+        {
+            if(!m0_sim_read(sim, addr, 4, &value))
+            {
+                return false;
+            }
+            addr += 4;
+            if((value & 1) == 0)
+            {
+                return m0_sim_fault(sim, M0_SIM_ERROR_BREAKPOINT, pc);
+            }
+            *cycles = M0_SIM_CYCLES_POP_PC + m0_sim_count(op & 0xFF);
+            m0_sim_branch(sim, value);
+        }
+        r[M0_SIM_SP] = addr;
+    }
+    else if((op & 0x0F00) == 0x0E00)
+    {
+        return m0_sim_fault(sim, M0_SIM_ERROR_BREAKPOINT, pc);
+    }
+    else if((op & 0x0F00) == 0x0F00 && (op & 0x000F) == 0)
+    {
+        // NOP, YIELD, WFE, WFI, SEV, nothing to wait for here.
+    }
+    else
+    {
+        return m0_sim_fault(sim, M0_SIM_ERROR_UNDEFINED, pc);
+    }
+
+    return true;
+}
@@ -0,0 +1,208 @@
+/**
+ **********************************************************************************************************************
+ * @file        m0_sim.h
+ * @author      Diamond Sparrow
+ * @version     1.0.0.0
+ * @date        2026-10-16
+ * @brief       Cortex-M0+ Thumb instruction set simulator with cycle timing model C header file.
+ **********************************************************************************************************************
+ * @warning     THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR \n
+ *              IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND\n
+ *              FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR\n
+ *              CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL\n
+ *              DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,\n
+ *              DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN\n
+ *              CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF\n
+ *              THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ **********************************************************************************************************************
+ */
+
+#ifndef M0_SIM_H_
+#define M0_SIM_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**********************************************************************************************************************
+ * Includes
+ *********************************************************************************************************************/
+#include <stdint.h>
+#include <stdbool.h>
+
+/**********************************************************************************************************************
+ * Exported definitions and macros
+ *********************************************************************************************************************/
+#define M0_SIM_REGIONS          4           //!< Max. memory regions.
+#define M0_SIM_RETURN           0xFFFFFFF0UL    //!< Return address of called function, simulation stops there.
+#define M0_SIM_SP               13          //!< Stack pointer register.
+#define M0_SIM_LR               14          //!< Link register.
+#define M0_SIM_PC               15          //!< Program counter register.
+// LPC11U68 memory map and flash timing at 48 MHz, Chip_SetupXtalClocking() sets FLASHTIM_2CLK_CPU.
+#define M0_SIM_FLASH_BASE       0x00000000UL    //!< On-chip flash base.
+#define M0_SIM_FLASH_SIZE       0x00040000UL    //!< On-chip flash size.
+#define M0_SIM_RAM_BASE         0x10000000UL    //!< SRAM0 base.
+#define M0_SIM_RAM_SIZE         0x00008000UL    //!< SRAM0 size.
+#define M0_SIM_FLASHTIM         1           //!< FMC FLASHTIM field of firmware, flash access takes FLASHTIM + 1 clocks.
+#define M0_SIM_WAIT_STATES      M0_SIM_FLASHTIM //!< Flash wait states, clocks of flash access above first one.
+
+/**********************************************************************************************************************
+ * Exported types
+ *********************************************************************************************************************/
+/**
+ * @brief   Simulation errors.
+ */
+typedef enum
+{
+    M0_SIM_OK = 0,              //!< No error.
+    M0_SIM_ERROR_FETCH,         //!< Instruction fetch outside of memory.
+    M0_SIM_ERROR_ACCESS,        //!< Data access outside of memory and peripherals.
+    M0_SIM_ERROR_ALIGN,         //!< Unaligned data access, hard fault on M0+.
+    M0_SIM_ERROR_UNDEFINED,     //!< Undefined or unsupported instruction.
+    M0_SIM_ERROR_BREAKPOINT,    //!< BKPT, SVC or branch to ARM state.
+    M0_SIM_ERROR_LIMIT,         //!< Cycle limit of call reached.
+} m0_sim_error_t;
+
+/**
+ * @brief   Simulator configuration.
+ */
+typedef struct
+{
+    uint32_t wait_states;       //!< Flash wait states, added to every flash access.
+    uint32_t mul_cycles;        //!< MULS cycles, 1 with fast multiplier, 32 with small one.
+    /** Peripheral read, NULL - reads are 0. Writes to peripherals are dropped. */
+    uint32_t (*periph_read)(void *argument, uint32_t addr, uint32_t size);
+    void *periph_argument;      //!< Peripheral read argument.
+} m0_sim_config_t;
+
+/**
+ * @brief   Memory region.
+ */
+typedef struct
+{
+    uint32_t base;              //!< Base address.
+    uint32_t size;              //!< Size in bytes, 0 - region unused.
+    uint32_t wait_states;       //!< Wait states of every access.
+    uint8_t *data;              //!< Contents.
+} m0_sim_region_t;
+
+/**
+ * @brief   Simulator state.
+ */
+typedef struct
+{
+    m0_sim_config_t config;                     //!< Configuration. See @ref m0_sim_config_t.
+    m0_sim_region_t region[M0_SIM_REGIONS];     //!< Memory regions. See @ref m0_sim_region_t.
+    uint32_t r[16];                             //!< Core registers.
+    bool n;                                     //!< Negative flag.
+    bool z;                                     //!< Zero flag.
+    bool c;                                     //!< Carry flag.
+    bool v;                                     //!< Overflow flag.
+    bool primask;                               //!< Interrupts masked.
+    uint64_t cycles;                            //!< Cycles executed.
+    uint64_t instructions;                      //!< Instructions executed.
+    uint32_t stall;                             //!< Wait cycles of current instruction.
+    uint32_t fetch_word;                        //!< Address of last fetched flash word.
+    uint64_t fetch_ready;                       //!< Cycle last fetched word was ready.
+    uint64_t fetch_used;                        //!< Cycle last fetched word started to execute.
+    bool fetch_flush;                           //!< Pipeline was flushed by branch.
+    m0_sim_error_t error;                       //!< Error that stopped simulation. See @ref m0_sim_error_t.
+    uint32_t error_addr;                        //!< Address of error.
+} m0_sim_t;
+
+/**********************************************************************************************************************
+ * Prototypes of exported constants
+ *********************************************************************************************************************/
+
+/**********************************************************************************************************************
+ * Prototypes of exported variables
+ *********************************************************************************************************************/
+
+/**********************************************************************************************************************
+ * Prototypes of exported functions
+ *********************************************************************************************************************/
+/**
+ * @brief   Initialize simulator with LPC11U68 flash and SRAM0.
+ *
+ * @param   sim     Pointer to simulator. See @ref m0_sim_t.
+ * @param   config  Pointer to configuration. See @ref m0_sim_config_t.
+ *
+ * @return  State of initialization.
+ * @retval  0   failed, out of memory.
+ * @retval  1   success.
+ */
+bool m0_sim_init(m0_sim_t *sim, const m0_sim_config_t *config);
+
+/**
+ * @brief   Free simulator memory.
+ *
+ * @param   sim Pointer to simulator. See @ref m0_sim_t.
+ */
+void m0_sim_free(m0_sim_t *sim);
+
+/**
+ * @brief   Write memory without timing, for program loading.
+ *
+ * @param   sim     Pointer to simulator. See @ref m0_sim_t.
+ * @param   addr    Start address.
+ * @param   data    Data, NULL - zero fill.
+ * @param   size    Size in bytes.
+ *
+ * @return  State of write.
+ * @retval  0   range is not inside one region.
+ * @retval  1   success.
+ */
+bool m0_sim_load(m0_sim_t *sim, uint32_t addr, const void *data, uint32_t size);
+
+/**
+ * @brief   Prepare function call: arguments in r0 - r3, stack at SRAM0 end, return to @ref M0_SIM_RETURN.
+ *
+ * @param   sim     Pointer to simulator. See @ref m0_sim_t.
+ * @param   entry   Function address, Thumb bit is ignored.
+ * @param   args    Arguments.
+ * @param   count   Arguments count, max. 4.
+ */
+void m0_sim_enter(m0_sim_t *sim, uint32_t entry, const uint32_t *args, uint32_t count);
+
+/**
+ * @brief   Execute one instruction.
+ *
+ * @param   sim Pointer to simulator. See @ref m0_sim_t.
+ *
+ * @return  State of execution, error is in sim->error.
+ * @retval  0   error.
+ * @retval  1   success.
+ */
+bool m0_sim_step(m0_sim_t *sim);
+
+/**
+ * @brief   Call function and run it until it returns.
+ *
+ * @param   sim     Pointer to simulator. See @ref m0_sim_t.
+ * @param   entry   Function address, Thumb bit is ignored.
+ * @param   args    Arguments.
+ * @param   count   Arguments count, max. 4.
+ * @param   limit   Max. cycles of call.
+ * @param   result  Pointer to r0 at return, NULL - not needed.
+ *
+ * @return  State of call, error is in sim->error.
+ * @retval  0   error.
+ * @retval  1   success.
+ */
+bool m0_sim_call(m0_sim_t *sim, uint32_t entry, const uint32_t *args, uint32_t count, uint64_t limit,
+                 uint32_t *result);
+
+/**
+ * @brief   Get error description.
+ *
+ * @param   error   Error. See @ref m0_sim_error_t.
+ *
+ * @return  Error text.
+ */
+const char *m0_sim_error_text(m0_sim_error_t error);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* M0_SIM_H_ */
@@ -0,0 +1,147 @@
+/**
+ **********************************************************************************************************************
+ * @file        m0_cost_target.c
+ * @author      Diamond Sparrow
+ * @version     1.0.0.0
+ * @date        2026-10-16
+ * @brief       Cortex-M0+ cycle cost estimator hot function entries, built for target C source file.
+ **********************************************************************************************************************
+ * @warning     THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR \n
+ *              IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND\n
+ *              FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR\n
+ *              CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL\n
+ *              DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,\n
+ *              DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN\n
+ *              CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF\n
+ *              THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ **********************************************************************************************************************
+ */
+
+/**********************************************************************************************************************
+ * Includes
+ *********************************************************************************************************************/
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+
+#include "sin_detect.h"
+#include "filters.h"
+#include "goertzel.h"
+#include "pll.h"
+#include "spectrum.h"
+#include "yin.h"
+
+/**********************************************************************************************************************
+ * Private definitions and macros
+ *********************************************************************************************************************/
+// Engine parameters mirror detection engine configuration in sin_detect.c, as in benchmark.
+#define M0_COST_GOERTZEL_BINS   16      //!< Goertzel bins count.
+#define M0_COST_GOERTZEL_BLOCK  214     //!< Goertzel block size in samples, bins overlap at 5 kHz.
+#define M0_COST_YIN_WINDOW      256     //!< YIN integration window in samples.
+#define M0_COST_YIN_HOP         64      //!< YIN samples between estimates.
+#define M0_COST_DMA_BLOCK       64      //!< Samples of ADC DMA block.
+#define M0_COST_PERIOD          ((uint32_t)(SIN_DETECT_CLOCK / SIN_DETECT_RATE))   //!< Sample period in clocks.
+
+/**********************************************************************************************************************
+ * Private variables
+ *********************************************************************************************************************/
+static sin_detect_t m0_cost_detect;
+static sin_detect_t m0_cost_detect_timed;
+static sin_detect_t m0_cost_detect_block;
+static filters_low_pass_t m0_cost_low_pass;
+static goertzel_t m0_cost_goertzel;
+static pll_t m0_cost_pll;
+static spectrum_t m0_cost_spectrum;
+static yin_t m0_cost_yin;
+/** Samples collected for block functions. */
+static uint16_t m0_cost_block[M0_COST_DMA_BLOCK];
+static uint16_t m0_cost_spectrum_block[SIN_DETECT_FFT_SIZE];
+static int16_t m0_cost_spectrum_work[SIN_DETECT_FFT_SIZE];
+static uint32_t m0_cost_count = 0;
+static uint32_t m0_cost_spectrum_count = 0;
+static uint32_t m0_cost_time = 0;
+
+/**********************************************************************************************************************
+ * Exported functions
+ *********************************************************************************************************************/
+/*
+ * Simulator calls m0_cost_init() once, then every m0_cost_run_<name>(sample) once per sample. Each entry returns
+ * result, so compiler can not drop the work. Add new hot functions here.
+ */
+uint32_t m0_cost_init(void)
+{
+    bool ret = true;
+
+    memset(&m0_cost_low_pass, 0, sizeof(m0_cost_low_pass));
+    ret = ret && sin_detect_init(&m0_cost_detect, &sin_detect_config_main);
+    ret = ret && sin_detect_init(&m0_cost_detect_timed, &sin_detect_config_main);
+    ret = ret && sin_detect_init(&m0_cost_detect_block, &sin_detect_config_main);
+    ret = ret && goertzel_init(&m0_cost_goertzel, SIN_DETECT_RATE, 50.0F, 400.0F, M0_COST_GOERTZEL_BINS,
+                               M0_COST_GOERTZEL_BLOCK);
+    ret = ret && pll_init(&m0_cost_pll, SIN_DETECT_RATE, 20.0F, 600.0F, 5.0F);
+    ret = ret && spectrum_init(&m0_cost_spectrum, SIN_DETECT_FFT_SIZE, SIN_DETECT_RATE, 20.0F, 12);
+    ret = ret && yin_init(&m0_cost_yin, SIN_DETECT_RATE, 50.0F, 500.0F, M0_COST_YIN_WINDOW, M0_COST_YIN_HOP, 0.5F);
+
+    return ret ? 1 : 0;
+}
+
+uint32_t m0_cost_run_sin_detect_process(uint32_t sample)
+{
+    sin_detect_process(&m0_cost_detect, sample);
+
+    return m0_cost_detect.data.frequncy;
+}
+
+uint32_t m0_cost_run_sin_detect_process_timed(uint32_t sample)
+{
+    m0_cost_time += M0_COST_PERIOD;
+    sin_detect_process_timed(&m0_cost_detect_timed, sample, m0_cost_time);
+
+    return m0_cost_detect_timed.data.frequncy;
+}
+
+uint32_t m0_cost_run_sin_detect_process_block(uint32_t sample)
+{
+    // Block of ADC DMA is processed when its last sample comes.
+    m0_cost_block[m0_cost_count++ % M0_COST_DMA_BLOCK] = (uint16_t)sample;
+    if((m0_cost_count % M0_COST_DMA_BLOCK) == 0)
+    {
+        sin_detect_process_block(&m0_cost_detect_block, m0_cost_block, M0_COST_DMA_BLOCK);
+    }
+
+    return m0_cost_detect_block.data.frequncy;
+}
+
+uint32_t m0_cost_run_filters_low_pass(uint32_t sample)
+{
+    filters_low_pass(&m0_cost_low_pass, (int32_t)sample << 16, (uint32_t)(0.75F * FILTERS_CUT_OFF_ONE));
+
+    return (uint32_t)m0_cost_low_pass.output;
+}
+
+uint32_t m0_cost_run_goertzel_process(uint32_t sample)
+{
+    return goertzel_process(&m0_cost_goertzel, sample) ? goertzel_peak(&m0_cost_goertzel, 4, 50) : 0;
+}
+
+uint32_t m0_cost_run_pll_process(uint32_t sample)
+{
+    return pll_process(&m0_cost_pll, sample) + pll_frequency(&m0_cost_pll);
+}
+
+uint32_t m0_cost_run_spectrum_estimate(uint32_t sample)
+{
+    m0_cost_spectrum_block[m0_cost_spectrum_count++] = (uint16_t)sample;
+    if(m0_cost_spectrum_count < SIN_DETECT_FFT_SIZE)
+    {
+        return 0;
+    }
+    m0_cost_spectrum_count = 0;
+
+    return spectrum_estimate(&m0_cost_spectrum, m0_cost_spectrum_block, m0_cost_spectrum_work);
+}
+
+uint32_t m0_cost_run_yin(uint32_t sample)
+{
+    return yin_push(&m0_cost_yin, sample) ? yin_estimate(&m0_cost_yin) : 0;
+}
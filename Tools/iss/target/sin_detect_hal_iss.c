@@ -0,0 +1,98 @@
+/**
+ **********************************************************************************************************************
+ * @file        sin_detect_hal_iss.c
+ * @author      Diamond Sparrow
+ * @version     1.0.0.0
+ * @date        2026-10-16
+ * @brief       Sinusoidal signal frequency detection hardware abstraction of cycle cost simulation C source file.
+ **********************************************************************************************************************
+ * @warning     THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR \n
+ *              IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND\n
+ *              FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR\n
+ *              CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL\n
+ *              DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,\n
+ *              DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN\n
+ *              CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF\n
+ *              THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ **********************************************************************************************************************
+ */
+
+/**********************************************************************************************************************
+ * Includes
+ *********************************************************************************************************************/
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "debug.h"
+#include "sin_detect_hal.h"
+
+/**********************************************************************************************************************
+ * Private variables
+ *********************************************************************************************************************/
+/** LED states, store keeps cost of GPIO write. */
+static volatile uint32_t sin_detect_hal_iss_led = 0;
+/** Critical section nesting depth. */
+static volatile uint32_t sin_detect_hal_iss_lock = 0;
+
+/**********************************************************************************************************************
+ * Exported functions
+ *********************************************************************************************************************/
+void sin_detect_hal_led(uint32_t led, bool on)
+{
+    if(led >= 32)
+    {
+        return;
+    }
+
+    if(on)
+    {
+        sin_detect_hal_iss_led |= (1UL << led);
+    }
+    else
+    {
+        sin_detect_hal_iss_led &= ~(1UL << led);
+    }
+
+    return;
+}
+
+uint32_t sin_detect_hal_get_time(void)
+{
+    // Simulator counts cycles itself.
+    return 0;
+}
+
+uint32_t sin_detect_hal_lock(void)
+{
+    // No interrupts in simulation, section only nests.
+    return sin_detect_hal_iss_lock++;
+}
+
+void sin_detect_hal_unlock(uint32_t state)
+{
+    sin_detect_hal_iss_lock = state;
+
+    return;
+}
+
+bool sin_detect_hal_work_start(sin_detect_hal_work_t *work)
+{
+    work->id = work;
+
+    return true;
+}
+
+void sin_detect_hal_work_signal(sin_detect_hal_work_t *work)
+{
+    // No threads in simulation, work cost is part of call that signals it.
+    work->func(work->argument);
+
+    return;
+}
+
+void debug_send_os(const char *fmt, ...)
+{
+    (void)fmt;
+
+    return;
+}
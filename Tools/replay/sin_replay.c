@@ -0,0 +1,537 @@
+/**
+ **********************************************************************************************************************
+ * @file        sin_replay.c
+ * @author      Diamond Sparrow
+ * @version     1.0.0.0
+ * @date        2026-10-16
+ * @brief       Raw sample capture record and replay tool C source file.
+ **********************************************************************************************************************
+ * @warning     THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR \n
+ *              IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND\n
+ *              FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR\n
+ *              CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL\n
+ *              DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,\n
+ *              DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN\n
+ *              CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF\n
+ *              THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ **********************************************************************************************************************
+ */
+
+/**********************************************************************************************************************
+ * Includes
+ *********************************************************************************************************************/
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <getopt.h>
+
+#include "capture.h"
+#include "sin_detect.h"
+#include "waveform.h"
+
+/**********************************************************************************************************************
+ * Private definitions and macros
+ *********************************************************************************************************************/
+#define REPLAY_FREQ             200.0       //!< Default recorded signal frequency in Hz.
+#define REPLAY_TIME             5.0         //!< Default record length in s.
+#define REPLAY_PRINT_MAX        10          //!< Mismatches printed without verbose.
+// Recorder mirrors firmware capture with ADC_DMA and ADC_ADAPTIVE, see adc.c.
+#define REPLAY_BLOCK            64          //!< Samples per block, ADC_DMA_BLOCK.
+#define REPLAY_HEADER_PERIOD    64          //!< Blocks between headers, ADC_CAPTURE_HEADER.
+#define REPLAY_TEXT_PERIOD      8           //!< Blocks between debug text lines mixed into capture.
+
+/**********************************************************************************************************************
+ * Private typedef
+ *********************************************************************************************************************/
+/**
+ * @brief   Replayed channel.
+ */
+typedef struct
+{
+    sin_detect_t detect;        //!< Detector fed by captured samples.
+    capture_output_t previous;  //!< Output before last block, device may report it while its thread still works.
+} replay_channel_t;
+
+/**
+ * @brief   Replay statistics.
+ */
+typedef struct
+{
+    uint32_t blocks;            //!< Sample records.
+    uint32_t outputs;           //!< Output records.
+    uint32_t compared;          //!< Outputs compared.
+    uint32_t mismatches;        //!< Outputs that differ.
+    uint32_t uncompared;        //!< Outputs not compared, after gap or before first header.
+    uint32_t gaps;              //!< Sequence gaps, lost records.
+    uint32_t restarts;          //!< Device restarts, sequence returned to 0.
+} replay_stats_t;
+
+/**********************************************************************************************************************
+ * Private constants
+ *********************************************************************************************************************/
+
+/**********************************************************************************************************************
+ * Private variables
+ *********************************************************************************************************************/
+/** Replayed channels, detector state is too large for stack with some engines. */
+static replay_channel_t replay_channel[CAPTURE_CHANNELS_MAX];
+/** Samples of block, channel k is at [k]. */
+static uint16_t replay_samples[CAPTURE_CHANNELS_MAX][CAPTURE_SAMPLES_MAX];
+/** Capture parser. */
+static capture_parser_t replay_parser;
+
+/**********************************************************************************************************************
+ * Exported variables
+ *********************************************************************************************************************/
+
+/**********************************************************************************************************************
+ * Prototypes of local functions
+ *********************************************************************************************************************/
+/**
+ * @brief   Take detector output the way firmware capture does.
+ *
+ * @param   detect      Pointer to detector. See @ref sin_detect_t.
+ * @param   sequence    Samples processed by detector.
+ * @param   channel     Channel index.
+ * @param   output      Pointer to output to fill. See @ref capture_output_t.
+ */
+static void replay_output(sin_detect_t *detect, uint32_t sequence, uint32_t channel, capture_output_t *output);
+
+/**
+ * @brief   Compare device and replay outputs.
+ *
+ * @param   device  Pointer to device output. See @ref capture_output_t.
+ * @param   replay  Pointer to replay output. See @ref capture_output_t.
+ *
+ * @return  State of comparison.
+ * @retval  0   outputs differ.
+ * @retval  1   outputs are equal.
+ */
+static bool replay_equal(const capture_output_t *device, const capture_output_t *replay);
+
+/**
+ * @brief   Record synthetic capture, host detector plays device.
+ *
+ * @param   path        Capture file.
+ * @param   freq        Signal frequency in Hz.
+ * @param   freq_end    Frequency at end of capture in Hz, 0 - no sweep.
+ * @param   time        Capture length in s.
+ * @param   gap         Block whose records are dropped, as if capture queue overflowed, 0 - none.
+ * @param   restart     Block at which device restarts, sequence and detector start again, 0 - none.
+ *
+ * @return  Exit code.
+ */
+static int replay_record(const char *path, double freq, double freq_end, double time, uint32_t gap,
+                         uint32_t restart);
+
+/**
+ * @brief   Replay capture through detector and compare outputs with device.
+ *
+ * @param   path    Capture file, raw debug UART dump is fine.
+ * @param   csv     Outputs comparison file, NULL - none.
+ * @param   verbose Flag that shows if every mismatch is printed.
+ *
+ * @return  Exit code: 0 - outputs match, 1 - error or nothing compared, 2 - mismatch.
+ */
+static int replay_run(const char *path, const char *csv, bool verbose);
+
+/**
+ * @brief   Print usage.
+ *
+ * @param   name    Program name.
+ */
+static void replay_usage(const char *name);
+
+/**********************************************************************************************************************
+ * Exported functions
+ *********************************************************************************************************************/
+int main(int argc, char **argv)
+{
+    static const struct option options[] =
+    {
+        {"record",      no_argument,        NULL, 'R'},
+        {"freq",        required_argument,  NULL, 'f'},
+        {"freq-end",    required_argument,  NULL, 'e'},
+        {"time",        required_argument,  NULL, 't'},
+        {"gap",         required_argument,  NULL, 'g'},
+        {"restart",     required_argument,  NULL, 's'},
+        {"output",      required_argument,  NULL, 'o'},
+        {"verbose",     no_argument,        NULL, 'v'},
+        {"help",        no_argument,        NULL, 'h'},
+        {NULL,          0,                  NULL, 0},
+    };
+    const char *csv = NULL;
+    double freq = REPLAY_FREQ;
+    double freq_end = 0;
+    double time = REPLAY_TIME;
+    uint32_t gap = 0;
+    uint32_t restart = 0;
+    bool record = false;
+    bool verbose = false;
+    int opt = 0;
+
+    while((opt = getopt_long(argc, argv, "Rf:e:t:g:s:o:vh", options, NULL)) != -1)
+    {
+        switch(opt)
+        {
+            case 'R': record = true; break;
+            case 'f': freq = atof(optarg); break;
+            case 'e': freq_end = atof(optarg); break;
+            case 't': time = atof(optarg); break;
+            case 'g': gap = (uint32_t)strtoul(optarg, NULL, 0); break;
+            case 's': restart = (uint32_t)strtoul(optarg, NULL, 0); break;
+            case 'o': csv = optarg; break;
+            case 'v': verbose = true; break;
+            case 'h':
+                replay_usage(argv[0]);
+                return 0;
+            default:
+                replay_usage(argv[0]);
+                return 1;
+        }
+    }
+    if(optind != argc - 1 || freq <= 0 || time <= 0)
+    {
+        replay_usage(argv[0]);
+        return 1;
+    }
+
+    return record ? replay_record(argv[optind], freq, freq_end, time, gap, restart) : replay_run(argv[optind], csv, verbose);
+}
+
+/**********************************************************************************************************************
+ * Private functions
+ *********************************************************************************************************************/
+static void replay_output(sin_detect_t *detect, uint32_t sequence, uint32_t channel, capture_output_t *output)
+{
+    sin_detect_output_t snapshot = {0};
+
+    sin_detect_get_output(detect, &snapshot);
+    output->sequence = sequence;
+    output->channel = (uint8_t)channel;
+    output->flags = snapshot.valid ? CAPTURE_OUTPUT_VALID : 0;
+    output->flags |= snapshot.state ? CAPTURE_OUTPUT_STATE : 0;
+    output->divider = (uint16_t)snapshot.divider;
+    output->frequency = snapshot.frequency;
+
+    return;
+}
+
+static bool replay_equal(const capture_output_t *device, const capture_output_t *replay)
+{
+    return (device->flags == replay->flags) && (device->divider == replay->divider)
+           && (device->frequency == replay->frequency);
+}
+
+static int replay_record(const char *path, double freq, double freq_end, double time, uint32_t gap,
+                         uint32_t restart)
+{
+    static uint8_t record[CAPTURE_SAMPLES_SIZE(REPLAY_BLOCK) + CAPTURE_OUTPUT_SIZE];
+    const uint32_t step = (uint32_t)(SIN_DETECT_CLOCK / SIN_DETECT_RATE);
+    waveform_config_t config =
+    {
+        .rate = SIN_DETECT_RATE,
+        .freq = freq,
+        .freq_end = freq_end,
+        .sweep_time = (freq_end > 0) ? time : 0,
+        .amplitude = 800.0,
+        .offset = 2048.0,
+        .noise = 2.0,
+    };
+    capture_header_t header =
+    {
+        .version = CAPTURE_VERSION,
+        .channels = 1,
+        .bits = CAPTURE_BITS,
+        .flags = CAPTURE_FLAG_TIMESTAMPS,
+        .rate = (uint32_t)(SIN_DETECT_RATE * 1000.0F),
+        .clock = (uint32_t)SIN_DETECT_CLOCK,
+    };
+    capture_block_t block = {0};
+    capture_output_t output = {0};
+    sin_detect_t *detect = &replay_channel[0].detect;
+    uint64_t samples = (uint64_t)(time * SIN_DETECT_RATE);
+    uint64_t n = 0;
+    uint64_t start = 0;
+    uint32_t divider = 1;
+    uint32_t blocks = 0;
+    uint32_t headed = 0;
+    uint32_t size = 0;
+    uint32_t i = 0;
+    uint32_t j = 0;
+    waveform_t wave;
+    FILE *out = NULL;
+
+    if(!waveform_init(&wave, &config) || !sin_detect_init(detect, &sin_detect_config_main))
+    {
+        fprintf(stderr, "Can not initialize recorder.\n");
+        return 1;
+    }
+    if((out = fopen(path, "wb")) == NULL)
+    {
+        fprintf(stderr, "Can not write %s.\n", path);
+        return 1;
+    }
+
+    // Generator runs at full rate, divided rate takes every divider-th sample, as sampling timer would.
+    while(n + (REPLAY_BLOCK * divider) <= samples)
+    {
+        if(restart != 0 && blocks == restart)
+        {
+            // Device reset, signal goes on, but sequence, timer and detector start from zero.
+            if(!sin_detect_init(detect, &sin_detect_config_main))
+            {
+                fclose(out);
+                return 1;
+            }
+            block.sequence = 0;
+            start = n;
+            headed = 0;
+            divider = 1;
+        }
+        block.count = REPLAY_BLOCK;
+        block.time = (uint32_t)((n - start) * step);
+        block.period = step * divider;
+        for(i = 0; i < REPLAY_BLOCK; i++)
+        {
+            replay_samples[0][i] = (uint16_t)waveform_next(&wave);
+            for(j = 1; j < divider; j++)
+            {
+                waveform_next(&wave);
+            }
+        }
+        n += REPLAY_BLOCK * divider;
+        sin_detect_process_block_timed(detect, replay_samples[0], block.count, block.time, block.period);
+        replay_output(detect, block.sequence + block.count, 0, &output);
+
+        if((headed % REPLAY_HEADER_PERIOD) == 0)
+        {
+            size = capture_write_header(record, sizeof(record), &header);
+            fwrite(record, 1, size, out);
+        }
+        headed++;
+        // Dropped block is processed by detector, only its records are lost.
+        if(gap == 0 || blocks != gap)
+        {
+            size = capture_write_samples(record, sizeof(record), &header, &block, &replay_samples[0][0],
+                                         CAPTURE_SAMPLES_MAX);
+            size += capture_write_output(&record[size], sizeof(record) - size, &output);
+            fwrite(record, 1, size, out);
+        }
+        // Device debug text shares UART with records.
+        if((blocks % REPLAY_TEXT_PERIOD) == 0)
+        {
+            fprintf(out, "Sin detect: %d, %.03f Hz;\r\n", detect->data.state,
+                    (double)output.frequency / SIN_DETECT_FREQ_ONE);
+        }
+        block.sequence += block.count;
+        blocks++;
+        // Rate changes between blocks only, like in DMA interrupt.
+        divider = (output.divider != 0) ? output.divider : 1;
+    }
+    fclose(out);
+    printf("Recorded %lu blocks, %.2f s of %.1f Hz%s to %s.\n", (unsigned long)blocks, (double)n / SIN_DETECT_RATE,
+           freq, (freq_end > 0) ? " sweep" : "", path);
+
+    return 0;
+}
+
+static int replay_run(const char *path, const char *csv, bool verbose)
+{
+    capture_header_t header = {0};
+    capture_block_t block = {0};
+    capture_output_t device = {0};
+    capture_output_t replay = {0};
+    replay_stats_t stats = {0};
+    uint32_t processed = 0;
+    bool headed = false;
+    bool aligned = false;
+    bool equal = false;
+    FILE *in = NULL;
+    FILE *out = NULL;
+    uint32_t i = 0;
+    uint32_t k = 0;
+    int c = 0;
+
+    if((in = fopen(path, "rb")) == NULL)
+    {
+        fprintf(stderr, "Can not read %s.\n", path);
+        return 1;
+    }
+    if(csv != NULL)
+    {
+        if((out = fopen(csv, "w")) == NULL)
+        {
+            fprintf(stderr, "Can not write %s.\n", csv);
+            fclose(in);
+            return 1;
+        }
+        fprintf(out, "sequence,channel,device_flags,device_divider,device_hz,replay_flags,replay_divider,replay_hz,"
+                "match\n");
+    }
+
+    capture_parser_init(&replay_parser);
+    while((c = fgetc(in)) != EOF)
+    {
+        switch(capture_parse(&replay_parser, (uint8_t)c))
+        {
+            case CAPTURE_RECORD_HEADER:
+                if(!capture_read_header(&replay_parser, &header))
+                {
+                    fprintf(stderr, "Unsupported capture header.\n");
+                    headed = false;
+                    break;
+                }
+                if(!headed)
+                {
+                    printf("Capture: %u channels, %.3f Hz, clock %lu Hz, %s, board %08lX-%08lX-%08lX-%08lX, "
+                           "firmware v%d.%d-%c%d.\n", header.channels, (double)header.rate / 1000.0,
+                           (unsigned long)header.clock,
+                           (header.flags & CAPTURE_FLAG_TIMESTAMPS) ? "timestamps" : "no timestamps",
+                           (unsigned long)header.board[0], (unsigned long)header.board[1],
+                           (unsigned long)header.board[2], (unsigned long)header.board[3], header.firmware[0],
+                           header.firmware[1], (header.firmware[2] >= ' ') ? header.firmware[2] : '-', header.firmware[3]);
+                }
+                headed = true;
+                break;
+
+            case CAPTURE_RECORD_SAMPLES:
+                if(!headed || !capture_read_samples(&replay_parser, &header, &block, &replay_samples[0][0],
+                                                    CAPTURE_SAMPLES_MAX))
+                {
+                    break;
+                }
+                stats.blocks++;
+                // Sequence 0 is device start, detectors start with it, so outputs can match exactly.
+                if(block.sequence == 0)
+                {
+                    if(aligned || processed != 0)
+                    {
+                        stats.restarts++;
+                    }
+                    for(k = 0; k < header.channels; k++)
+                    {
+                        if(!sin_detect_init(&replay_channel[k].detect, &sin_detect_config_main))
+                        {
+                            fprintf(stderr, "Can not initialize detector.\n");
+                            fclose(in);
+                            return 1;
+                        }
+                    }
+                    aligned = true;
+                }
+                else if(block.sequence != processed)
+                {
+                    // Detector missed samples device had, its state diverged for good.
+                    if(aligned)
+                    {
+                        printf("Gap at sample %lu, %lu samples lost, outputs after it are not compared.\n",
+                               (unsigned long)processed, (unsigned long)(block.sequence - processed));
+                    }
+                    stats.gaps++;
+                    aligned = false;
+                }
+                if(!aligned)
+                {
+                    processed = block.sequence + block.count;
+                    break;
+                }
+                for(k = 0; k < header.channels; k++)
+                {
+                    replay_output(&replay_channel[k].detect, processed, k, &replay_channel[k].previous);
+                    if(header.flags & CAPTURE_FLAG_TIMESTAMPS)
+                    {
+                        sin_detect_process_block_timed(&replay_channel[k].detect, replay_samples[k], block.count,
+                                                       block.time, block.period);
+                    }
+                    else
+                    {
+                        for(i = 0; i < block.count; i++)
+                        {
+                            sin_detect_process(&replay_channel[k].detect, replay_samples[k][i]);
+                        }
+                    }
+                }
+                processed = block.sequence + block.count;
+                break;
+
+            case CAPTURE_RECORD_OUTPUT:
+                if(!capture_read_output(&replay_parser, &device))
+                {
+                    break;
+                }
+                stats.outputs++;
+                if(!aligned || !headed || (device.channel >= header.channels) || (device.sequence != processed))
+                {
+                    stats.uncompared++;
+                    break;
+                }
+                replay_output(&replay_channel[device.channel].detect, processed, device.channel, &replay);
+                equal = replay_equal(&device, &replay);
+#if SIN_DETECT_THREAD
+                // Engine thread may not have finished block when device took output.
+                equal = equal || replay_equal(&device, &replay_channel[device.channel].previous);
+#endif // SIN_DETECT_THREAD
+                stats.compared++;
+                if(!equal)
+                {
+                    stats.mismatches++;
+                    if(verbose || (stats.mismatches <= REPLAY_PRINT_MAX))
+                    {
+                        printf("Mismatch at sample %lu, channel %u: device %.6f Hz flags %u divider %u, "
+                               "replay %.6f Hz flags %u divider %u.\n", (unsigned long)device.sequence,
+                               device.channel, (double)device.frequency / SIN_DETECT_FREQ_ONE, device.flags,
+                               device.divider, (double)replay.frequency / SIN_DETECT_FREQ_ONE, replay.flags,
+                               replay.divider);
+                    }
+                }
+                if(out != NULL)
+                {
+                    fprintf(out, "%lu,%u,%u,%u,%.6f,%u,%u,%.6f,%d\n", (unsigned long)device.sequence, device.channel,
+                            device.flags, device.divider, (double)device.frequency / SIN_DETECT_FREQ_ONE,
+                            replay.flags, replay.divider, (double)replay.frequency / SIN_DETECT_FREQ_ONE, equal);
+                }
+                break;
+
+            default:
+                break;
+        }
+    }
+    fclose(in);
+    if(out != NULL)
+    {
+        fclose(out);
+    }
+
+    printf("Records: %lu blocks, %lu outputs, %lu gaps, %lu restarts, %lu CRC errors, %lu text bytes.\n",
+           (unsigned long)stats.blocks, (unsigned long)stats.outputs, (unsigned long)stats.gaps,
+           (unsigned long)stats.restarts, (unsigned long)replay_parser.errors, (unsigned long)replay_parser.skipped);
+    printf("Outputs: %lu compared, %lu mismatches, %lu not compared.\n", (unsigned long)stats.compared,
+           (unsigned long)stats.mismatches, (unsigned long)stats.uncompared);
+    if(stats.compared == 0)
+    {
+        fprintf(stderr, "Nothing compared, capture must start at device start.\n");
+        return 1;
+    }
+
+    return (stats.mismatches == 0) ? 0 : 2;
+}
+
+static void replay_usage(const char *name)
+{
+    printf("Usage: %s [options] CAPTURE, replays capture through detector and compares outputs with device.\n"
+           "  -o, --output FILE        write outputs comparison to CSV file\n"
+           "  -v, --verbose            print every mismatch, default first %u\n"
+           "  -R, --record             record synthetic capture instead, host detector plays device\n"
+           "  -f, --freq HZ            recorded signal frequency, default %.0f\n"
+           "  -e, --freq-end HZ        recorded sweep end frequency, default no sweep\n"
+           "  -t, --time S             record length, default %.0f\n"
+           "  -g, --gap BLOCK          drop records of recorded block, default none\n"
+           "  -s, --restart BLOCK      restart recorded device at block, default none\n"
+           "Exit code: 0 - outputs match, 1 - error or nothing compared, 2 - mismatch.\n",
+           name, REPLAY_PRINT_MAX, REPLAY_FREQ, REPLAY_TIME);
+
+    return;
+}
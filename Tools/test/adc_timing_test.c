@@ -0,0 +1,381 @@
+/**
+ **********************************************************************************************************************
+ * @file        adc_timing_test.c
+ * @author      Diamond Sparrow
+ * @version     1.0.0.0
+ * @date        2026-10-16
+ * @brief       ADC housekeeping sequence timing test C source file.
+ **********************************************************************************************************************
+ * @warning     THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR \n
+ *              IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND\n
+ *              FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR\n
+ *              CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL\n
+ *              DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,\n
+ *              DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN\n
+ *              CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF\n
+ *              THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ **********************************************************************************************************************
+ */
+
+/**********************************************************************************************************************
+ * Includes
+ *********************************************************************************************************************/
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdio.h>
+
+#include "bsp/periph/adc_timing.h"
+
+/**********************************************************************************************************************
+ * Private definitions and macros
+ *********************************************************************************************************************/
+#define TEST_IRQ_CYCLES     40          //!< Sequence A interrupt entry till housekeeping start in cycles.
+#define TEST_DMA_CYCLES     200         //!< DMA interrupt work after settle till housekeeping start in cycles.
+#define TEST_LATE           8           //!< One of this many sequence A paths is late, delayed by other interrupt.
+#define TEST_REQUESTS       1000        //!< Housekeeping requests per divider.
+#define TEST_BLOCKS         2000        //!< DMA blocks of block timing test.
+#define TEST_SLIP           1000        //!< DMA block where one trigger is lost, timing must be taken again.
+#define TEST_READ_DELAY     3           //!< Trigger time offset of timer reads, differs from first trigger offset.
+/** Sequence A path calls housekeeping start once per this many triggers, DMA interrupt comes once per block. */
+#if ADC_DMA
+#define TEST_PATH_TRIGGERS  (ADC_DMA_BLOCK * ADC_OVERSAMPLE)
+#else
+#define TEST_PATH_TRIGGERS  1
+#endif // ADC_DMA
+
+/**********************************************************************************************************************
+ * Private variables
+ *********************************************************************************************************************/
+/** Failed checks count. */
+static uint32_t test_failed = 0;
+/** Pseudo random generator state. */
+static uint32_t test_seed = 12345;
+
+/**********************************************************************************************************************
+ * Prototypes of local functions
+ *********************************************************************************************************************/
+/**
+ * @brief   Record check result.
+ *
+ * @param   ok      Check result.
+ * @param   name    Check name.
+ * @param   value   Value to print.
+ */
+static void test_check(bool ok, const char *name, uint32_t value);
+
+/**
+ * @brief   Get pseudo random number.
+ *
+ * @return  Random number 0 - 32767.
+ */
+static uint32_t test_random(void);
+
+/**
+ * @brief   Run CT32B0 over three sequencer A periods and compare phase with time since trigger.
+ *
+ * @param   match   CT32B0 match value.
+ *
+ * @return  Ticks with wrong phase.
+ */
+static uint32_t test_phase(uint32_t match);
+
+/**
+ * @brief   Get phase of sequence A path call, where housekeeping sequence is started.
+ *
+ * @param   period  Sequencer A trigger period in core clock cycles.
+ * @param   late    Extra delay of sequence A path in core clock cycles.
+ * @param   seqa    Sequence A conversion time in core clock cycles.
+ *
+ * @return  Core clock cycles since last sequencer A trigger.
+ */
+static uint32_t test_path_phase(uint32_t period, uint32_t late, uint32_t seqa);
+
+/**
+ * @brief   Get max. sequencer A channels count, sequence of all of them must be converted before next trigger.
+ *
+ * @param   period          Sequencer A trigger period in core clock cycles.
+ * @param   housekeeping    Flag that shows if sequence B must fit after on time sequence A too.
+ *
+ * @return  Channels count.
+ */
+static uint32_t test_channels(uint32_t period, bool housekeeping);
+
+/**
+ * @brief   Run DMA block timing over blocks with random interrupt latency, rate changes and one lost trigger.
+ *
+ * @param   half    CT32B0 half period at full rate in core clock cycles.
+ * @param   wrong   Pointer to store count of blocks with wrong time.
+ * @param   unsafe  Pointer to store count of rate changes allowed after next block started.
+ * @param   missed  Pointer to store count of rate changes not allowed while next block did not start, when synced.
+ *
+ * @return  Times block timing was taken again from trigger time.
+ */
+static uint32_t test_block(uint32_t half, uint32_t *wrong, uint32_t *unsafe, uint32_t *missed);
+
+/**********************************************************************************************************************
+ * Exported functions
+ *********************************************************************************************************************/
+int main(void)
+{
+    // CT32B0 runs at sample rate times oversampling, as in app.c, MAT0 toggles, so half period is match plus one.
+    const uint32_t half = (uint32_t)SIN_DETECT_CLOCK / ((uint32_t)(SIN_DETECT_RATE * ADC_OVERSAMPLE) * 2);
+    const uint64_t timeout = (uint64_t)ADC_HK_TIMEOUT * (uint64_t)(SIN_DETECT_CLOCK / 1000.0F);
+    sin_detect_t detect;
+    uint64_t wait = 0;
+    uint64_t wait_max = 0;
+    uint32_t divider = 0;
+    uint32_t period = 0;
+    uint32_t phase = 0;
+    uint32_t late = 0;
+    uint32_t channels = 0;
+    uint32_t channels_hk = 0;
+    uint32_t end_max = 0;
+    uint32_t overlaps = 0;
+    uint32_t lost = 0;
+    uint32_t fits = 0;
+    uint32_t wrong = 0;
+    uint32_t unsafe = 0;
+    uint32_t missed = 0;
+    uint32_t resync = 0;
+    uint32_t i = 0;
+    bool init = false;
+    char name[64];
+
+    test_check(test_phase(1) == 0, "phase, match 1", 0);
+    test_check(test_phase(half - 1) == 0, "phase, full rate", half - 1);
+    test_check(test_phase((8 * half) - 1) == 0, "phase, divider 8", (8 * half) - 1);
+
+    // Rate divider of adaptive rate is limited by detector.
+    init = sin_detect_init(&detect, &sin_detect_config_main);
+    test_check(init && detect.divider_max >= 1, "divider max", detect.divider_max);
+    printf("sequence A %lu cycles, sequence B %lu cycles, half period %lu cycles\n",
+           (unsigned long)ADC_TIMING_SEQA_CYCLES, (unsigned long)ADC_TIMING_SEQB_CYCLES, (unsigned long)half);
+
+    // Full rate is shortest period, ADC conversion time limits channels count, CPU time of detectors is not counted.
+    channels = test_channels(2 * half, false);
+    channels_hk = test_channels(2 * half, true);
+    printf("channels at %.0f Hz, oversample %u: %lu, %lu with housekeeping\n", (double)SIN_DETECT_RATE,
+           ADC_OVERSAMPLE, (unsigned long)channels, (unsigned long)channels_hk);
+    test_check(ADC_ID_LAST <= (ADC_HOUSEKEEPING ? channels_hk : channels), "channels fit", ADC_ID_LAST);
+    for(divider = 1; divider <= detect.divider_max; divider++)
+    {
+        period = 2 * half * divider;
+
+        // Sequence B started in window must end before next trigger, window must hold on-time sequence A path.
+        fits = 0;
+        overlaps = 0;
+        for(phase = 0; phase < period; phase++)
+        {
+            if(adc_timing_seqb_fits(phase, period))
+            {
+                fits++;
+                if(phase < ADC_TIMING_SEQA_CYCLES
+                   || (phase + ADC_TIMING_SEQB_MARGIN + ADC_TIMING_SEQB_CYCLES) >= period)
+                {
+                    overlaps++;
+                }
+            }
+        }
+        phase = test_path_phase(period, 0, ADC_TIMING_SEQA_CYCLES);
+        snprintf(name, sizeof(name), "divider %lu, on time fits", (unsigned long)divider);
+        test_check(fits > 0 && overlaps == 0 && adc_timing_seqb_fits(phase, period), name,
+                   phase + ADC_TIMING_SEQB_MARGIN + ADC_TIMING_SEQB_CYCLES);
+
+        // Requests come at any time, some sequence A paths are late, late path leaves request for next one.
+        wait_max = 0;
+        end_max = 0;
+        lost = 0;
+        for(i = 0; i < TEST_REQUESTS; i++)
+        {
+            wait = ((uint64_t)test_random() * TEST_PATH_TRIGGERS * period) >> 15;
+            while(1)
+            {
+                late = ((test_random() % TEST_LATE) == 0) ? (test_random() % (2 * period)) : 0;
+                phase = test_path_phase(period, late, ADC_TIMING_SEQA_CYCLES);
+                if(adc_timing_seqb_fits(phase, period))
+                {
+                    break;
+                }
+                wait += (uint64_t)TEST_PATH_TRIGGERS * period;
+            }
+            if(wait >= timeout)
+            {
+                lost++;
+            }
+            if(wait > wait_max)
+            {
+                wait_max = wait;
+            }
+            if((phase + ADC_TIMING_SEQB_MARGIN + ADC_TIMING_SEQB_CYCLES) > end_max)
+            {
+                end_max = phase + ADC_TIMING_SEQB_MARGIN + ADC_TIMING_SEQB_CYCLES;
+            }
+        }
+        snprintf(name, sizeof(name), "divider %lu, phase max", (unsigned long)divider);
+        test_check(end_max < period, name, end_max);
+        snprintf(name, sizeof(name), "divider %lu, wait max us", (unsigned long)divider);
+        test_check(lost == 0, name, (uint32_t)((wait_max * 1000000) / (uint64_t)SIN_DETECT_CLOCK));
+    }
+
+    // DMA block time is counted on from first trigger, late interrupt or rate change must not move it.
+    resync = test_block(half, &wrong, &unsafe, &missed);
+    test_check(wrong == 0, "block time wrong", wrong);
+    test_check(unsafe == 0, "block rate change unsafe", unsafe);
+    test_check(missed == 0, "block rate change missed", missed);
+    test_check(resync == 1, "block lost trigger resync", resync);
+
+    printf("%s: %lu failed.\n", (test_failed == 0) ? "PASS" : "FAIL", (unsigned long)test_failed);
+
+    return (test_failed == 0) ? 0 : 1;
+}
+
+/**********************************************************************************************************************
+ * Private functions
+ *********************************************************************************************************************/
+static void test_check(bool ok, const char *name, uint32_t value)
+{
+    printf("%-4s %-30s %lu\n", ok ? "ok" : "FAIL", name, (unsigned long)value);
+    if(!ok)
+    {
+        test_failed++;
+    }
+
+    return;
+}
+
+static uint32_t test_random(void)
+{
+    test_seed = (test_seed * 1103515245) + 12345;
+
+    return (test_seed >> 16) & 0x7FFF;
+}
+
+static uint32_t test_phase(uint32_t match)
+{
+    const uint32_t period = 2 * (match + 1);
+    uint32_t count = 0;
+    uint32_t wrong = 0;
+    uint32_t tick = 0;
+    bool high = true;
+
+    // Timer starts at trigger, rising edge of MAT0, it resets on match and MAT0 toggles.
+    for(tick = 0; tick < (3 * period); tick++)
+    {
+        if(adc_timing_phase(count, high, match) != (tick % period))
+        {
+            wrong++;
+        }
+        if(count == match)
+        {
+            count = 0;
+            high = !high;
+        }
+        else
+        {
+            count++;
+        }
+    }
+
+    return wrong;
+}
+
+static uint32_t test_path_phase(uint32_t period, uint32_t late, uint32_t seqa)
+{
+    uint32_t phase = 0;
+
+#if ADC_DMA
+    // DMA interrupt comes after last sequence of block is moved, then starts housekeeping.
+    phase = ((seqa + late) % period) + TEST_DMA_CYCLES;
+#else
+    // Sequence A interrupt starts housekeeping first, before decimation.
+    phase = (seqa + TEST_IRQ_CYCLES + late) % period;
+#endif // ADC_DMA
+
+    return phase;
+}
+
+static uint32_t test_channels(uint32_t period, bool housekeeping)
+{
+    uint32_t channels = 0;
+    uint32_t seqa = 0;
+
+    // LPC11U6x ADC has 12 channels.
+    while(channels < 12)
+    {
+        seqa = ADC_TIMING_CYCLES(channels + 1);
+        if(seqa >= period || (housekeeping
+           && (test_path_phase(period, 0, seqa) + ADC_TIMING_SEQB_MARGIN + ADC_TIMING_SEQB_CYCLES) >= period))
+        {
+            break;
+        }
+        channels++;
+    }
+
+    return channels;
+}
+
+static uint32_t test_block(uint32_t half, uint32_t *wrong, uint32_t *unsafe, uint32_t *missed)
+{
+    const uint32_t triggers = ADC_DMA_BLOCK * ADC_OVERSAMPLE;
+    adc_timing_block_t block;
+    uint32_t period = 2 * half;
+    uint32_t first = 0x7FFFF000;
+    uint32_t last = 0;
+    uint32_t irq = 0;
+    uint32_t move = 0;
+    uint32_t ahead = 0;
+    uint32_t trigger = 0;
+    uint32_t done = 0;
+    uint32_t time = 0;
+    uint32_t n = 0;
+    uint32_t i = 0;
+    bool idle = false;
+
+    *wrong = 0;
+    *unsafe = 0;
+    *missed = 0;
+    // First trigger time is read at timer start with other delay than trigger time, offset is kept by all blocks.
+    adc_timing_block_init(&block, first);
+    for(n = 0; n < TEST_BLOCKS; n++)
+    {
+        // Lost trigger makes block one trigger longer.
+        last = first + ((triggers - ((n == TEST_SLIP) ? 0 : 1)) * period);
+        // Sequences are moved a bit after conversion, interrupt is late sometimes by up to two periods.
+        move = ADC_TIMING_SEQA_CYCLES + (test_random() % (ADC_TIMING_DMA_SETTLE - ADC_TIMING_SEQA_CYCLES));
+        irq = move + 12 + (((test_random() % TEST_LATE) == 0) ? (test_random() % (2 * period)) : 0);
+        ahead = irq / period;
+        trigger = last + (ahead * period);
+        done = 0;
+        for(i = 1; i <= ahead; i++)
+        {
+            if((irq - (i * period)) >= move)
+            {
+                done++;
+            }
+        }
+        time = adc_timing_block_done(&block, period, trigger + TEST_READ_DELAY, irq - (ahead * period), done, &idle);
+        // Timing taken again from trigger time has its offset.
+        if((n < TEST_SLIP || n > (TEST_SLIP + 8)) && block.synced
+           && (time - (last - ((triggers - 1) * period)) + TEST_READ_DELAY) > (2 * TEST_READ_DELAY))
+        {
+            (*wrong)++;
+        }
+        if(idle && ahead != 0)
+        {
+            (*unsafe)++;
+        }
+        if(!idle && ahead == 0 && block.synced)
+        {
+            (*missed)++;
+        }
+        // Rate changes like adaptive rate, only while no trigger came after last of block.
+        if(idle && (test_random() % 4) == 0)
+        {
+            period = 2 * half * (1 + (test_random() % 4));
+        }
+        adc_timing_block_next(&block, period);
+        first = last + period;
+    }
+
+    return block.resync;
+}
@@ -0,0 +1,293 @@
+/**
+ **********************************************************************************************************************
+ * @file        capture_test.c
+ * @author      Diamond Sparrow
+ * @version     1.0.0.0
+ * @date        2026-10-16
+ * @brief       Raw sample capture format packing and parser test C source file.
+ **********************************************************************************************************************
+ * @warning     THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR \n
+ *              IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND\n
+ *              FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR\n
+ *              CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL\n
+ *              DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,\n
+ *              DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN\n
+ *              CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF\n
+ *              THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ **********************************************************************************************************************
+ */
+
+/**********************************************************************************************************************
+ * Includes
+ *********************************************************************************************************************/
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "capture.h"
+
+/**********************************************************************************************************************
+ * Private definitions and macros
+ *********************************************************************************************************************/
+#define TEST_STRIDE         80          //!< Samples buffer distance between channels.
+#define TEST_STREAM_SIZE    2048        //!< Test stream buffer size.
+
+/**********************************************************************************************************************
+ * Private constants
+ *********************************************************************************************************************/
+/** Output record of sample 0x01020304, channel 1, valid and in band, divider 2, 200 Hz, pins wire format. */
+static const uint8_t test_output_record[CAPTURE_OUTPUT_SIZE] =
+{
+    0xA5, 0x5A, 0x03, 0x0C, 0x00, 0x04, 0x03, 0x02, 0x01, 0x01, 0x03, 0x02, 0x00, 0x00, 0x00, 0xC8,
+    0x00, 0x43, 0x70,
+};
+
+/** Debug text between records. */
+static const char test_text[] = "Sin detect: 1, 200.000 Hz;\r\n";
+
+/**********************************************************************************************************************
+ * Private variables
+ *********************************************************************************************************************/
+/** Failed checks count. */
+static uint32_t test_failed = 0;
+/** Test stream. */
+static uint8_t test_stream[TEST_STREAM_SIZE];
+/** Written samples, channel k at [k * TEST_STRIDE]. */
+static uint16_t test_samples[CAPTURE_CHANNELS_MAX * TEST_STRIDE];
+/** Read samples, channel k at [k * TEST_STRIDE]. */
+static uint16_t test_read[CAPTURE_CHANNELS_MAX * TEST_STRIDE];
+/** Parser. */
+static capture_parser_t test_parser;
+
+/**********************************************************************************************************************
+ * Prototypes of local functions
+ *********************************************************************************************************************/
+/**
+ * @brief   Record check result.
+ *
+ * @param   ok      Check result.
+ * @param   name    Check name.
+ * @param   value   Value to print.
+ */
+static void test_check(bool ok, const char *name, uint32_t value);
+
+/**
+ * @brief   Feed stream to parser.
+ *
+ * @param   data    Pointer to stream.
+ * @param   size    Stream size in bytes.
+ * @param   types   Pointer to types of completed records.
+ * @param   max     Max. records.
+ *
+ * @return  Completed records count.
+ */
+static uint32_t test_parse(const uint8_t *data, uint32_t size, capture_record_t *types, uint32_t max);
+
+/**
+ * @brief   Write samples record of test pattern, parse it back and compare.
+ *
+ * @param   channels    Channels count.
+ * @param   count       Samples per channel.
+ * @param   flags       Header flags.
+ *
+ * @return  State of round trip.
+ */
+static bool test_samples_round_trip(uint32_t channels, uint32_t count, uint8_t flags);
+
+/**********************************************************************************************************************
+ * Exported functions
+ *********************************************************************************************************************/
+int main(void)
+{
+    capture_header_t header =
+    {
+        .version = CAPTURE_VERSION,
+        .channels = 3,
+        .bits = CAPTURE_BITS,
+        .flags = CAPTURE_FLAG_TIMESTAMPS,
+        .rate = 5000000,
+        .clock = 48000000,
+        .map = {0, 2, 5},
+        .board = {0x11223344, 0x55667788, 0x99AABBCC, 0xDDEEFF00},
+        .firmware = {0, 1, 'a', 1},
+    };
+    capture_header_t read = {0};
+    capture_output_t output =
+    {
+        .sequence = 0x01020304,
+        .channel = 1,
+        .flags = CAPTURE_OUTPUT_VALID | CAPTURE_OUTPUT_STATE,
+        .divider = 2,
+        .frequency = 200UL << 16,
+    };
+    capture_output_t output_read = {0};
+    capture_block_t block = {.sequence = 0, .count = CAPTURE_SAMPLES_MAX + 1};
+    capture_record_t types[8];
+    uint32_t size = 0;
+    uint32_t total = 0;
+    uint32_t records = 0;
+
+    // Header and output survive round trip, output bytes are fixed by format.
+    size = capture_write_header(test_stream, sizeof(test_stream), &header);
+    test_check(size == CAPTURE_HEADER_SIZE, "header size", size);
+    records = test_parse(test_stream, size, types, 8);
+    test_check(records == 1 && types[0] == CAPTURE_RECORD_HEADER && capture_read_header(&test_parser, &read)
+               && memcmp(&read, &header, sizeof(header)) == 0, "header round trip", records);
+    size = capture_write_output(test_stream, sizeof(test_stream), &output);
+    test_check(size == CAPTURE_OUTPUT_SIZE && memcmp(test_stream, test_output_record, size) == 0, "output bytes",
+               size);
+    records = test_parse(test_stream, size, types, 8);
+    test_check(records == 1 && capture_read_output(&test_parser, &output_read)
+               && memcmp(&output_read, &output, sizeof(output)) == 0, "output round trip", records);
+
+    // Packing of even and odd sample totals, with and without timestamps.
+    test_check(test_samples_round_trip(1, 64, CAPTURE_FLAG_TIMESTAMPS), "samples 1 x 64", 64);
+    test_check(test_samples_round_trip(3, 5, CAPTURE_FLAG_TIMESTAMPS), "samples 3 x 5", 15);
+    test_check(test_samples_round_trip(2, 7, 0), "samples 2 x 7 no timestamps", 14);
+    test_check(test_samples_round_trip(8, TEST_STRIDE / 2, 0), "samples 8 x 40", 320);
+    test_check(test_samples_round_trip(1, 1, CAPTURE_FLAG_TIMESTAMPS), "samples 1 x 1", 1);
+    header.channels = 1;
+    size = capture_write_samples(test_stream, sizeof(test_stream), &header, &block, test_samples, TEST_STRIDE);
+    test_check(size == 0, "samples over max rejected", size);
+    block.count = 64;
+    size = capture_write_samples(test_stream, CAPTURE_SAMPLES_SIZE(64) - 1, &header, &block, test_samples,
+                                 TEST_STRIDE);
+    test_check(size == 0, "small buffer rejected", size);
+    size = capture_write_samples(test_stream, sizeof(test_stream), &header, &block, test_samples, TEST_STRIDE);
+    test_check(size == CAPTURE_SAMPLES_SIZE(64), "samples size", size);
+
+    // Text around records is skipped, corrupted record is dropped and next one is found.
+    total = 0;
+    memcpy(&test_stream[total], test_text, sizeof(test_text) - 1);
+    total += sizeof(test_text) - 1;
+    total += capture_write_output(&test_stream[total], sizeof(test_stream) - total, &output);
+    test_stream[total++] = CAPTURE_SYNC_0;
+    memcpy(&test_stream[total], test_text, sizeof(test_text) - 1);
+    total += sizeof(test_text) - 1;
+    size = capture_write_output(&test_stream[total], sizeof(test_stream) - total, &output);
+    test_stream[total + 9] ^= 0x10;
+    total += size;
+    total += capture_write_samples(&test_stream[total], sizeof(test_stream) - total, &header, &block, test_samples,
+                                   TEST_STRIDE);
+    memcpy(&test_stream[total], test_text, sizeof(test_text) - 1);
+    total += sizeof(test_text) - 1;
+    records = test_parse(test_stream, total, types, 8);
+    test_check(records == 2 && types[0] == CAPTURE_RECORD_OUTPUT && types[1] == CAPTURE_RECORD_SAMPLES,
+               "records found in text", records);
+    test_check(test_parser.errors == 1, "corrupted record dropped", test_parser.errors);
+    test_check(test_parser.skipped == (3 * (sizeof(test_text) - 1)) + 1, "text skipped", test_parser.skipped);
+
+    // Length above max is rejected before payload is collected.
+    test_stream[0] = CAPTURE_SYNC_0;
+    test_stream[1] = CAPTURE_SYNC_1;
+    test_stream[2] = CAPTURE_RECORD_SAMPLES;
+    test_stream[3] = 0xFF;
+    test_stream[4] = 0xFF;
+    size = capture_write_output(&test_stream[5], sizeof(test_stream) - 5, &output);
+    records = test_parse(test_stream, 5 + size, types, 8);
+    test_check(records == 1 && types[0] == CAPTURE_RECORD_OUTPUT && test_parser.errors == 1, "bad length dropped",
+               records);
+
+    printf("%s: %lu failed.\n", (test_failed == 0) ? "PASS" : "FAIL", (unsigned long)test_failed);
+
+    return (test_failed == 0) ? 0 : 1;
+}
+
+/**********************************************************************************************************************
+ * Private functions
+ *********************************************************************************************************************/
+static void test_check(bool ok, const char *name, uint32_t value)
+{
+    printf("%-4s %-30s %lu\n", ok ? "ok" : "FAIL", name, (unsigned long)value);
+    if(!ok)
+    {
+        test_failed++;
+    }
+
+    return;
+}
+
+static uint32_t test_parse(const uint8_t *data, uint32_t size, capture_record_t *types, uint32_t max)
+{
+    capture_record_t type = CAPTURE_RECORD_NONE;
+    uint32_t records = 0;
+    uint32_t i = 0;
+
+    capture_parser_init(&test_parser);
+    for(i = 0; i < size; i++)
+    {
+        type = capture_parse(&test_parser, data[i]);
+        if(type != CAPTURE_RECORD_NONE && records < max)
+        {
+            types[records++] = type;
+        }
+    }
+
+    return records;
+}
+
+static bool test_samples_round_trip(uint32_t channels, uint32_t count, uint8_t flags)
+{
+    const capture_header_t header =
+    {
+        .version = CAPTURE_VERSION,
+        .channels = (uint8_t)channels,
+        .bits = CAPTURE_BITS,
+        .flags = flags,
+    };
+    const capture_block_t block =
+    {
+        .sequence = 0xCAFE0040,
+        .count = count,
+        .time = 0x89ABCDEF,
+        .period = 9600,
+    };
+    capture_block_t read = {0};
+    capture_record_t type = CAPTURE_RECORD_NONE;
+    uint32_t size = 0;
+    uint32_t i = 0;
+    uint32_t k = 0;
+
+    // Pattern hits all 12 bits, both ends of range and nibble boundaries of packing.
+    for(k = 0; k < channels; k++)
+    {
+        for(i = 0; i < count; i++)
+        {
+            test_samples[(k * TEST_STRIDE) + i] = (uint16_t)(((k * 0x3A1) + (i * 0x1F7) + ((i & 1) ? 0xF00 : 0))
+                                                             & 0xFFF);
+        }
+    }
+    test_samples[0] = 0xFFF;
+    memset(test_read, 0xFF, sizeof(test_read));
+
+    size = capture_write_samples(test_stream, sizeof(test_stream), &header, &block, test_samples, TEST_STRIDE);
+    if(size != (CAPTURE_SAMPLES_SIZE(channels * count) - ((flags & CAPTURE_FLAG_TIMESTAMPS) ? 0 : 8)))
+    {
+        return false;
+    }
+    capture_parser_init(&test_parser);
+    for(i = 0; i < size; i++)
+    {
+        type = capture_parse(&test_parser, test_stream[i]);
+    }
+    if(type != CAPTURE_RECORD_SAMPLES || !capture_read_samples(&test_parser, &header, &read, test_read, TEST_STRIDE))
+    {
+        return false;
+    }
+    if(read.sequence != block.sequence || read.count != block.count
+       || read.time != ((flags & CAPTURE_FLAG_TIMESTAMPS) ? block.time : 0)
+       || read.period != ((flags & CAPTURE_FLAG_TIMESTAMPS) ? block.period : 0))
+    {
+        return false;
+    }
+    for(k = 0; k < channels; k++)
+    {
+        if(memcmp(&test_read[k * TEST_STRIDE], &test_samples[k * TEST_STRIDE], count * sizeof(uint16_t)) != 0)
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
@@ -0,0 +1,225 @@
+/**
+ **********************************************************************************************************************
+ * @file        m0_sim_test.c
+ * @author      Diamond Sparrow
+ * @version     1.0.0.0
+ * @date        2026-10-16
+ * @brief       Cortex-M0+ instruction set simulator semantics and timing test C source file.
+ **********************************************************************************************************************
+ * @warning     THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR \n
+ *              IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND\n
+ *              FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR\n
+ *              CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL\n
+ *              DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,\n
+ *              DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN\n
+ *              CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF\n
+ *              THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ **********************************************************************************************************************
+ */
+
+/**********************************************************************************************************************
+ * Includes
+ *********************************************************************************************************************/
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdio.h>
+
+#include "m0_sim.h"
+
+/**********************************************************************************************************************
+ * Private definitions and macros
+ *********************************************************************************************************************/
+#define TEST_LIMIT          100000      //!< Max. cycles of call.
+// Entry points in test program, see test_code.
+#define TEST_SUM            0x00        //!< Sum of 1..r0, loop with taken and not taken branch.
+#define TEST_MIX            0x0C        //!< Shifts, multiply, extends, BL and signed compare.
+#define TEST_MEM            0x3A        //!< Stack, LDM/STM, halfword and byte access, literal pool.
+#define TEST_STRAIGHT       0x5C        //!< Eight single cycle instructions.
+#define TEST_FAULT          0x6E        //!< Load from r0.
+
+/**********************************************************************************************************************
+ * Private constants
+ *********************************************************************************************************************/
+/**
+ * Test program, Thumb code assembled for thumbv6m:
+ *
+ *  sum:      movs r1, #0 / 1: adds r1, r1, r0 / subs r0, #1 / bne 1b / mov r0, r1 / bx lr
+ *  mix:      push {r4, r5, lr} / mov r4, r0 / lsls r2, r0, #3 / lsrs r3, r0, #1 / asrs r5, r1, #2 / eors r2, r3
+ *            adds r2, r2, r5 / muls r2, r1, r2 / rev r3, r2 / uxtb r5, r3 / sxth r3, r3 / subs r2, r2, r3
+ *            adds r2, r2, r5 / bl helper / cmp r0, r1 / bgt 2f / mvns r2, r2 / 2: adds r0, r2, r0 / pop {r4, r5, pc}
+ *  helper:   movs r0, #7 / rors r2, r0 / bx lr
+ *  mem:      sub sp, #16 / mov r2, sp / stmia r2!, {r0, r1} / mov r2, sp / ldmia r2!, {r0, r3} / strh r1, [r2, #0]
+ *            movs r3, #0 / ldrsh r3, [r2, r3] / strb r0, [r2, #2] / ldrb r2, [r2, #2] / str r2, [sp, #12]
+ *            ldr r0, [sp, #12] / adds r0, r0, r3 / ldr r1, =0x12345678 / adds r0, r0, r1 / add sp, #16 / bx lr
+ *  straight: movs r0, #1 / 7 x adds r0, #1 / bx lr
+ *  fault:    ldr r0, [r0, #0] / bx lr
+ */
+static const uint16_t test_code[] =
+{
+    0x2100, 0x1809, 0x3801, 0xD1FC, 0x4608, 0x4770, 0xB530, 0x4604,
+    0x00C2, 0x0843, 0x108D, 0x405A, 0x1952, 0x434A, 0xBA13, 0xB2DD,
+    0xB21B, 0x1AD2, 0x1952, 0xF000, 0xF805, 0x4288, 0xDC00, 0x43D2,
+    0x1810, 0xBD30, 0x2007, 0x41C2, 0x4770, 0xB084, 0x466A, 0xC203,
+    0x466A, 0xCA09, 0x8011, 0x2300, 0x5ED3, 0x7090, 0x7892, 0x9203,
+    0x9803, 0x18C0, 0x4907, 0x1840, 0xB004, 0x4770, 0x2001, 0x3001,
+    0x3001, 0x3001, 0x3001, 0x3001, 0x3001, 0x3001, 0x4770, 0x6800,
+    0x4770, 0x0000, 0x5678, 0x1234,
+};
+
+/**********************************************************************************************************************
+ * Private variables
+ *********************************************************************************************************************/
+/** Failed checks count. */
+static uint32_t test_failed = 0;
+
+/**********************************************************************************************************************
+ * Prototypes of local functions
+ *********************************************************************************************************************/
+static void test_check(bool ok, const char *name, uint32_t value);
+
+/**
+ * @brief   Call test program function on fresh simulator.
+ *
+ * @param   wait_states Flash wait states.
+ * @param   entry       Function address.
+ * @param   a           First argument.
+ * @param   b           Second argument.
+ * @param   cycles      Pointer to cycles of call.
+ * @param   error       Pointer to simulation error. See @ref m0_sim_error_t.
+ *
+ * @return  Function result.
+ */
+static uint32_t test_call(uint32_t wait_states, uint32_t entry, uint32_t a, uint32_t b, uint32_t *cycles,
+                          m0_sim_error_t *error);
+
+/**
+ * @brief   Reference of mix function.
+ */
+static uint32_t test_mix(uint32_t a, uint32_t b);
+
+/**********************************************************************************************************************
+ * Exported functions
+ *********************************************************************************************************************/
+int main(void)
+{
+    static const uint32_t args[][2] =
+    {
+        {0x00000001, 0x00000002},
+        {0x12345678, 0x9ABCDEF0},
+        {0xFFFFFFFF, 0x00000005},
+        {0x80000000, 0x7FFFFFFF},
+        {0x0000BEEF, 0xFFFF8001},
+    };
+    m0_sim_error_t error = M0_SIM_OK;
+    uint32_t cycles = 0;
+    uint32_t cycles_ws = 0;
+    uint32_t value = 0;
+    uint32_t expect = 0;
+    uint32_t i = 0;
+
+    // Loop: 1 + 10 x (1 + 1) + 9 taken x 2 + 1 not taken + 1 + 2 (BX).
+    value = test_call(0, TEST_SUM, 10, 0, &cycles, &error);
+    test_check(value == 55 && error == M0_SIM_OK, "sum result", value);
+    test_check(cycles == 43, "sum cycles", cycles);
+
+    for(i = 0; i < sizeof(args) / sizeof(args[0]); i++)
+    {
+        expect = test_mix(args[i][0], args[i][1]);
+        value = test_call(0, TEST_MIX, args[i][0], args[i][1], &cycles, &error);
+        test_check(value == expect && error == M0_SIM_OK, "mix result", value);
+        expect = (args[i][0] & 0xFF) + (uint32_t)(int32_t)(int16_t)args[i][1] + 0x12345678UL;
+        value = test_call(0, TEST_MEM, args[i][0], args[i][1], &cycles, &error);
+        test_check(value == expect && error == M0_SIM_OK, "mem result", value);
+    }
+
+    // Straight code: 8 + 2 (BX) without wait states. With 2 wait states entry fetch stalls 2 and each of 4 next
+    // words 1, as word of 2 single cycle instructions takes 3 cycles to fetch. With 1 wait state of firmware flash
+    // timing only entry fetch stalls, next words are fetched in 2 cycles while previous one executes.
+    value = test_call(0, TEST_STRAIGHT, 0, 0, &cycles, &error);
+    test_check(value == 8 && cycles == 10, "straight cycles", cycles);
+    value = test_call(M0_SIM_WAIT_STATES, TEST_STRAIGHT, 0, 0, &cycles_ws, &error);
+    test_check(M0_SIM_WAIT_STATES == 1 && value == 8 && cycles_ws == 11, "straight cycles firmware flash", cycles_ws);
+    value = test_call(2, TEST_STRAIGHT, 0, 0, &cycles_ws, &error);
+    test_check(value == 8 && cycles_ws == 16, "straight cycles 2 wait states", cycles_ws);
+
+    // Wait states slow loops and literal loads.
+    test_call(0, TEST_SUM, 100, 0, &cycles, &error);
+    test_call(2, TEST_SUM, 100, 0, &cycles_ws, &error);
+    test_check(cycles_ws > cycles, "sum cycles 2 wait states", cycles_ws);
+    test_call(0, TEST_MEM, 1, 2, &cycles, &error);
+    test_call(2, TEST_MEM, 1, 2, &cycles_ws, &error);
+    test_check(cycles_ws > cycles, "mem cycles 2 wait states", cycles_ws);
+
+    // M0+ faults on unaligned and unmapped access.
+    test_call(0, TEST_FAULT, M0_SIM_RAM_BASE + 2, 0, &cycles, &error);
+    test_check(error == M0_SIM_ERROR_ALIGN, "unaligned load faults", error);
+    test_call(0, TEST_FAULT, 0x30000000UL, 0, &cycles, &error);
+    test_check(error == M0_SIM_ERROR_ACCESS, "unmapped load faults", error);
+    value = test_call(0, TEST_FAULT, 0x40000000UL, 0, &cycles, &error);
+    test_check(value == 0 && error == M0_SIM_OK, "peripheral load reads 0", value);
+
+    printf("%s: %lu failed.\n", (test_failed == 0) ? "PASS" : "FAIL", (unsigned long)test_failed);
+
+    return (test_failed == 0) ? 0 : 1;
+}
+
+/**********************************************************************************************************************
+ * Private functions
+ *********************************************************************************************************************/
+static void test_check(bool ok, const char *name, uint32_t value)
+{
+    printf("%-4s %-30s 0x%08lX\n", ok ? "ok" : "FAIL", name, (unsigned long)value);
+    if(!ok)
+    {
+        test_failed++;
+    }
+
+    return;
+}
+
+static uint32_t test_call(uint32_t wait_states, uint32_t entry, uint32_t a, uint32_t b, uint32_t *cycles,
+                          m0_sim_error_t *error)
+{
+    const m0_sim_config_t config =
+    {
+        .wait_states = wait_states,
+        .mul_cycles = 1,
+    };
+    const uint32_t args[2] = {a, b};
+    m0_sim_t sim;
+    uint32_t result = 0;
+
+    if(!m0_sim_init(&sim, &config) || !m0_sim_load(&sim, M0_SIM_FLASH_BASE, test_code, sizeof(test_code)))
+    {
+        test_check(false, "init", 0);
+        return 0;
+    }
+    m0_sim_call(&sim, entry, args, 2, TEST_LIMIT, &result);
+    *cycles = (uint32_t)sim.cycles;
+    *error = sim.error;
+    m0_sim_free(&sim);
+
+    return result;
+}
+
+static uint32_t test_mix(uint32_t a, uint32_t b)
+{
+    uint32_t r2 = a << 3;
+    uint32_t r3 = a >> 1;
+    uint32_t r5 = (uint32_t)((int32_t)b >> 2);
+
+    r2 ^= r3;
+    r2 += r5;
+    r2 *= b;
+    r3 = (r2 >> 24) | ((r2 >> 8) & 0xFF00) | ((r2 << 8) & 0xFF0000) | (r2 << 24);
+    r5 = r3 & 0xFF;
+    r3 = (uint32_t)(int32_t)(int16_t)r3;
+    r2 = r2 - r3 + r5;
+    r2 = (r2 >> 7) | (r2 << 25);
+    if(!(7 > (int32_t)b))
+    {
+        r2 = ~r2;
+    }
+
+    return r2 + 7;
+}
@@ -0,0 +1,277 @@
+/**
+ **********************************************************************************************************************
+ * @file        sin_detect_crossing_test.c
+ * @author      Diamond Sparrow
+ * @version     1.0.0.0
+ * @date        2026-10-16
+ * @brief       Hardware zero crossing input of sinusoidal signal frequency detection host test C source file.
+ **********************************************************************************************************************
+ * @warning     THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR \n
+ *              IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND\n
+ *              FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR\n
+ *              CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL\n
+ *              DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,\n
+ *              DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN\n
+ *              CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF\n
+ *              THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ **********************************************************************************************************************
+ */
+
+/**********************************************************************************************************************
+ * Includes
+ *********************************************************************************************************************/
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <math.h>
+
+#include "sin_detect.h"
+#include "sin_detect_hal_host.h"
+
+/**********************************************************************************************************************
+ * Private definitions and macros
+ *********************************************************************************************************************/
+// Crossings are timestamped by free-running CT32B1 at core clock, as by comparator capture or ADC threshold interrupt.
+#define TEST_FREQ           200.0       //!< Test signal frequency in Hz, period is whole number of clock ticks.
+#define TEST_CYCLES         40          //!< Test signal periods.
+#define TEST_WRAP           4294967296.0    //!< Timestamp counter period in ticks.
+#define TEST_NO_SKIP        UINT32_MAX  //!< No crossing is missed.
+#define TEST_JITTER         48          //!< Max. timestamp latency of threshold interrupt in ticks (1 us).
+
+/**********************************************************************************************************************
+ * Private variables
+ *********************************************************************************************************************/
+/** Detection context under test. */
+static sin_detect_t test_ctx = {0};
+/** Failed checks count. */
+static uint32_t test_failed = 0;
+
+/**********************************************************************************************************************
+ * Prototypes of local functions
+ *********************************************************************************************************************/
+/**
+ * @brief   Print check result and count failure.
+ *
+ * @param   ok      Check result.
+ * @param   name    Check name.
+ * @param   value   Value printed with result.
+ */
+static void test_check(bool ok, const char *name, double value);
+
+/**
+ * @brief   Initialize detection with timestamp clock.
+ */
+static void test_init(void);
+
+/**
+ * @brief   Feed rectangular signal crossings to detector.
+ *
+ * @param   start       First rising crossing time in clock ticks, may be near timestamp counter wrap.
+ * @param   freq        Signal frequency in Hz.
+ * @param   duty        Part of period signal is above zero level.
+ * @param   cycles      Signal periods.
+ * @param   skip        Index of crossing that is missed, @ref TEST_NO_SKIP - none.
+ * @param   error_max   Pointer to max. absolute frequency error of valid outputs in Hz.
+ *
+ * @return  Last crossing timestamp in clock ticks.
+ */
+static uint32_t test_edges(double start, double freq, double duty, uint32_t cycles, uint32_t skip,
+                           double *error_max);
+
+/**
+ * @brief   Feed crossings of comparator with hysteresis (Schmitt trigger) on sinusoidal signal to detector.
+ *
+ * @param   freq        Signal frequency in Hz.
+ * @param   level       Comparator zero level relative to signal amplitude, signal is centered at 0.
+ * @param   hys         Comparator hysteresis relative to signal amplitude, thresholds are level +- hys.
+ * @param   jitter      Max. timestamp latency in clock ticks, 0 - timestamps latched by capture hardware.
+ * @param   error_max   Pointer to max. absolute frequency error of valid outputs after two groups in Hz.
+ */
+static void test_comparator(double freq, double level, double hys, uint32_t jitter, double *error_max);
+
+/**
+ * @brief   Get detector frequency.
+ *
+ * @return  Frequency in Hz, 0 if not valid.
+ */
+static double test_frequency(void);
+
+/**********************************************************************************************************************
+ * Exported functions
+ *********************************************************************************************************************/
+int main(void)
+{
+    const uint32_t led = sin_detect_config_main.led;
+    const double period = SIN_DETECT_CLOCK / TEST_FREQ;
+    double error = 0;
+    uint32_t last = 0;
+
+    // Whole tick periods, pairs of half periods give exact frequency.
+    test_init();
+    test_edges(1000.0, TEST_FREQ, 0.5, TEST_CYCLES, TEST_NO_SKIP, &error);
+    test_check(test_frequency() == TEST_FREQ && error == 0, "exact periods", test_frequency());
+    test_check(sin_detect_hal_host_led_get(led), "exact periods LED on", test_frequency());
+
+    // Unequal half periods, rising and falling one are paired into full periods.
+    test_init();
+    test_edges(1000.0, TEST_FREQ, 0.2, TEST_CYCLES, TEST_NO_SKIP, &error);
+    test_check(test_frequency() == TEST_FREQ && error == 0, "20% duty cycle", error);
+    test_init();
+    test_edges(1000.0, TEST_FREQ, 0.93, TEST_CYCLES, TEST_NO_SKIP, &error);
+    test_check(test_frequency() == TEST_FREQ && error == 0, "93% duty cycle", error);
+
+    // Timestamps wrap in the middle of signal, differences are right over overflow.
+    test_init();
+    test_edges(TEST_WRAP - ((TEST_CYCLES / 2) * period) - 12345.0, TEST_FREQ, 0.3, TEST_CYCLES, TEST_NO_SKIP, &error);
+    test_check(test_frequency() == TEST_FREQ && error == 0, "counter wrap", error);
+
+    // No crossing for timeout, last crossing is just before wrap, so timeout check is over wrap too.
+    test_init();
+    last = test_edges(TEST_WRAP - (TEST_CYCLES * period) - 1000.0, TEST_FREQ, 0.5, TEST_CYCLES, TEST_NO_SKIP,
+                      &error);
+    sin_detect_process_timeout(&test_ctx, last + test_ctx.timeout - 1);
+    test_check(test_frequency() == TEST_FREQ, "valid before timeout", test_frequency());
+    sin_detect_process_timeout(&test_ctx, last + test_ctx.timeout);
+    test_check(!test_ctx.data.valid && test_frequency() == 0, "lost at timeout", test_ctx.timeout);
+    test_check(!sin_detect_hal_host_led_get(led), "lost LED off", test_ctx.timeout);
+    // Crossing timestamped after time was read is not a timeout.
+    test_init();
+    last = test_edges(1000.0, TEST_FREQ, 0.5, TEST_CYCLES, TEST_NO_SKIP, &error);
+    sin_detect_process_timeout(&test_ctx, last - 10);
+    test_check(test_frequency() == TEST_FREQ, "crossing after timeout read", test_frequency());
+    // Signal comes back after loss, first crossing only starts measurement.
+    sin_detect_process_timeout(&test_ctx, last + test_ctx.timeout);
+    test_edges((double)last + (3.0 * test_ctx.timeout), TEST_FREQ, 0.5, TEST_CYCLES, TEST_NO_SKIP, &error);
+    test_check(test_frequency() == TEST_FREQ && error == 0, "restart after timeout", error);
+
+    // Missed crossing is seen as two crossings in same direction, measurement starts again without wrong output.
+    test_init();
+    test_edges(1000.0, TEST_FREQ, 0.5, TEST_CYCLES, 41, &error);
+    test_check(test_frequency() == TEST_FREQ && error == 0, "missed falling crossing", error);
+    test_check(test_ctx.data.missed == 1, "missed falling crossing count", test_ctx.data.missed);
+    test_init();
+    test_edges(1000.0, TEST_FREQ, 0.2, TEST_CYCLES, 40, &error);
+    test_check(test_frequency() == TEST_FREQ && error == 0, "missed rising crossing 20% duty", error);
+    test_check(test_ctx.data.missed == 1, "missed rising crossing count", test_ctx.data.missed);
+
+    // Comparator output, as from CT32B1 capture or ADC threshold interrupt: off-center zero level gives unequal half
+    // periods, period is not whole number of ticks and interrupt latency adds jitter.
+    test_init();
+    test_comparator(147.3, 0.0, 0.05, 0, &error);
+    test_check(error < 0.001, "comparator 147.3 Hz", error);
+    test_init();
+    test_comparator(147.3, 0.4, 0.1, 0, &error);
+    test_check(error < 0.001, "comparator 147.3 Hz off-center", error);
+    test_init();
+    test_comparator(251.7, -0.3, 0.1, TEST_JITTER, &error);
+    test_check(error < 0.02, "comparator 251.7 Hz latency jitter", error);
+    test_check(test_ctx.data.missed == 0, "comparator no missed crossing", test_ctx.data.missed);
+    // Capture input measures far above ADC Nyquist frequency, resolution is one tick over two periods.
+    test_init();
+    test_comparator(12345.0, 0.1, 0.05, 0, &error);
+    test_check(error < ((12345.0 * 12345.0) / SIN_DETECT_CLOCK), "comparator 12.345 kHz", error);
+
+    printf("%s: %lu failed.\n", (test_failed == 0) ? "PASS" : "FAIL", (unsigned long)test_failed);
+
+    return (test_failed == 0) ? 0 : 1;
+}
+
+/**********************************************************************************************************************
+ * Private functions
+ *********************************************************************************************************************/
+static void test_check(bool ok, const char *name, double value)
+{
+    printf("%-4s %-36s %.4f\n", ok ? "ok" : "FAIL", name, value);
+    if(!ok)
+    {
+        test_failed++;
+    }
+
+    return;
+}
+
+static void test_init(void)
+{
+    sin_detect_config_t config = sin_detect_config_main;
+
+    config.clock = SIN_DETECT_CLOCK;
+    if(!sin_detect_init(&test_ctx, &config))
+    {
+        test_check(false, "init", 0);
+    }
+
+    return;
+}
+
+static uint32_t test_edges(double start, double freq, double duty, uint32_t cycles, uint32_t skip,
+                           double *error_max)
+{
+    const double period = SIN_DETECT_CLOCK / freq;
+    uint32_t time = 0;
+    uint32_t i = 0;
+    double error = 0;
+
+    *error_max = 0;
+    for(i = 0; i < (2 * cycles); i++)
+    {
+        // Even crossings are rising, timer count is modulo 2^32.
+        time = (uint32_t)(uint64_t)llround(start + ((i / 2) * period) + (((i % 2) != 0) ? (duty * period) : 0));
+        if(i == skip)
+        {
+            continue;
+        }
+        sin_detect_process_crossing(&test_ctx, time, (i % 2) == 0);
+        if(test_ctx.data.valid)
+        {
+            error = fabs(test_frequency() - freq);
+            if(error > *error_max)
+            {
+                *error_max = error;
+            }
+        }
+    }
+
+    return time;
+}
+
+static void test_comparator(double freq, double level, double hys, uint32_t jitter, double *error_max)
+{
+    const double period = SIN_DETECT_CLOCK / freq;
+    // Rising crossing of upper threshold and falling crossing of lower one, in parts of period.
+    const double rise = asin(level + hys) / (2.0 * M_PI);
+    const double fall = 0.5 - (asin(level - hys) / (2.0 * M_PI));
+    uint32_t random = 12345;
+    uint32_t delay = 0;
+    uint32_t outputs = 0;
+    uint32_t i = 0;
+    double error = 0;
+
+    *error_max = 0;
+    for(i = 0; i < (2 * TEST_CYCLES); i++)
+    {
+        // Linear congruential generator, same latency sequence every run.
+        random = (random * 1103515245UL) + 12345;
+        delay = (jitter > 0) ? ((random >> 16) % (jitter + 1)) : 0;
+        sin_detect_process_crossing(&test_ctx, (uint32_t)(uint64_t)llround(((((i / 2) + (((i % 2) != 0) ? fall : rise))
+                                                                              * period) + delay)), (i % 2) == 0);
+        if(test_ctx.data.valid && test_ctx.data.cycles == 0 && ++outputs > 2)
+        {
+            error = fabs(test_frequency() - freq);
+            if(error > *error_max)
+            {
+                *error_max = error;
+            }
+        }
+    }
+
+    return;
+}
+
+static double test_frequency(void)
+{
+    uint32_t freq = 0;
+
+    sin_detect_get_frequency(&test_ctx, &freq);
+
+    return (double)freq / SIN_DETECT_FREQ_ONE;
+}
@@ -0,0 +1,206 @@
+/**
+ **********************************************************************************************************************
+ * @file        sin_detect_engine_test.c
+ * @author      Diamond Sparrow
+ * @version     1.0.0.0
+ * @date        2026-10-16
+ * @brief       Detection engine independent host test C source file.
+ **********************************************************************************************************************
+ * @warning     THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR \n
+ *              IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND\n
+ *              FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR\n
+ *              CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL\n
+ *              DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,\n
+ *              DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN\n
+ *              CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF\n
+ *              THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ **********************************************************************************************************************
+ */
+
+/**********************************************************************************************************************
+ * Includes
+ *********************************************************************************************************************/
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <math.h>
+
+#include "sin_detect.h"
+#include "sin_detect_hal_host.h"
+
+/**********************************************************************************************************************
+ * Private definitions and macros
+ *********************************************************************************************************************/
+// Built once per engine (SIN_DETECT_ENGINE), checks hold for every engine, so tolerance is of the coarsest one.
+#define TEST_AMPLITUDE      800.0       //!< Test signal amplitude in ADC counts.
+#define TEST_WEAK           10.0        //!< Amplitude of weak signal in ADC counts, below amplitude_min.
+#define TEST_OFFSET         2048.0      //!< Test signal offset in ADC counts.
+#define TEST_TIME           1.0         //!< Test signal length in seconds.
+#define TEST_SETTLE         0.5         //!< Time after which frequency is checked in seconds.
+#define TEST_TOLERANCE      1.0         //!< Max. frequency error in Hz.
+#define TEST_LOSS           0.3         //!< Max. time from signal end till it is not valid in seconds.
+
+/**********************************************************************************************************************
+ * Private variables
+ *********************************************************************************************************************/
+/** Detection context under test. */
+static sin_detect_t test_ctx = {0};
+/** Detection output at end of last run. */
+static sin_detect_output_t test_output = {0};
+/** Failed checks count. */
+static uint32_t test_failed = 0;
+
+/**********************************************************************************************************************
+ * Prototypes of local functions
+ *********************************************************************************************************************/
+/**
+ * @brief   Check result and print it.
+ *
+ * @param   ok      Flag that shows if check passed.
+ * @param   name    Check name.
+ * @param   value   Measured value.
+ */
+static void test_check(bool ok, const char *name, double value);
+
+/**
+ * @brief   Feed sine wave to detector and average measured frequency after settling.
+ *
+ * @param   rate        Sample rate in Hz.
+ * @param   freq        Signal frequency in Hz.
+ * @param   amplitude   Signal amplitude in ADC counts.
+ *
+ * @return  Mean frequency in Hz, 0 if frequency was never valid after settling.
+ */
+static double test_run(float rate, double freq, double amplitude);
+
+/**
+ * @brief   Feed sine wave that stops and measure how long it stays valid after it.
+ *
+ * @param   freq    Signal frequency in Hz.
+ *
+ * @return  Time from signal end till output is not valid in seconds, -1 if it stays valid.
+ */
+static double test_loss(double freq);
+
+/**********************************************************************************************************************
+ * Exported functions
+ *********************************************************************************************************************/
+int main(void)
+{
+    const uint32_t led = sin_detect_config_main.led;
+    double freq = 0;
+
+    printf("Engine %d.\n", SIN_DETECT_ENGINE);
+
+    // Frequency inside band, LED on.
+    freq = test_run(SIN_DETECT_RATE, 200.0, TEST_AMPLITUDE);
+    test_check(test_output.valid && fabs(freq - 200.0) < TEST_TOLERANCE, "200 Hz in band", freq);
+    test_check(sin_detect_hal_host_led_get(led), "200 Hz LED on", freq);
+
+    // Frequencies outside band, LED off.
+    freq = test_run(SIN_DETECT_RATE, 60.0, TEST_AMPLITUDE);
+    test_check(test_output.valid && fabs(freq - 60.0) < TEST_TOLERANCE, "60 Hz below band", freq);
+    test_check(!sin_detect_hal_host_led_get(led), "60 Hz LED off", freq);
+    freq = test_run(SIN_DETECT_RATE, 350.0, TEST_AMPLITUDE);
+    test_check(test_output.valid && fabs(freq - 350.0) < TEST_TOLERANCE, "350 Hz above band", freq);
+    test_check(!sin_detect_hal_host_led_get(led), "350 Hz LED off", freq);
+
+    // Clean tone below amplitude_min is no signal.
+    freq = test_run(SIN_DETECT_RATE, 200.0, TEST_WEAK);
+    test_check(!test_output.valid && test_output.frequency == 0 && freq == 0, "weak signal is not valid", freq);
+    test_check(!sin_detect_hal_host_led_get(led), "weak signal LED off", freq);
+
+    // Signal ends, frequency is not valid after timeout and amplitude window, engine estimate interval included.
+    freq = test_loss(200.0);
+    test_check(freq >= 0 && freq <= TEST_LOSS && !test_output.valid, "signal end is lost", freq);
+    test_check(!sin_detect_hal_host_led_get(led), "signal end LED off", freq);
+
+    // Rates of adaptive divider and timed sampling are not nominal, every engine works up to rate it is sized for.
+    freq = test_run(7000.0F, 150.0, TEST_AMPLITUDE);
+    test_check(test_output.valid && fabs(freq - 150.0) < TEST_TOLERANCE, "150 Hz at 7 kHz", freq);
+    freq = test_run(SIN_DETECT_RATE_MAX, 150.0, TEST_AMPLITUDE);
+    test_check(test_output.valid && fabs(freq - 150.0) < TEST_TOLERANCE, "150 Hz at max. rate", freq);
+
+    printf("%s: %lu failed.\n", (test_failed == 0) ? "PASS" : "FAIL", (unsigned long)test_failed);
+
+    return (test_failed == 0) ? 0 : 1;
+}
+
+/**********************************************************************************************************************
+ * Private functions
+ *********************************************************************************************************************/
+static void test_check(bool ok, const char *name, double value)
+{
+    printf("%-4s %-30s %.4f\n", ok ? "ok" : "FAIL", name, value);
+    if(!ok)
+    {
+        test_failed++;
+    }
+
+    return;
+}
+
+static double test_run(float rate, double freq, double amplitude)
+{
+    sin_detect_config_t config = sin_detect_config_main;
+    const uint32_t samples = (uint32_t)(rate * TEST_TIME);
+    uint32_t value = 0;
+    uint32_t sum_n = 0;
+    double sum = 0;
+    double t = 0;
+    uint32_t i = 0;
+
+    config.rate = rate;
+    if(!sin_detect_init(&test_ctx, &config))
+    {
+        test_check(false, "init", 0);
+        return 0;
+    }
+    for(i = 0; i < samples; i++)
+    {
+        t = i / (double)rate;
+        sin_detect_process(&test_ctx, (uint32_t)lround(TEST_OFFSET + (amplitude * sin(2.0 * M_PI * freq * t))));
+        if(t >= TEST_SETTLE && sin_detect_get_frequency(&test_ctx, &value))
+        {
+            sum += (double)value / SIN_DETECT_FREQ_ONE;
+            sum_n++;
+        }
+    }
+    sin_detect_get_output(&test_ctx, &test_output);
+
+    return (sum_n > 0) ? (sum / sum_n) : 0;
+}
+
+static double test_loss(double freq)
+{
+    const uint32_t samples = (uint32_t)(SIN_DETECT_RATE * TEST_TIME);
+    const uint32_t end = (uint32_t)(SIN_DETECT_RATE * TEST_SETTLE);
+    double lost = -1;
+    double t = 0;
+    uint32_t i = 0;
+
+    if(!sin_detect_init(&test_ctx, &sin_detect_config_main))
+    {
+        test_check(false, "init", 0);
+        return -1;
+    }
+    for(i = 0; i < samples; i++)
+    {
+        t = i / (double)SIN_DETECT_RATE;
+        sin_detect_process(&test_ctx, (i < end) ? (uint32_t)lround(TEST_OFFSET
+                                                                   + (TEST_AMPLITUDE * sin(2.0 * M_PI * freq * t)))
+                                                : (uint32_t)TEST_OFFSET);
+        sin_detect_get_output(&test_ctx, &test_output);
+        if(i >= end && lost < 0 && !test_output.valid)
+        {
+            lost = t - TEST_SETTLE;
+        }
+        else if(i == (end - 1) && !test_output.valid)
+        {
+            // Signal was never measured, loss can not be timed.
+            return -1;
+        }
+    }
+
+    return lost;
+}
@@ -0,0 +1,377 @@
+/**
+ **********************************************************************************************************************
+ * @file        sin_detect_fixed_test.c
+ * @author      Diamond Sparrow
+ * @version     1.0.0.0
+ * @date        2026-10-16
+ * @brief       Fixed point sinusoidal signal frequency detection against double precision reference host test C
+ *              source file.
+ **********************************************************************************************************************
+ * @warning     THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR \n
+ *              IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND\n
+ *              FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR\n
+ *              CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL\n
+ *              DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,\n
+ *              DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN\n
+ *              CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF\n
+ *              THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ **********************************************************************************************************************
+ */
+
+/**********************************************************************************************************************
+ * Includes
+ *********************************************************************************************************************/
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <math.h>
+
+#include "sin_detect.h"
+#include "sin_detect_hal_host.h"
+#include "waveform.h"
+
+/**********************************************************************************************************************
+ * Private definitions and macros
+ *********************************************************************************************************************/
+// Reference runs the zero crossing path in double: crossing interpolation, period accumulation, reciprocal and low
+// pass filter. Crossing and signal loss decisions are taken from detector, so both measure the same half periods
+// and only arithmetic is compared. Fixed point error is reciprocal and low pass filter rounding down (few LSB of
+// Q16.16) and, of sampled signal, interpolated crossing truncated to timestamp clock tick. One tick over measured
+// cycles is frequency error of 2 * f^2 / (cycles * clock), 0.0026 Hz at 500 Hz.
+#define TEST_TOLERANCE      0.0001      //!< Max. frequency difference from reference in Hz, without interpolation.
+#define TEST_TICKS          1.0         //!< Max. interpolated crossings sum difference from reference in ticks.
+#define TEST_AMPLITUDE      800.0       //!< Sampled signal amplitude in ADC counts.
+#define TEST_OFFSET         2048.0      //!< Sampled signal DC offset in ADC counts.
+#define TEST_TIME           1.0         //!< Sampled signal length in s.
+#define TEST_FREQ_LOW       50.0        //!< First frequency in Hz.
+#define TEST_FREQ_HIGH      500.0       //!< Last frequency of sampled signal in Hz.
+#define TEST_FREQ_STEP      9.7         //!< Frequency step in Hz, not a divider of sample rate.
+#define TEST_CROSSING_HIGH  12000.0     //!< Last frequency of timestamped crossings in Hz.
+#define TEST_CROSSING_CYCLES    200     //!< Signal periods of timestamped crossings.
+#define TEST_JITTER         48          //!< Max. crossing timestamp latency in ticks (1 us).
+
+/**********************************************************************************************************************
+ * Private typedef
+ *********************************************************************************************************************/
+/**
+ * @brief   Double precision reference of zero crossing path.
+ */
+typedef struct
+{
+    bool lost;                  //!< Flag that shows if next crossing only starts measurement.
+    bool valid;                 //!< Flag that shows if output is valid.
+    bool crossed;               //!< Flag that shows if not yet confirmed crossing was seen.
+    uint32_t cycles;            //!< Half periods accumulated.
+    double accumulator;         //!< Half periods sum in ticks.
+    double counter;             //!< Time since last crossing in ticks.
+    double crossing;            //!< Time from last till not yet confirmed crossing in ticks.
+    double output;              //!< Low pass filter output in Hz.
+} test_ref_t;
+
+/**
+ * @brief   Comparison result of one signal.
+ */
+typedef struct
+{
+    uint32_t outputs;           //!< Outputs compared.
+    double error_max;           //!< Max. absolute difference from reference in Hz.
+    uint32_t state_errors;      //!< Band decisions different from reference away from band edges.
+} test_result_t;
+
+/**********************************************************************************************************************
+ * Private variables
+ *********************************************************************************************************************/
+/** Detection context under test. */
+static sin_detect_t test_ctx = {0};
+/** Failed checks count. */
+static uint32_t test_failed = 0;
+
+/**********************************************************************************************************************
+ * Prototypes of local functions
+ *********************************************************************************************************************/
+/**
+ * @brief   Print check result and count failure.
+ *
+ * @param   ok      Check result.
+ * @param   name    Check name.
+ * @param   freq    Signal frequency in Hz.
+ * @param   value   Value printed with result.
+ */
+static void test_check(bool ok, const char *name, double freq, double value);
+
+/**
+ * @brief   Reset reference to signal loss.
+ *
+ * @param   ref     Pointer to reference. See @ref test_ref_t.
+ */
+static void test_ref_reset(test_ref_t *ref);
+
+/**
+ * @brief   Pass half period to reference, update output after configured cycles.
+ *
+ * @param   ref     Pointer to reference. See @ref test_ref_t.
+ * @param   period  Half period in ticks.
+ *
+ * @return  State of output update.
+ * @retval  0   output is not updated.
+ * @retval  1   output is updated.
+ */
+static bool test_ref_half_period(test_ref_t *ref, double period);
+
+/**
+ * @brief   Compare detector output with reference output.
+ *
+ * @param   ref     Pointer to reference. See @ref test_ref_t.
+ * @param   result  Pointer to result. See @ref test_result_t.
+ */
+static void test_compare(const test_ref_t *ref, test_result_t *result);
+
+/**
+ * @brief   Feed sampled sinusoidal signal to detector and reference.
+ *
+ * @param   freq    Signal frequency in Hz.
+ * @param   result  Pointer to result. See @ref test_result_t.
+ */
+static void test_sampled(double freq, test_result_t *result);
+
+/**
+ * @brief   Feed timestamped crossings of sinusoidal signal to detector and reference.
+ *
+ * @param   freq    Signal frequency in Hz.
+ * @param   result  Pointer to result. See @ref test_result_t.
+ */
+static void test_crossings(double freq, test_result_t *result);
+
+/**********************************************************************************************************************
+ * Exported functions
+ *********************************************************************************************************************/
+int main(void)
+{
+    test_result_t result;
+    double error_max = 0;
+    double freq = 0;
+
+    // Sampled signal over detection range.
+    for(freq = TEST_FREQ_LOW; freq <= TEST_FREQ_HIGH; freq += TEST_FREQ_STEP)
+    {
+        test_sampled(freq, &result);
+        test_check(result.outputs > 0, "sampled outputs", freq, result.outputs);
+        test_check(result.error_max <= (TEST_TOLERANCE + ((2.0 * freq * freq * TEST_TICKS)
+                                                          / (sin_detect_config_main.cycles * SIN_DETECT_CLOCK))),
+                   "sampled error", freq, result.error_max);
+        test_check(result.state_errors == 0, "sampled band", freq, result.state_errors);
+        error_max = (result.error_max > error_max) ? result.error_max : error_max;
+    }
+    printf("Sampled 50 - 500 Hz: max. difference from reference %.6f Hz.\n", error_max);
+
+    // Timestamped crossings up to capture range, far above ADC Nyquist frequency.
+    error_max = 0;
+    for(freq = TEST_FREQ_LOW; freq <= TEST_CROSSING_HIGH; freq *= 1.1)
+    {
+        test_crossings(freq, &result);
+        test_check(result.outputs > 0, "crossing outputs", freq, result.outputs);
+        test_check(result.error_max <= TEST_TOLERANCE, "crossing error", freq, result.error_max);
+        test_check(result.state_errors == 0, "crossing band", freq, result.state_errors);
+        error_max = (result.error_max > error_max) ? result.error_max : error_max;
+    }
+    printf("Crossings 50 - 12000 Hz: max. difference from reference %.6f Hz.\n", error_max);
+
+    printf("%s: %lu failed, tolerance %.4f Hz and %.0f tick of interpolation.\n",
+           (test_failed == 0) ? "PASS" : "FAIL", (unsigned long)test_failed, TEST_TOLERANCE, TEST_TICKS);
+
+    return (test_failed == 0) ? 0 : 1;
+}
+
+/**********************************************************************************************************************
+ * Private functions
+ *********************************************************************************************************************/
+static void test_check(bool ok, const char *name, double freq, double value)
+{
+    if(!ok)
+    {
+        test_failed++;
+        printf("FAIL %-20s %9.2f Hz: %.6f\n", name, freq, value);
+    }
+
+    return;
+}
+
+static void test_ref_reset(test_ref_t *ref)
+{
+    ref->lost = true;
+    ref->valid = false;
+    ref->crossed = false;
+    ref->cycles = 0;
+    ref->accumulator = 0;
+    ref->counter = 0;
+    ref->crossing = 0;
+    ref->output = 0;
+
+    return;
+}
+
+static bool test_ref_half_period(test_ref_t *ref, double period)
+{
+    const sin_detect_config_t *config = &test_ctx.config;
+    double unit = (config->clock > 0) ? config->clock : config->rate;
+    double freq = 0;
+
+    if(ref->lost)
+    {
+        ref->lost = false;
+        return false;
+    }
+    ref->cycles++;
+    ref->accumulator += period;
+    if(ref->cycles < config->cycles)
+    {
+        return false;
+    }
+    // Cycles are half periods.
+    freq = (unit * config->cycles) / (2.0 * ref->accumulator);
+    ref->output = ref->valid ? (ref->output + ((freq - ref->output) * config->lp_cut_off / FILTERS_CUT_OFF_ONE))
+                             : freq;
+    ref->valid = true;
+    ref->cycles = 0;
+    ref->accumulator = 0;
+
+    return true;
+}
+
+static void test_compare(const test_ref_t *ref, test_result_t *result)
+{
+    const sin_detect_config_t *config = &test_ctx.config;
+    double low = (double)config->freq_low / SIN_DETECT_FREQ_ONE;
+    double high = (double)config->freq_high / SIN_DETECT_FREQ_ONE;
+    double hys = (double)config->freq_hys / SIN_DETECT_FREQ_ONE;
+    double error = 0;
+    bool state = false;
+
+    error = fabs(((double)test_ctx.data.frequncy / SIN_DETECT_FREQ_ONE) - ref->output);
+    result->error_max = (error > result->error_max) ? error : result->error_max;
+    result->outputs++;
+    // Band decision of reference output, it may differ only within tolerance of thresholds.
+    state = test_ctx.data.state ? (ref->output >= (low - hys) && ref->output <= (high + hys))
+                                : (ref->output >= (low + hys) && ref->output <= (high - hys));
+    if(state != test_ctx.data.state && fabs(ref->output - (low - hys)) > TEST_TOLERANCE
+       && fabs(ref->output - (low + hys)) > TEST_TOLERANCE && fabs(ref->output - (high - hys)) > TEST_TOLERANCE
+       && fabs(ref->output - (high + hys)) > TEST_TOLERANCE)
+    {
+        result->state_errors++;
+    }
+
+    return;
+}
+
+static void test_sampled(double freq, test_result_t *result)
+{
+    waveform_config_t config = {.rate = SIN_DETECT_RATE, .freq = freq, .amplitude = TEST_AMPLITUDE,
+                                .offset = TEST_OFFSET};
+    waveform_t wave;
+    test_ref_t ref;
+    uint32_t samples = (uint32_t)(TEST_TIME * config.rate);
+    uint32_t signal = 0;
+    uint32_t last = 0;
+    uint32_t zero = 0;
+    double step = 0;
+    double change = 0;
+    double over = 0;
+    double interpolated = 0;
+    bool positive = false;
+    bool lost = false;
+    bool updated = false;
+    uint32_t i = 0;
+
+    result->outputs = 0;
+    result->error_max = 0;
+    result->state_errors = 0;
+    if(!waveform_init(&wave, &config) || !sin_detect_init(&test_ctx, &sin_detect_config_main))
+    {
+        test_check(false, "init", freq, 0);
+        return;
+    }
+    test_ref_reset(&ref);
+    step = test_ctx.data.step;
+
+    for(i = 0; i < samples; i++)
+    {
+        signal = waveform_next(&wave);
+        // Detector state before sample decides crossing, same as in detector.
+        last = test_ctx.data.last_signal;
+        zero = test_ctx.data.zero;
+        positive = test_ctx.data.positive;
+        lost = test_ctx.data.lost;
+        change = fabs((double)signal - (double)last);
+        over = fabs((double)signal - (double)zero);
+        interpolated = (over >= change) ? step : ((over * step) / change);
+        ref.counter += step;
+        if(positive ? (signal < zero && last >= zero) : (signal >= zero && last < zero))
+        {
+            ref.crossing = ref.counter - interpolated;
+            ref.crossed = true;
+        }
+
+        sin_detect_process(&test_ctx, signal);
+
+        // Polarity flag flips when detector confirms crossing.
+        updated = false;
+        if(test_ctx.data.positive != positive)
+        {
+            if(!ref.crossed)
+            {
+                ref.crossing = ref.counter - interpolated;
+            }
+            updated = test_ref_half_period(&ref, ref.crossing);
+            ref.counter -= ref.crossing;
+            ref.crossing = 0;
+            ref.crossed = false;
+        }
+        if(test_ctx.data.lost && !lost)
+        {
+            // Detector dropped signal, timeout or amplitude, output after it is not compared.
+            test_ref_reset(&ref);
+        }
+        else if(updated)
+        {
+            test_compare(&ref, result);
+        }
+    }
+
+    return;
+}
+
+static void test_crossings(double freq, test_result_t *result)
+{
+    const double clock = SIN_DETECT_CLOCK;
+    test_ref_t ref;
+    uint32_t random = 12345;
+    uint32_t time = 0;
+    uint32_t last = 0;
+    uint32_t i = 0;
+
+    result->outputs = 0;
+    result->error_max = 0;
+    result->state_errors = 0;
+    if(!sin_detect_init(&test_ctx, &sin_detect_config_main))
+    {
+        test_check(false, "init", freq, 0);
+        return;
+    }
+    test_ref_reset(&ref);
+
+    for(i = 0; i < (2 * TEST_CROSSING_CYCLES); i++)
+    {
+        // Crossing instant in ticks with interrupt latency, counter wraps over during run.
+        random = (random * 1103515245UL) + 12345UL;
+        time = (uint32_t)(uint64_t)(((i * clock) / (2.0 * freq)) + 4294000000.0) + ((random >> 16) % TEST_JITTER);
+        sin_detect_process_crossing(&test_ctx, time, (i % 2) == 0);
+        // First crossing only starts measurement in both.
+        if(test_ref_half_period(&ref, (double)(uint32_t)(time - last)))
+        {
+            test_compare(&ref, result);
+        }
+        last = time;
+    }
+
+    return;
+}
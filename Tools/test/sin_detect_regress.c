@@ -0,0 +1,478 @@
+/**
+ **********************************************************************************************************************
+ * @file        sin_detect_regress.c
+ * @author      Diamond Sparrow
+ * @version     1.0.0.0
+ * @date        2026-10-16
+ * @brief       Sinusoidal signal frequency detection accuracy regression suite C source file.
+ **********************************************************************************************************************
+ * @warning     THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR \n
+ *              IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND\n
+ *              FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR\n
+ *              CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL\n
+ *              DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,\n
+ *              DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN\n
+ *              CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF\n
+ *              THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ **********************************************************************************************************************
+ */
+
+
+/**********************************************************************************************************************
+ * Includes
+ *********************************************************************************************************************/
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <math.h>
+
+#include "sin_detect.h"
+#include "sin_detect_hal_host.h"
+#include "waveform.h"
+
+/**********************************************************************************************************************
+ * Private definitions and macros
+ *********************************************************************************************************************/
+// Tolerances are of zero crossing engine, other engines trade accuracy for noise immunity.
+#define REGRESS_AMPLITUDE   800.0       //!< Signal amplitude in ADC counts.
+#define REGRESS_TIME        1.0         //!< Grid point signal length in s.
+#define REGRESS_SETTLE      0.5         //!< Time after which frequency is checked in s.
+#define REGRESS_FREQ_LOW    50.0        //!< Grid first frequency in Hz.
+#define REGRESS_FREQ_HIGH   500.0       //!< Grid last frequency in Hz.
+#define REGRESS_FREQ_STEP   10.0        //!< Grid frequency step in Hz.
+#define REGRESS_SWEEP_RATE  40.0        //!< Band edge sweep rate in Hz/s.
+#define REGRESS_LAG         1.0         //!< Band edge sweep allowed frequency lag in Hz, measurement lags signal.
+#define REGRESS_TIMEOUT     0.05        //!< Signal loss detection limit in s, timeout is 4 periods of 100 Hz.
+#define REGRESS_SMALL       200.0       //!< Amplitude sweep small amplitude limit, quantization adds error below it.
+#define REGRESS_SMALL_SCALE 1.5         //!< Amplitude sweep max. error tolerance of small amplitude, times grid one.
+
+/**********************************************************************************************************************
+ * Private typedef
+ *********************************************************************************************************************/
+/**
+ * @brief   Noise level of grid.
+ */
+typedef struct
+{
+    double snr;                 //!< Signal to noise ratio in dB, 0 - no noise.
+    double error_mean;          //!< Max. mean frequency error in Hz.
+    double error_max;           //!< Max. frequency error in Hz.
+} regress_noise_t;
+
+/**
+ * @brief   Result of one run.
+ */
+typedef struct
+{
+    double error_mean;          //!< Mean frequency error after settling in Hz.
+    double error_max;           //!< Max. frequency error after settling in Hz.
+    uint32_t invalid;           //!< Samples after settling without valid frequency.
+    bool led;                   //!< LED state at end.
+    uint32_t led_changes;       //!< LED state changes after settling.
+    double freq_on;             //!< Generator frequency at last LED turn on, in Hz.
+    double freq_off;            //!< Generator frequency at last LED turn off, in Hz.
+} regress_result_t;
+
+/**********************************************************************************************************************
+ * Private constants
+ *********************************************************************************************************************/
+/** Noise levels of grid, tolerance grows with noise. */
+static const regress_noise_t regress_noise[] =
+{
+    {.snr = 0,  .error_mean = 0.02,  .error_max = 1.0},
+    {.snr = 40, .error_mean = 0.05,  .error_max = 1.5},
+    {.snr = 30, .error_mean = 0.15,  .error_max = 4.0},
+    {.snr = 20, .error_mean = 0.5,   .error_max = 12.0},
+};
+
+/** DC offsets of grid in ADC counts, signal stays inside ADC range. */
+static const double regress_offset[] = {1024.0, 2048.0, 3072.0};
+
+/** Amplitudes of sweep in ADC counts, from just above detection limit over full scale, last one is clipped. */
+static const double regress_amplitude[] = {30.0, 50.0, 100.0, 200.0, 400.0, 800.0, 1600.0, 2000.0, 2047.0, 2400.0};
+
+/**********************************************************************************************************************
+ * Private variables
+ *********************************************************************************************************************/
+/** Detection context under test. */
+static sin_detect_t regress_ctx = {0};
+/** Checks count. */
+static uint32_t regress_checks = 0;
+/** Failed checks count. */
+static uint32_t regress_failed = 0;
+
+/**********************************************************************************************************************
+ * Prototypes of local functions
+ *********************************************************************************************************************/
+/**
+ * @brief   Count check, print it if failed.
+ *
+ * @param   ok      Flag that shows if check passed.
+ * @param   name    Check name.
+ * @param   config  Pointer to waveform of check. See @ref waveform_config_t.
+ * @param   value   Value to print.
+ */
+static void regress_check(bool ok, const char *name, const waveform_config_t *config, double value);
+
+/**
+ * @brief   Feed waveform to detector.
+ *
+ * @param   config  Pointer to waveform configuration. See @ref waveform_config_t.
+ * @param   time    Signal length in s.
+ * @param   settle  Time after which result is collected in s.
+ * @param   result  Pointer to result. See @ref regress_result_t.
+ */
+static void regress_run(const waveform_config_t *config, double time, double settle, regress_result_t *result);
+
+/**
+ * @brief   Get expected LED state of steady frequency, away from band edges.
+ *
+ * @param   freq    Frequency in Hz.
+ * @param   state   Pointer to expected state.
+ *
+ * @return  State of expectation.
+ * @retval  0   frequency is inside hysteresis of band edge, state depends on history.
+ * @retval  1   state is expected.
+ */
+static bool regress_band(double freq, bool *state);
+
+/**
+ * @brief   Frequency grid over noise levels and offsets.
+ */
+static void regress_grid(void);
+
+/**
+ * @brief   Amplitude sweep from detection limit to full scale, clean and with noise of 40 dB SNR.
+ */
+static void regress_amplitudes(void);
+
+/**
+ * @brief   Band edges are crossed by slow sweeps both ways, LED must switch once at hysteresis levels.
+ */
+static void regress_hysteresis(void);
+
+/**
+ * @brief   Distorted signals: harmonics, coarse quantization, small amplitude.
+ */
+static void regress_distortion(void);
+
+/**
+ * @brief   Frequency steps and signal dropout.
+ */
+static void regress_dynamics(void);
+
+/**********************************************************************************************************************
+ * Exported functions
+ *********************************************************************************************************************/
+int main(void)
+{
+    regress_grid();
+    regress_amplitudes();
+    regress_hysteresis();
+    regress_distortion();
+    regress_dynamics();
+
+    printf("%s: %lu of %lu checks failed.\n", (regress_failed == 0) ? "PASS" : "FAIL",
+           (unsigned long)regress_failed, (unsigned long)regress_checks);
+
+    return (regress_failed == 0) ? 0 : 1;
+}
+
+/**********************************************************************************************************************
+ * Private functions
+ *********************************************************************************************************************/
+static void regress_check(bool ok, const char *name, const waveform_config_t *config, double value)
+{
+    regress_checks++;
+    if(!ok)
+    {
+        regress_failed++;
+        printf("FAIL %-24s f %.1f Hz, amplitude %.0f, offset %.0f, noise %.2f: %.4f\n", name, config->freq,
+               config->amplitude, config->offset, config->noise, value);
+    }
+
+    return;
+}
+
+static void regress_run(const waveform_config_t *config, double time, double settle, regress_result_t *result)
+{
+    const uint32_t led = sin_detect_config_main.led;
+    waveform_t wave;
+    uint32_t samples = (uint32_t)(time * config->rate);
+    uint32_t freq = 0;
+    uint32_t count = 0;
+    double sum = 0;
+    double error = 0;
+    bool state = false;
+    uint32_t i = 0;
+
+    result->error_mean = 0;
+    result->error_max = 0;
+    result->invalid = 0;
+    result->led_changes = 0;
+    result->freq_on = 0;
+    result->freq_off = 0;
+    if(!waveform_init(&wave, config) || !sin_detect_init(&regress_ctx, &sin_detect_config_main))
+    {
+        regress_check(false, "init", config, 0);
+        return;
+    }
+
+    for(i = 0; i < samples; i++)
+    {
+        sin_detect_process(&regress_ctx, waveform_next(&wave));
+        if(sin_detect_hal_host_led_get(led) != state)
+        {
+            state = !state;
+            if(state)
+            {
+                result->freq_on = waveform_frequency(&wave);
+            }
+            else
+            {
+                result->freq_off = waveform_frequency(&wave);
+            }
+            if(waveform_time(&wave) >= settle)
+            {
+                result->led_changes++;
+            }
+        }
+        if(waveform_time(&wave) < settle)
+        {
+            continue;
+        }
+        if(sin_detect_get_frequency(&regress_ctx, &freq))
+        {
+            error = ((double)freq / SIN_DETECT_FREQ_ONE) - waveform_frequency(&wave);
+            sum += error;
+            count++;
+            if(fabs(error) > result->error_max)
+            {
+                result->error_max = fabs(error);
+            }
+        }
+        else
+        {
+            result->invalid++;
+        }
+    }
+    result->error_mean = (count > 0) ? (sum / count) : 0;
+    result->led = state;
+
+    return;
+}
+
+static bool regress_band(double freq, bool *state)
+{
+    const sin_detect_config_t *config = &sin_detect_config_main;
+    double low = (double)config->freq_low / SIN_DETECT_FREQ_ONE;
+    double high = (double)config->freq_high / SIN_DETECT_FREQ_ONE;
+    double hys = (double)config->freq_hys / SIN_DETECT_FREQ_ONE;
+
+    if(fabs(freq - low) <= hys || fabs(freq - high) <= hys)
+    {
+        return false;
+    }
+    *state = (freq > low && freq < high);
+
+    return true;
+}
+
+static void regress_grid(void)
+{
+    waveform_config_t config = {.rate = SIN_DETECT_RATE, .amplitude = REGRESS_AMPLITUDE};
+    regress_result_t result;
+    bool state = false;
+    uint32_t n = 0;
+    uint32_t o = 0;
+    double freq = 0;
+
+    for(n = 0; n < (sizeof(regress_noise) / sizeof(regress_noise[0])); n++)
+    {
+        for(o = 0; o < (sizeof(regress_offset) / sizeof(regress_offset[0])); o++)
+        {
+            for(freq = REGRESS_FREQ_LOW; freq <= REGRESS_FREQ_HIGH; freq += REGRESS_FREQ_STEP)
+            {
+                config.freq = freq;
+                config.offset = regress_offset[o];
+                config.noise = (regress_noise[n].snr > 0) ? waveform_noise_from_snr(REGRESS_AMPLITUDE,
+                                                                                   regress_noise[n].snr) : 0;
+                config.seed = (uint32_t)freq + (o << 16) + (n << 24);
+                regress_run(&config, REGRESS_TIME, REGRESS_SETTLE, &result);
+                regress_check(result.invalid == 0, "grid valid", &config, result.invalid);
+                regress_check(fabs(result.error_mean) <= regress_noise[n].error_mean, "grid mean error", &config,
+                              result.error_mean);
+                regress_check(result.error_max <= regress_noise[n].error_max, "grid max error", &config,
+                              result.error_max);
+                if(regress_band(freq, &state))
+                {
+                    regress_check(result.led == state, "grid band", &config, result.led);
+                    regress_check(result.led_changes == 0, "grid band steady", &config, result.led_changes);
+                }
+            }
+        }
+    }
+
+    return;
+}
+
+static void regress_amplitudes(void)
+{
+    waveform_config_t config = {.rate = SIN_DETECT_RATE, .offset = 2048.0};
+    regress_result_t result;
+    uint32_t a = 0;
+    uint32_t n = 0;
+    double freq = 0;
+
+    // Noise levels of grid: clean and 40 dB SNR, same tolerances.
+    for(a = 0; a < (sizeof(regress_amplitude) / sizeof(regress_amplitude[0])); a++)
+    {
+        for(n = 0; n < 2; n++)
+        {
+            for(freq = REGRESS_FREQ_LOW; freq <= REGRESS_FREQ_HIGH; freq += 50.0)
+            {
+                // Noise of SNR scales with amplitude, so small amplitude has noise of few counts only.
+                config.freq = freq;
+                config.amplitude = regress_amplitude[a];
+                config.noise = (regress_noise[n].snr > 0) ? waveform_noise_from_snr(regress_amplitude[a],
+                                                                                   regress_noise[n].snr) : 0;
+                config.seed = (uint32_t)freq + (a << 16) + (n << 24);
+                regress_run(&config, REGRESS_TIME, REGRESS_SETTLE, &result);
+                regress_check(result.invalid == 0, "amplitude valid", &config, result.invalid);
+                regress_check(fabs(result.error_mean) <= regress_noise[n].error_mean, "amplitude mean error",
+                              &config, result.error_mean);
+                regress_check(result.error_max <= (regress_noise[n].error_max
+                                                   * ((config.amplitude < REGRESS_SMALL) ? REGRESS_SMALL_SCALE : 1.0)),
+                              "amplitude max error", &config, result.error_max);
+            }
+        }
+    }
+
+    return;
+}
+
+static void regress_hysteresis(void)
+{
+    const sin_detect_config_t *detect = &sin_detect_config_main;
+    double low = (double)detect->freq_low / SIN_DETECT_FREQ_ONE;
+    double high = (double)detect->freq_high / SIN_DETECT_FREQ_ONE;
+    double hys = (double)detect->freq_hys / SIN_DETECT_FREQ_ONE;
+    waveform_config_t config = {.rate = SIN_DETECT_RATE, .amplitude = REGRESS_AMPLITUDE, .offset = 2048.0};
+    regress_result_t result;
+    double time = 0;
+    uint32_t n = 0;
+
+    for(n = 0; n < 2; n++)
+    {
+        config.noise = (n == 0) ? 0 : waveform_noise_from_snr(REGRESS_AMPLITUDE, 40.0);
+        config.sweep_start = REGRESS_SETTLE;
+        config.sweep_time = ((high - low) + (8 * hys)) / REGRESS_SWEEP_RATE;
+        time = config.sweep_start + config.sweep_time + REGRESS_SETTLE;
+
+        // Up over the band: turns on above low edge plus hysteresis, off above high edge plus hysteresis.
+        config.freq = low - (4 * hys);
+        config.freq_end = high + (4 * hys);
+        regress_run(&config, time, 0, &result);
+        regress_check(result.led_changes == 2, "sweep up switches once", &config, result.led_changes);
+        regress_check(result.freq_on >= (low + hys) && result.freq_on <= (low + hys + REGRESS_LAG),
+                      "sweep up on", &config, result.freq_on);
+        regress_check(result.freq_off >= (high + hys) && result.freq_off <= (high + hys + REGRESS_LAG),
+                      "sweep up off", &config, result.freq_off);
+
+        // Down over the band: turns on below high edge minus hysteresis, off below low edge minus hysteresis.
+        config.freq = high + (4 * hys);
+        config.freq_end = low - (4 * hys);
+        regress_run(&config, time, 0, &result);
+        regress_check(result.led_changes == 2, "sweep down switches once", &config, result.led_changes);
+        regress_check(result.freq_on <= (high - hys) && result.freq_on >= (high - hys - REGRESS_LAG),
+                      "sweep down on", &config, result.freq_on);
+        regress_check(result.freq_off <= (low - hys) && result.freq_off >= (low - hys - REGRESS_LAG),
+                      "sweep down off", &config, result.freq_off);
+    }
+
+    return;
+}
+
+static void regress_distortion(void)
+{
+    waveform_config_t config = {.rate = SIN_DETECT_RATE, .amplitude = REGRESS_AMPLITUDE, .offset = 2048.0};
+    regress_result_t result;
+    double freq = 0;
+
+    for(freq = REGRESS_FREQ_LOW; freq <= REGRESS_FREQ_HIGH; freq += 50.0)
+    {
+        // Harmonics shift zero crossings equally every period, so period is still exact.
+        config.freq = freq;
+        config.harmonic[0] = 0.1;
+        config.harmonic[1] = 0.2;
+        config.harmonic[3] = 0.05;
+        regress_run(&config, REGRESS_TIME, REGRESS_SETTLE, &result);
+        regress_check(result.invalid == 0, "harmonics valid", &config, result.invalid);
+        regress_check(result.error_max <= 1.0, "harmonics max error", &config, result.error_max);
+        config.harmonic[0] = 0;
+        config.harmonic[1] = 0;
+        config.harmonic[3] = 0;
+
+        // Coarse quantization, interpolation error is larger but averages out.
+        config.bits = 8;
+        regress_run(&config, REGRESS_TIME, REGRESS_SETTLE, &result);
+        regress_check(result.invalid == 0, "8 bits valid", &config, result.invalid);
+        regress_check(fabs(result.error_mean) <= 0.1, "8 bits mean error", &config, result.error_mean);
+        regress_check(result.error_max <= 2.0, "8 bits max error", &config, result.error_max);
+        config.bits = 0;
+
+        // Amplitude just above detection limit.
+        config.amplitude = 50.0;
+        regress_run(&config, REGRESS_TIME, REGRESS_SETTLE, &result);
+        regress_check(result.invalid == 0, "small amplitude valid", &config, result.invalid);
+        regress_check(result.error_max <= 1.5, "small amplitude max error", &config, result.error_max);
+        config.amplitude = REGRESS_AMPLITUDE;
+    }
+
+    // Amplitude below detection limit is no signal.
+    config.freq = 200.0;
+    config.amplitude = 15.0;
+    regress_run(&config, REGRESS_TIME, REGRESS_SETTLE, &result);
+    regress_check(result.invalid == (uint32_t)((REGRESS_TIME - REGRESS_SETTLE) * config.rate), "weak signal lost",
+                  &config, result.invalid);
+    regress_check(!result.led, "weak signal LED off", &config, result.led);
+
+    return;
+}
+
+static void regress_dynamics(void)
+{
+    waveform_config_t config = {.rate = SIN_DETECT_RATE, .amplitude = REGRESS_AMPLITUDE, .offset = 2048.0};
+    regress_result_t result;
+
+    // Step into band and out of it, frequency settles within settle time.
+    config.freq = 400.0;
+    config.freq_end = 200.0;
+    config.sweep_start = 0.5;
+    regress_run(&config, 1.5, 1.0, &result);
+    regress_check(result.invalid == 0, "step in valid", &config, result.invalid);
+    regress_check(result.error_max <= 0.7, "step in max error", &config, result.error_max);
+    regress_check(result.led && result.led_changes == 0, "step in LED on", &config, result.led);
+    config.freq = 200.0;
+    config.freq_end = 50.0;
+    regress_run(&config, 1.5, 1.0, &result);
+    regress_check(result.error_max <= 0.7, "step out max error", &config, result.error_max);
+    regress_check(!result.led && result.led_changes == 0, "step out LED off", &config, result.led);
+    config.freq_end = 0;
+    config.sweep_start = 0;
+
+    // Dropout: signal is lost within timeout, LED turns off, both come back after it.
+    config.freq = 200.0;
+    config.dropout_start = 0.5;
+    config.dropout_time = 0.2;
+    regress_run(&config, 0.7, 0.5, &result);
+    regress_check(result.invalid >= (uint32_t)((config.dropout_time - REGRESS_TIMEOUT) * config.rate)
+                  && result.invalid <= (uint32_t)(config.dropout_time * config.rate), "dropout lost", &config,
+                  result.invalid);
+    regress_check(!result.led, "dropout LED off", &config, result.led);
+    regress_run(&config, 1.2, 1.0, &result);
+    regress_check(result.invalid == 0, "dropout recovered", &config, result.invalid);
+    regress_check(result.led, "dropout LED on", &config, result.led);
+
+    return;
+}
@@ -0,0 +1,240 @@
+/**
+ **********************************************************************************************************************
+ * @file        sin_detect_test.c
+ * @author      Diamond Sparrow
+ * @version     1.0.0.0
+ * @date        2026-10-16
+ * @brief       Sinusoidal signal frequency detection host test C source file.
+ **********************************************************************************************************************
+ * @warning     THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR \n
+ *              IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND\n
+ *              FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR\n
+ *              CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL\n
+ *              DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,\n
+ *              DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN\n
+ *              CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF\n
+ *              THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ **********************************************************************************************************************
+ */
+
+/**********************************************************************************************************************
+ * Includes
+ *********************************************************************************************************************/
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <math.h>
+
+#include "sin_detect.h"
+#include "sin_detect_hal_host.h"
+
+/**********************************************************************************************************************
+ * Private definitions and macros
+ *********************************************************************************************************************/
+// Tolerances are of zero crossing engine, other engines trade accuracy for noise immunity.
+#define TEST_AMPLITUDE      800.0       //!< Test signal amplitude in ADC counts.
+#define TEST_OFFSET         2048.0      //!< Test signal offset in ADC counts.
+#define TEST_TIME           1.0         //!< Test signal length in seconds.
+#define TEST_SETTLE         0.5         //!< Time after which frequency is checked in seconds.
+#define TEST_NOISE_SHIFT    6           //!< Noise estimate averaging, SIN_DETECT_NOISE_SHIFT of sin_detect.c.
+#define TEST_NOISE_MAX      3.0         //!< Max. noise estimate of clean signal in ADC counts, ADC rounding only.
+#define TEST_CHANNELS       3           //!< Channels scanned together, as sequencer A channels of adc.c.
+#define TEST_BLOCK          64          //!< Samples per channel in block, ADC_DMA_BLOCK of adc.h.
+
+/**********************************************************************************************************************
+ * Private variables
+ *********************************************************************************************************************/
+/** Detection context under test. */
+static sin_detect_t test_ctx = {0};
+/** Failed checks count. */
+static uint32_t test_failed = 0;
+/** Detection contexts of scanned channels. */
+static sin_detect_t test_channels_ctx[TEST_CHANNELS];
+/** Detection context fed with one channel alone. */
+static sin_detect_t test_alone_ctx;
+
+/**********************************************************************************************************************
+ * Prototypes of local functions
+ *********************************************************************************************************************/
+static void test_check(bool ok, const char *name, double value);
+static double test_run(float rate, double rate_real, double freq, double amplitude, bool timed);
+static void test_channels(void);
+
+/**********************************************************************************************************************
+ * Exported functions
+ *********************************************************************************************************************/
+int main(void)
+{
+    const uint32_t led = sin_detect_config_main.led;
+    sin_detect_output_t output = {0};
+    uint32_t locks = 0;
+    double freq = 0;
+
+    // Frequency inside band, LED on.
+    freq = test_run(SIN_DETECT_RATE, SIN_DETECT_RATE, 200.0, TEST_AMPLITUDE, false);
+    test_check(fabs(freq - 200.0) < 0.05, "200 Hz in band", freq);
+    test_check(sin_detect_hal_host_led_get(led), "200 Hz LED on", freq);
+
+    // Output is one snapshot of detection data, taken in critical section that is left.
+    locks = sin_detect_hal_host_locks();
+    sin_detect_get_output(&test_ctx, &output);
+    test_check((sin_detect_hal_host_locks() == (locks + 1)) && (sin_detect_hal_host_lock_depth() == 0),
+               "output snapshot locked", sin_detect_hal_host_locks() - locks);
+    test_check(output.valid && output.state && (output.frequency == test_ctx.data.frequncy)
+               && (output.divider == sin_detect_get_divider(&test_ctx)), "output snapshot fields",
+               (double)output.frequency / SIN_DETECT_FREQ_ONE);
+
+    // Noise estimate rejects sinusoid, second difference of it alone would be ~0.09 of amplitude at 300 Hz.
+    freq = test_run(SIN_DETECT_RATE, SIN_DETECT_RATE, 300.0, TEST_AMPLITUDE, false);
+    test_check((test_ctx.data.noise >> TEST_NOISE_SHIFT) <= TEST_NOISE_MAX, "300 Hz clean noise estimate",
+               (double)test_ctx.data.noise / (1UL << TEST_NOISE_SHIFT));
+
+    // Frequencies outside band, LED off.
+    freq = test_run(SIN_DETECT_RATE, SIN_DETECT_RATE, 60.0, TEST_AMPLITUDE, false);
+    test_check(fabs(freq - 60.0) < 0.05, "60 Hz below band", freq);
+    test_check(!sin_detect_hal_host_led_get(led), "60 Hz LED off", freq);
+    freq = test_run(SIN_DETECT_RATE, SIN_DETECT_RATE, 350.0, TEST_AMPLITUDE, false);
+    test_check(fabs(freq - 350.0) < 0.2, "350 Hz above band", freq);
+    test_check(!sin_detect_hal_host_led_get(led), "350 Hz LED off", freq);
+
+    // Signal too weak is no signal.
+    freq = test_run(SIN_DETECT_RATE, SIN_DETECT_RATE, 200.0, 10.0, false);
+    test_check(freq == 0, "weak signal is lost", freq);
+    test_check(!sin_detect_hal_host_led_get(led), "weak signal LED off", freq);
+
+    // Real rate differs from configured one, timestamps keep frequency exact.
+    freq = test_run(7000.0F, 48000000.0 / (2 * 428 * 8), 150.0, TEST_AMPLITUDE, true);
+    test_check(fabs(freq - 150.0) < 0.02, "150 Hz timed at 7009.35 Hz", freq);
+
+    test_channels();
+
+    printf("%s: %lu failed.\n", (test_failed == 0) ? "PASS" : "FAIL", (unsigned long)test_failed);
+
+    return (test_failed == 0) ? 0 : 1;
+}
+
+/**********************************************************************************************************************
+ * Private functions
+ *********************************************************************************************************************/
+static void test_check(bool ok, const char *name, double value)
+{
+    printf("%-4s %-30s %.4f\n", ok ? "ok" : "FAIL", name, value);
+    if(!ok)
+    {
+        test_failed++;
+    }
+
+    return;
+}
+
+/**
+ * @brief   Feed sine wave to detector and average measured frequency after settling.
+ *
+ * @param   rate        Configured sample rate in Hz.
+ * @param   rate_real   Sample rate signal is generated at in Hz.
+ * @param   freq        Signal frequency in Hz.
+ * @param   amplitude   Signal amplitude in ADC counts.
+ * @param   timed       Flag that shows if samples are timestamped at @ref SIN_DETECT_CLOCK.
+ *
+ * @return  Mean frequency in Hz, 0 if frequency was not valid at end.
+ */
+static double test_run(float rate, double rate_real, double freq, double amplitude, bool timed)
+{
+    sin_detect_config_t config = sin_detect_config_main;
+    uint32_t samples = (uint32_t)(rate_real * TEST_TIME);
+    uint32_t value = 0;
+    uint32_t sum_n = 0;
+    double sum = 0;
+    double t = 0;
+    uint32_t i = 0;
+
+    config.rate = rate;
+    if(!sin_detect_init(&test_ctx, &config))
+    {
+        test_check(false, "init", 0);
+        return 0;
+    }
+    for(i = 0; i < samples; i++)
+    {
+        t = i / rate_real;
+        value = (uint32_t)lround(TEST_OFFSET + (amplitude * sin(2.0 * M_PI * freq * t)));
+        if(timed)
+        {
+            sin_detect_process_timed(&test_ctx, value, (uint32_t)llround(t * SIN_DETECT_CLOCK));
+        }
+        else
+        {
+            sin_detect_process(&test_ctx, value);
+        }
+        if(t >= TEST_SETTLE && sin_detect_get_frequency(&test_ctx, &value))
+        {
+            sum += (double)value / SIN_DETECT_FREQ_ONE;
+            sum_n++;
+        }
+    }
+
+    return (sin_detect_get_frequency(&test_ctx, &value) && sum_n > 0) ? (sum / sum_n) : 0;
+}
+
+/**
+ * @brief   Feed channels scanned together, block by block as DMA thread of adc.c, each channel must measure its own
+ *          signal and match detector fed with that channel alone.
+ */
+static void test_channels(void)
+{
+    static const double freq[TEST_CHANNELS] = {120.0, 200.0, 280.0};
+    static const double amplitude[TEST_CHANNELS] = {800.0, 400.0, 1200.0};
+    const uint32_t blocks = (uint32_t)((SIN_DETECT_RATE * TEST_TIME) / TEST_BLOCK);
+    uint16_t scan[TEST_BLOCK * TEST_CHANNELS];
+    uint16_t samples[TEST_CHANNELS][TEST_BLOCK];
+    uint32_t value = 0;
+    uint32_t n = 0;
+    double t = 0;
+    bool ok = true;
+    char name[64];
+    uint32_t b = 0;
+    uint32_t i = 0;
+    uint32_t k = 0;
+
+    for(k = 0; k < TEST_CHANNELS; k++)
+    {
+        ok &= sin_detect_init(&test_channels_ctx[k], &sin_detect_config_main);
+    }
+    ok &= sin_detect_init(&test_alone_ctx, &sin_detect_config_main);
+    test_check(ok, "channels init", TEST_CHANNELS);
+    for(b = 0; b < blocks; b++)
+    {
+        // Sequence converts channels one after other, buffer holds them interleaved.
+        for(i = 0; i < TEST_BLOCK; i++, n++)
+        {
+            t = n / (double)SIN_DETECT_RATE;
+            for(k = 0; k < TEST_CHANNELS; k++)
+            {
+                scan[(i * TEST_CHANNELS) + k] = (uint16_t)lround(TEST_OFFSET
+                                                                 + (amplitude[k] * sin(2.0 * M_PI * freq[k] * t)));
+            }
+        }
+        for(k = 0; k < TEST_CHANNELS; k++)
+        {
+            for(i = 0; i < TEST_BLOCK; i++)
+            {
+                samples[k][i] = scan[(i * TEST_CHANNELS) + k];
+            }
+            sin_detect_process_block(&test_channels_ctx[k], samples[k], TEST_BLOCK);
+        }
+        sin_detect_process_block(&test_alone_ctx, samples[1], TEST_BLOCK);
+    }
+    for(k = 0; k < TEST_CHANNELS; k++)
+    {
+        value = 0;
+        ok = sin_detect_get_frequency(&test_channels_ctx[k], &value);
+        snprintf(name, sizeof(name), "channel %lu, %.0f Hz", (unsigned long)k, freq[k]);
+        test_check(ok && fabs(((double)value / SIN_DETECT_FREQ_ONE) - freq[k]) < 0.05, name,
+                   (double)value / SIN_DETECT_FREQ_ONE);
+    }
+    test_check(test_channels_ctx[1].data.frequncy == test_alone_ctx.data.frequncy
+               && test_channels_ctx[1].data.noise == test_alone_ctx.data.noise, "channel 1 equals alone",
+               (double)test_alone_ctx.data.frequncy / SIN_DETECT_FREQ_ONE);
+
+    return;
+}